@@ -2,6 +2,7 @@
 #include <map>
 #include <mlc/constants.h>
 #include <mlc/einsum/EinsumNode.h>
+#include <mlc/einsum/EinsumPlan.h>
 #include <mlc/einsum/EinsumTree.h>
 #include <mlc/types.h>
 #include <vector>
@@ -89,6 +90,26 @@ int main()
     // It suffices to delete the root node, as the destructor will recursively delete all child nodes
     // and all allocated intermediate tensors, as well as the output tensor.
     delete node;
+
+    // Alternatively, an EinsumPlan performs parsing, optimization and lowering in a single step.
+    // The plan does not change when executed, so it can be shared between threads.
+    // The output tensor and a scratch buffer for intermediate results are provided by the caller.
+    mini_jit::einsum::EinsumPlan plan(input,
+                                      dimension_sizes,
+                                      dtype,
+                                      256,
+                                      512,
+                                      16);
+
+    // The inputs are passed in the order in which they appear in the expression.
+    std::vector<void const*>                plan_inputs{tensor_A, tensor_B};
+    std::vector<float>                      plan_output(SIZE_OUT);
+    mini_jit::einsum::EinsumPlan::scratch_t plan_scratch(plan.get_scratch_size());
+    plan.execute(plan_inputs,
+                 plan_output.data(),
+                 plan_scratch.data());
+    std::cout << "Plan output size: " << plan.get_output_size() << " bytes" << std::endl;
+
     // Regarding the input tensors, the user is responsible for deleting them.
     delete[] tensor_A;
     delete[] tensor_B;
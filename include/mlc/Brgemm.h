@@ -79,6 +79,12 @@ public:
      * @return pointer to the generated kernel.
      **/
     kernel_t get_kernel() const;
+
+    /**
+     * @brief Get the size of the generated code.
+     * @return size of the generated code in bytes, 0 if no kernel was generated.
+     **/
+    std::size_t get_code_size() const;
 };
 
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <mlc/Peephole.h>
 #include <string>
 #include <vector>
 
@@ -14,12 +15,31 @@ namespace mini_jit
 
 class mini_jit::Kernel
 {
+public:
+    //! handle of a label, only valid for the kernel which created it
+    using label_t = uint32_t;
+
 private:
+    /// A position in the code buffer which branches can target.
+    struct label_info_t
+    {
+        /// position in the code buffer counted in instructions, -1 if not bound yet
+        int64_t position = -1;
+        /// positions of the branches which were added before the label was bound
+        std::vector<std::size_t> fixups;
+    };
+
     //! high-level code buffer
     std::vector<uint32_t> m_buffer;
 
-    //! high-level label buffer
-    std::map<std::string, int> m_labels;
+    //! labels indexed by their handle
+    std::vector<label_info_t> m_labels;
+
+    //! handles of the named labels
+    std::map<std::string, label_t> m_label_names;
+
+    //! number of branches which target labels that are not bound yet
+    std::size_t m_num_unresolved = 0;
 
     //! size of the kernel
     std::size_t m_size_alloc = 0;
@@ -27,6 +47,15 @@ private:
     //! executable kernel
     void* m_kernel = nullptr;
 
+    //! name of the kernel in profiles
+    std::string m_name = "mini_jit_kernel";
+
+    //! run the peephole optimizer in set_kernel
+    bool m_optimize = Peephole::enabled_by_default();
+
+    //! statistics of the last peephole optimization
+    Peephole::stats_t m_peephole_stats;
+
     /**
      * Allocates memory through POSIX mmap.
      *
@@ -57,6 +86,20 @@ private:
      **/
     void release_memory();
 
+    /**
+     * Writes the offset of a branch to its target into the immediate of the branch.
+     *
+     * @param position position of the branch in the code buffer.
+     * @param target position of the target in the code buffer.
+     **/
+    void patch_branch(std::size_t position,
+                      std::size_t target);
+
+    /**
+     * Runs the peephole optimizer over the code buffer and moves the labels along.
+     **/
+    void optimize();
+
     /**
      * Creates a directory if it does not exist.
      *
@@ -92,17 +135,54 @@ public:
      *
      * @param ins instructions which are added.
      **/
-    void add_instr(std::vector<uint32_t> ins);
+    void add_instr(std::vector<uint32_t> const& ins);
+
+    /**
+     * Creates a label which is not bound to a position yet, e.g. the target of a forward branch.
+     *
+     * @return handle of the label.
+     **/
+    label_t new_label();
+
+    /**
+     * Binds a label to the end of the code buffer.
+     * Branches which were added before and target the label are patched.
+     *
+     * @param label label which is bound.
+     * @throws std::invalid_argument if the label is unknown or already bound.
+     **/
+    void bind(label_t label);
 
     /**
-     * Adds a label to the code buffer.
+     * Creates a label at the end of the code buffer, e.g. the start of a loop.
+     *
+     * @return handle of the label.
+     **/
+    label_t add_label();
+
+    /**
+     * Adds a branch to a label to the code buffer.
+     * The immediate of the instruction is replaced by the offset to the label, which is
+     * patched once the label is bound if it is not bound yet.
+     * Supported are B, BL, B.cond, CBZ, CBNZ, TBZ and TBNZ.
+     *
+     * @param ins branch instruction, e.g. cbnz(x9, 0).
+     * @param label target of the branch.
+     * @throws std::invalid_argument if the label is unknown, the instruction is no supported branch or the label is out of range.
+     **/
+    void add_branch(uint32_t ins,
+                    label_t  label);
+
+    /**
+     * Adds a named label to the code buffer.
+     * Prefer the handles of add_label(), which avoid the lookup of the name.
      *
      * @param label label which is added.
      **/
     void add_label(std::string const& label);
 
     /**
-     * Returns how many instructions come after the given label.
+     * Returns how many instructions come after the given named label.
      *
      * @param label label to search for.
      * @return number of instructions after the label.
@@ -116,8 +196,38 @@ public:
      **/
     std::size_t get_size() const;
 
+    /**
+     * Sets the name under which the kernel appears in profiles, e.g. brgemm_m64_n48_k64_br16.
+     * Has to be called before set_kernel.
+     *
+     * @param name name of the kernel.
+     **/
+    void set_name(std::string const& name);
+
+    /**
+     * Gets the name of the kernel.
+     **/
+    std::string const& get_name() const;
+
+    /**
+     * Enables or disables the peephole optimization of the code buffer in set_kernel, see Peephole.
+     * Enabled by default, unless the environment variable MLC_PEEPHOLE is set to 0.
+     *
+     * @param optimize true if the code is optimized.
+     **/
+    void set_optimize(bool optimize);
+
+    /**
+     * Gets the statistics of the peephole optimization in the last call of set_kernel.
+     **/
+    Peephole::stats_t const& get_peephole_stats() const;
+
     /**
      * Sets the kernel based on the code buffer.
+     * The code buffer is optimized first if enabled, see set_optimize.
+     * The kernel is published to profilers if enabled, see PerfMap.
+     *
+     * @throws std::runtime_error if a branch targets a label which is not bound.
      **/
     void set_kernel();
 
@@ -0,0 +1,151 @@
+#ifndef MINI_JIT_PEEPHOLE_H
+#define MINI_JIT_PEEPHOLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mini_jit
+{
+    class Peephole;
+}
+
+/**
+ * Peephole optimizer over the instruction stream of a generated kernel.
+ *
+ * The generators emit a fixed prologue and epilogue and copy their arguments into working registers,
+ * independent of the registers which are actually used. After the generation, the pass
+ *  - removes moves of a register to itself and moves to registers which are never read,
+ *  - propagates copies of registers which are never modified, e.g. mov x20, x1 of a base pointer,
+ *  - removes the save and restore of callee-saved registers (x19-x28, d8-d15) which are never written,
+ *  - hoists loads above independent arithmetic instructions of the same basic block.
+ * Branch offsets are updated afterwards.
+ *
+ * The pass only works on instructions it can decode, i.e. the instructions of the encoders in
+ * mlc/instructions. If a kernel contains any other instruction, the kernel is left unchanged.
+ *
+ * Kernel::set_kernel runs the pass unless it is disabled by Kernel::set_optimize or the
+ * environment variable MLC_PEEPHOLE=0.
+ */
+class mini_jit::Peephole
+{
+public:
+    //! class of a register operand
+    enum class reg_class_t : uint8_t
+    {
+        gpr  = 0,
+        simd = 1
+    };
+
+    //! kind of a decoded instruction
+    enum class instr_kind_t : uint8_t
+    {
+        unknown = 0,
+        alu     = 1,
+        load    = 2,
+        store   = 3,
+        branch  = 4,
+        ret     = 5
+    };
+
+    //! register operand of an instruction
+    struct operand_t
+    {
+        //! position of the 5-bit register field in the instruction
+        uint8_t     shift     = 0;
+        reg_class_t reg_class = reg_class_t::gpr;
+        bool        read      = false;
+        bool        write     = false;
+    };
+
+    /**
+     * Decoded instruction.
+     * General purpose registers are numbered 0-30 and 31 is SP, the zero register is no operand.
+     * SIMD&FP registers are numbered 32-63, see reg_id.
+     */
+    struct instr_t
+    {
+        uint32_t     ins          = 0;
+        instr_kind_t kind         = instr_kind_t::unknown;
+        uint8_t      num_operands = 0;
+        operand_t    operands[4];
+
+        //! id of the register of the given operand
+        uint32_t get_reg(std::size_t operand) const;
+        //! mask of the registers which are read, bit i corresponds to register id i
+        uint64_t reads() const;
+        //! mask of the registers which are written, bit i corresponds to register id i
+        uint64_t writes() const;
+    };
+
+    //! statistics of an optimization
+    struct stats_t
+    {
+        //! removed moves, including propagated copies
+        std::size_t removed_moves = 0;
+        //! removed save and restore instructions of callee-saved registers
+        std::size_t removed_spills = 0;
+        //! loads which were moved to an earlier position
+        std::size_t hoisted_loads = 0;
+        //! false if the code was left unchanged, since it contains an unknown instruction or a branch out of the code
+        bool analyzed = true;
+    };
+
+    /**
+     * Id of a register in the masks of instr_t.
+     *
+     * @param reg_class class of the register.
+     * @param reg number of the register in the instruction.
+     **/
+    static uint32_t reg_id(reg_class_t reg_class,
+                           uint32_t    reg);
+
+    /**
+     * Decodes an instruction.
+     *
+     * @param ins instruction.
+     * @return decoded instruction, kind unknown if not supported.
+     **/
+    static instr_t decode(uint32_t ins);
+
+    /**
+     * Gets the offset of a branch.
+     *
+     * @param ins instruction.
+     * @param offset set to the offset to the target counted in instructions.
+     * @return true if the instruction is a B, BL, B.cond, CBZ, CBNZ, TBZ or TBNZ.
+     **/
+    static bool get_branch_offset(uint32_t ins,
+                                  int64_t& offset);
+
+    /**
+     * Sets the offset of a branch.
+     *
+     * @param ins branch instruction.
+     * @param offset offset to the target counted in instructions.
+     * @return instruction with the new offset.
+     * @throws std::invalid_argument if the instruction is no supported branch or the offset is out of range.
+     **/
+    static uint32_t set_branch_offset(uint32_t ins,
+                                      int64_t  offset);
+
+    /**
+     * Optimizes the code of a kernel in place.
+     * Branches may target any position inside the code or its end.
+     *
+     * @param code instructions of the kernel.
+     * @param positions if not null, set to the new position of every old position including the end of the code.
+     * @return statistics of the optimization.
+     **/
+    static stats_t optimize(std::vector<uint32_t>&    code,
+                            std::vector<std::size_t>* positions = nullptr);
+
+    /**
+     * Whether kernels are optimized by default.
+     *
+     * @return false if the environment variable MLC_PEEPHOLE is set to 0.
+     **/
+    static bool enabled_by_default();
+};
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef MINI_JIT_PERF_COUNTERS_H
+#define MINI_JIT_PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mini_jit
+{
+    class PerfCounters;
+}
+
+/**
+ * Hardware performance counters based on Linux perf_event_open.
+ *
+ * The counters are opened by every thread of the OpenMP team of the calling thread, so that
+ * the counts include the shared loops of parallel code. This relies on the OpenMP runtime
+ * reusing the threads of the team for later parallel regions of the same or a smaller size.
+ * Threads which are created by the calling thread afterwards inherit its counters.
+ * Events which cannot be opened, e.g. without permission (perf_event_paranoid) or on
+ * other operating systems, are not counted and all other calls silently do nothing.
+ */
+class mini_jit::PerfCounters
+{
+public:
+    /// counted hardware events
+    enum class event_t : uint32_t
+    {
+        cycles        = 0,
+        instructions  = 1,
+        l1d_misses    = 2,
+        llc_misses    = 3,
+        branch_misses = 4
+    };
+
+    /// number of counted hardware events
+    static constexpr std::size_t NUM_EVENTS = 5;
+
+    /// Counts of a measurement, extrapolated if the kernel multiplexed the counters.
+    struct values_t
+    {
+        /// counts indexed by event
+        std::array<double, NUM_EVENTS> counts = {};
+        /// whether the event was counted
+        std::array<bool, NUM_EVENTS> counted = {};
+        /// whether the measured code also ran on threads without counters, e.g. a larger OpenMP
+        /// team than the counters were opened for, i.e. the counts do not cover the whole execution
+        bool incomplete = false;
+
+        /**
+         * Get the count of an event.
+         *
+         * @param event The event.
+         * @return The count, 0 if the event was not counted.
+         **/
+        double get(event_t event) const
+        {
+            return counts[static_cast<std::size_t>(event)];
+        }
+
+        /**
+         * Get whether an event was counted.
+         *
+         * @param event The event.
+         * @return True if the event was counted.
+         **/
+        bool has(event_t event) const
+        {
+            return counted[static_cast<std::size_t>(event)];
+        }
+
+        /**
+         * Get the instructions per cycle.
+         *
+         * @return The IPC, 0 if cycles or instructions were not counted.
+         **/
+        double ipc() const
+        {
+            return has(event_t::cycles) && get(event_t::cycles) > 0.0 ? get(event_t::instructions) / get(event_t::cycles) : 0.0;
+        }
+
+        /**
+         * Divide all counts, e.g. by the number of kernel invocations.
+         *
+         * @param divisor The divisor.
+         * @return The counts per divisor.
+         **/
+        values_t per(double divisor) const;
+    };
+
+private:
+    /// file descriptors of the events per thread of the team, the calling thread first, -1 if the event is not counted
+    std::vector<std::array<int, NUM_EVENTS>> m_fds;
+    /// number of threads which count all events counted by the calling thread
+    int64_t m_num_threads = 0;
+
+public:
+    /**
+     * Open the counters of all events on every thread of the OpenMP team, the counters are stopped.
+     **/
+    PerfCounters();
+
+    /**
+     * Close the counters.
+     **/
+    ~PerfCounters();
+
+    PerfCounters(PerfCounters const&)            = delete;
+    PerfCounters& operator=(PerfCounters const&) = delete;
+
+    /**
+     * Get whether at least one event is counted.
+     *
+     * @return True if counters are available.
+     **/
+    bool available() const;
+
+    /**
+     * Get the number of threads of the OpenMP team whose events are counted.
+     * Parallel code running on more threads is only partially counted.
+     *
+     * @return The number of threads, 0 if counters are not available.
+     **/
+    int64_t num_threads() const
+    {
+        return m_num_threads;
+    }
+
+    /**
+     * Reset and start all counters.
+     **/
+    void start();
+
+    /**
+     * Stop all counters.
+     **/
+    void stop();
+
+    /**
+     * Read the counters since the last start.
+     *
+     * @return The counts of all events summed over all threads.
+     **/
+    values_t read() const;
+
+    /**
+     * Get the name of an event as used in reports, e.g. "l1d_misses".
+     *
+     * @param event The event.
+     * @return The name.
+     **/
+    static char const* name(event_t event);
+};
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef MINI_JIT_PERF_MAP_H
+#define MINI_JIT_PERF_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace mini_jit
+{
+    class PerfMap;
+}
+
+/**
+ * Publishes the names and addresses of JIT-ed kernels to profilers.
+ *
+ * Two formats are supported, both are disabled by default:
+ *  - perf map: one line "<start> <size> <name>" per kernel in /tmp/perf-<pid>.map,
+ *    which perf report reads directly. Enabled by the environment variable MLC_PERF_MAP=1.
+ *  - jitdump: code load records including the machine code in <dir>/jit-<pid>.dump,
+ *    which perf inject --jit merges into a recording made with perf record -k mono.
+ *    Enabled by MLC_JITDUMP=1, the directory is MLC_JITDUMP_DIR or the working directory.
+ *
+ * Kernels are registered by Kernel::set_kernel. All functions are thread-safe.
+ */
+class mini_jit::PerfMap
+{
+private:
+    //! serializes the registration of kernels from multiple threads
+    std::mutex m_mutex;
+
+    //! perf map file, closed if disabled
+    std::ofstream m_map;
+    //! path of the perf map file
+    std::string m_map_path;
+
+    //! file descriptor of the jitdump file, -1 if disabled
+    int m_jitdump_fd = -1;
+    //! executable mapping of the jitdump file which announces it to perf record
+    void* m_jitdump_marker = nullptr;
+    //! path of the jitdump file
+    std::string m_jitdump_path;
+    //! index of the next code load record
+    uint64_t m_code_index = 0;
+
+    /**
+     * Reads the environment variables.
+     **/
+    PerfMap();
+
+    /**
+     * Close the jitdump file if open.
+     **/
+    void close_jitdump();
+
+public:
+    /**
+     * Closes all files.
+     **/
+    ~PerfMap();
+
+    PerfMap(PerfMap const&)            = delete;
+    PerfMap& operator=(PerfMap const&) = delete;
+
+    /**
+     * Get the map of the process.
+     *
+     * @return The map, configured by the environment on first use.
+     **/
+    static PerfMap& instance();
+
+    /**
+     * Write a perf map, kernels registered before are not written.
+     *
+     * @param path Path of the map, defaults to /tmp/perf-<pid>.map.
+     * @throws std::runtime_error if the file cannot be opened.
+     **/
+    void enable_perf_map(std::string const& path = "");
+
+    /**
+     * Write a jitdump, kernels registered before are not written.
+     *
+     * @param dir Directory of the jitdump file jit-<pid>.dump.
+     * @throws std::runtime_error if the file cannot be created or jitdump is not supported on the platform.
+     **/
+    void enable_jitdump(std::string const& dir = ".");
+
+    /**
+     * Stop writing both formats and close the files.
+     **/
+    void disable();
+
+    /**
+     * Get whether kernels are published in at least one format.
+     **/
+    bool enabled();
+
+    /**
+     * Get the path of the perf map, empty if disabled.
+     **/
+    std::string get_perf_map_path();
+
+    /**
+     * Get the path of the jitdump, empty if disabled.
+     **/
+    std::string get_jitdump_path();
+
+    /**
+     * Publish a kernel.
+     *
+     * @param code Address of the executable code.
+     * @param size Size of the code in bytes.
+     * @param name Name of the kernel, e.g. brgemm_m64_n48_k64_br16.
+     **/
+    void add(void const*        code,
+             std::size_t        size,
+             std::string const& name);
+};
+
+#endif
@@ -1,10 +1,14 @@
 #ifndef MINI_JIT_TENSOR_OPERATION_H
 #define MINI_JIT_TENSOR_OPERATION_H
 
+#include <array>
 #include <cstdint>
 #include <mlc/Binary.h>
 #include <mlc/Brgemm.h>
 #include <mlc/Unary.h>
+#include <memory>
+#include <mlc/PerfCounters.h>
+#include <mlc/ir/OptimizationReport.h>
 #include <mlc/types.h>
 #include <span>
 #include <vector>
@@ -16,6 +20,32 @@ namespace mini_jit
 
 class mini_jit::TensorOperation
 {
+public:
+    /// Time spent in the phases of the last setup and the generated code.
+    struct setup_timings_t
+    {
+        /// checks of the arguments, loop analysis and stride adjustment in nanoseconds
+        int64_t analysis_ns = 0;
+        /// generation of the first touch, main and last touch kernels in nanoseconds
+        int64_t kernels_ns = 0;
+        /// generation of the packing kernels in nanoseconds
+        int64_t packing_ns = 0;
+        /// setup of the remainder operations in nanoseconds
+        int64_t remainders_ns = 0;
+        /// number of generated kernels including those of the remainder operations
+        int64_t num_kernels = 0;
+
+        /**
+         * Get the time of the whole setup.
+         *
+         * @return The time in nanoseconds.
+         **/
+        int64_t total_ns() const
+        {
+            return analysis_ns + kernels_ns + packing_ns + remainders_ns;
+        }
+    };
+
 private:
     /// used dtype
     mini_jit::dtype_t m_dtype;
@@ -30,6 +60,10 @@ private:
     mini_jit::Binary m_binary_main;
     /// Unary object for last touch kernel
     mini_jit::Unary m_unary_last_touch;
+    /// Unary object for packing blocks of the first input
+    mini_jit::Unary m_unary_pack_in0;
+    /// Unary object for packing blocks of the second input
+    mini_jit::Unary m_unary_pack_in1;
 
     /// first touch kernel type
     mini_jit::ptype_t m_kernel_first_touch_type;
@@ -112,6 +146,13 @@ private:
     /// shared N dimension id
     int64_t m_dim_id_sha_N;
 
+    /// id of the loop whose last iteration uses the remainder of the primary M dimension
+    int64_t m_dim_id_rem_M = -1;
+    /// id of the loop whose last iteration uses the remainder of the primary N dimension
+    int64_t m_dim_id_rem_N = -1;
+    /// operations on the remainder blocks, indexed by the kernel variant (1: M, 2: N, 3: M and N)
+    std::array<std::unique_ptr<TensorOperation>, 4> m_remainder_ops;
+
     /// shared loop ids
     std::vector<int64_t> m_shared_loop_ids;
     /// shared loop sizes
@@ -134,9 +175,54 @@ private:
     /// br size B adjusted to the input dimensions
     int64_t m_adjusted_br_size_B = 0;
 
+    /// Whether packing of the inputs was requested
+    bool m_packing = false;
+    /// Whether blocks of the first input are packed before calling the main kernel
+    bool m_pack_in0 = false;
+    /// Whether blocks of the second input are packed before calling the main kernel
+    bool m_pack_in1 = false;
+    /// kernel packing a block of the first input
+    void (*m_kernel_pack_in0)(void const*,
+                              void*,
+                              int64_t,
+                              int64_t,
+                              void*) = nullptr;
+    /// kernel packing a block of the second input
+    void (*m_kernel_pack_in1)(void const*,
+                              void*,
+                              int64_t,
+                              int64_t,
+                              void*) = nullptr;
+
     /// Whether the operation has been setup
     bool m_has_been_setup = false;
 
+    /// report of the optimizer which produced the configuration of the operation
+    ir::OptimizationReport m_report;
+
+    /// phases of the last setup
+    setup_timings_t m_setup_timings;
+
+    /**
+     * Copy the blocks of the inputs used by the next main kernel call into the
+     * contiguous buffers of the calling thread. A block is only copied if it differs
+     * from the block packed by the previous call, so that a panel is reused while
+     * inner loops iterate over the other input.
+     *
+     * @param ptr_in0   Pointer to the block of the first input, replaced by the packed block.
+     * @param ptr_in1   Pointer to the block of the second input, replaced by the packed block.
+     * @param ldA       Leading dimension of the first input, replaced by the packed one.
+     * @param ldB       Leading dimension of the second input, replaced by the packed one.
+     * @param br_size_A Batch-reduce stride of the first input, replaced by the packed one.
+     * @param br_size_B Batch-reduce stride of the second input, replaced by the packed one.
+     */
+    void pack_inputs(char const*& ptr_in0,
+                     char const*& ptr_in1,
+                     int64_t&     ldA,
+                     int64_t&     ldB,
+                     int64_t&     br_size_A,
+                     int64_t&     br_size_B) const;
+
     /**
      * Executes the first touch kernel.
      *
@@ -144,7 +230,7 @@ private:
      * @param ldOut   Leading dimension of the output tensor.
      */
     void execute_kernel_first_touch(char*   ptr_out,
-                                    int64_t ldOut);
+                                    int64_t ldOut) const;
 
     /**
      * Executes the main kernel.
@@ -165,7 +251,7 @@ private:
                              int64_t     ldB,
                              int64_t     ldC,
                              int64_t     br_size_A,
-                             int64_t     br_size_B);
+                             int64_t     br_size_B) const;
 
     /**
      * Executes the last touch kernel.
@@ -174,7 +260,7 @@ private:
      * @param ldOut   Leading dimension of the output tensor.
      */
     void execute_kernel_last_touch(char*   ptr_out,
-                                   int64_t ldOut);
+                                   int64_t ldOut) const;
 
 public:
     /**
@@ -190,6 +276,9 @@ public:
      * @param strides_in0       Strides of the first input tensor.
      * @param strides_in1       Strides of the second input tensor (ignored if unary).
      * @param strides_out       Strides of the output tensor.
+     * @param dim_remainders    Remainders of peeled M and N loops (optional). The last iteration of a loop
+     *                          with a nonzero remainder only covers that many elements of the primary
+     *                          dimension of the same type, which is handled by separately JIT-ed kernels.
      * @return error_t::success on success, another error_t value otherwise.
      **/
     error_t
@@ -202,10 +291,46 @@ public:
           std::span<const int64_t> dim_sizes,
           std::span<const int64_t> strides_in0,
           std::span<const int64_t> strides_in1,
-          std::span<const int64_t> strides_out);
+          std::span<const int64_t> strides_out,
+          std::span<const int64_t> dim_remainders = {});
+
+    /**
+     * Enable or disable packing of the GEMM and BRGEMM inputs. Takes effect on the next call of setup.
+     * If enabled, blocks of the inputs with large leading dimensions are copied into contiguous
+     * per-thread buffers by JIT-ed identity kernels before the main kernel reads them.
+     * Inputs which are already contiguous are not packed.
+     *
+     * @param packing True to enable packing.
+     **/
+    void set_packing(bool packing)
+    {
+        m_packing = packing;
+    }
+
+    /**
+     * Get whether at least one input is packed during execution.
+     *
+     * @return True if an input is packed.
+     **/
+    bool uses_packing() const
+    {
+        return m_pack_in0 || m_pack_in1;
+    }
+
+    /**
+     * Get whether execute runs shared loops on an OpenMP team.
+     *
+     * @return True if the operation has shared loops.
+     **/
+    bool is_parallel() const
+    {
+        return m_num_parallel_loops > 0;
+    }
 
     /**
      * Execute the tensor operation.
+     * The operation is not modified, so a set up operation may be executed
+     * concurrently from multiple threads on distinct output tensors.
      *
      * @param tensor_in0 First input tensor.
      * @param tensor_in1 Second input tensor (use nullptr if unary).
@@ -213,7 +338,36 @@ public:
      **/
     void execute(void const* tensor_in0,
                  void const* tensor_in1,
-                 void*       tensor_out);
+                 void*       tensor_out) const;
+
+    /**
+     * Execute the tensor operation on the calling thread only.
+     * Shared loops are executed like sequential loops, which is useful if the
+     * caller already parallelizes over independent operations.
+     *
+     * @param tensor_in0 First input tensor.
+     * @param tensor_in1 Second input tensor (use nullptr if unary).
+     * @param tensor_out Output tensor.
+     **/
+    void execute_sequential(void const* tensor_in0,
+                            void const* tensor_in1,
+                            void*       tensor_out) const;
+
+    /**
+     * Execute the tensor operation and count the hardware events of the execution.
+     * The counts include all threads of the shared loops which have counters, if the shared loops
+     * run on more threads, the result is marked as incomplete, see PerfCounters::values_t::incomplete.
+     *
+     * @param tensor_in0 First input tensor.
+     * @param tensor_in1 Second input tensor (use nullptr if unary).
+     * @param tensor_out Output tensor.
+     * @param counters   Counters which are started before and stopped after the execution.
+     * @return The counts of the execution, empty if the counters are not available.
+     **/
+    PerfCounters::values_t execute_profiled(void const*   tensor_in0,
+                                            void const*   tensor_in1,
+                                            void*         tensor_out,
+                                            PerfCounters& counters) const;
 
     /**
      * General-purpose loop implementation featuring first and last touch operations.
@@ -225,13 +379,15 @@ public:
      * @param ptr_out      Pointer to the output tensor's data.
      * @param first_access True if first time accessing data of output tensor.
      * @param last_access  True if last time accessing data of output tensor.
+     * @param variant      Kernel variant of the enclosing loops (1: M remainder, 2: N remainder).
      **/
     void execute_iter(int64_t     id_loop,
                       char const* ptr_in0,
                       char const* ptr_in1,
                       char*       ptr_out,
                       bool        first_access,
-                      bool        last_access);
+                      bool        last_access,
+                      int64_t     variant = 0) const;
 
     /**
      * General-purpose loop implementation featuring first and last touch operations with parallelization.
@@ -246,7 +402,54 @@ public:
                                char const* ptr_in1,
                                char*       ptr_out,
                                bool        first_access,
-                               bool        last_access);
+                               bool        last_access) const;
+
+    /**
+     * Get whether the operation has remainder kernels for peeled loops.
+     *
+     * @return True if at least one loop has a remainder.
+     **/
+    bool uses_remainders() const
+    {
+        return m_dim_id_rem_M != -1 || m_dim_id_rem_N != -1;
+    }
+
+    /**
+     * Get the size of all JIT-ed kernels of the operation.
+     *
+     * @return size of the generated code in bytes.
+     **/
+    std::size_t get_code_size() const;
+
+    /**
+     * Get the time spent in the phases of the last setup, e.g. to track the JIT latency.
+     *
+     * @return The timings, incomplete if the setup failed.
+     **/
+    setup_timings_t const& get_setup_timings() const
+    {
+        return m_setup_timings;
+    }
+
+    /**
+     * Attach the report of the optimizer which produced the configuration of the operation.
+     *
+     * @param report The optimization report.
+     **/
+    void set_report(ir::OptimizationReport const& report)
+    {
+        m_report = report;
+    }
+
+    /**
+     * Get the attached optimization report.
+     *
+     * @return The report, which is empty if none was attached.
+     **/
+    ir::OptimizationReport const& get_report() const
+    {
+        return m_report;
+    }
 
     int dtype_size() const
     {
@@ -0,0 +1,226 @@
+#ifndef MINI_JIT_TRACER_H
+#define MINI_JIT_TRACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mini_jit
+{
+    class Tracer;
+}
+
+/**
+ * Records the duration of code regions, e.g. the nodes of an einsum tree, and writes them
+ * as Chrome trace events, which can be viewed in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Tracing is disabled by default. It is enabled at runtime by Tracer::enable or by the
+ * environment variable MLC_TRACE=<file>, in which case the trace is written to the file
+ * when the process exits. Compiling with -DMLC_DISABLE_TRACING removes all trace scopes.
+ *
+ * Every thread records into its own preallocated buffer, so recording takes no locks.
+ * Spans which do not fit into the buffer of a thread are dropped and counted.
+ */
+class mini_jit::Tracer
+{
+public:
+    /// maximum length of a span name including the terminating zero, longer names are truncated
+    static constexpr std::size_t MAX_NAME_LENGTH = 64;
+    /// default number of spans a single thread can record
+    static constexpr std::size_t DEFAULT_CAPACITY = 1 << 16;
+
+    /// A recorded span.
+    struct span_t
+    {
+        /// name, e.g. the tensor expression of an einsum node
+        char name[MAX_NAME_LENGTH];
+        /// category, e.g. "einsum", must be a string literal
+        char const* category;
+        /// start in nanoseconds, see now_ns
+        int64_t start_ns;
+        /// duration in nanoseconds
+        int64_t duration_ns;
+    };
+
+    /**
+     * Records a span from its construction to its destruction if tracing is enabled.
+     * Use the macro MLC_TRACE_SCOPE instead to allow disabling tracing at compile time.
+     */
+    class Scope
+    {
+    private:
+        //! category of the span, nullptr if tracing was disabled on construction
+        char const* m_category = nullptr;
+        //! name of the span, copied on construction so temporaries can be passed
+        char m_name[MAX_NAME_LENGTH];
+        //! start of the span
+        int64_t m_start_ns = 0;
+
+    public:
+        /**
+         * Start a span.
+         *
+         * @param category Category of the span, must be a string literal.
+         * @param name Name of the span, copied and truncated to MAX_NAME_LENGTH - 1 characters.
+         **/
+        Scope(char const* category,
+              char const* name);
+
+        /**
+         * Start a span.
+         *
+         * @param category Category of the span, must be a string literal.
+         * @param name Name of the span, copied and truncated to MAX_NAME_LENGTH - 1 characters.
+         **/
+        Scope(char const*        category,
+              std::string const& name)
+            : Scope(category, name.c_str())
+        {
+        }
+
+        /**
+         * End the span and record it.
+         **/
+        ~Scope();
+
+        Scope(Scope const&)            = delete;
+        Scope& operator=(Scope const&) = delete;
+    };
+
+private:
+    /// Spans of a single thread, only written by this thread.
+    struct thread_buffer_t
+    {
+        /// id of the thread in the trace
+        int64_t tid;
+        /// preallocated spans
+        std::vector<span_t> spans;
+        /// number of recorded spans, published after the span was written
+        std::atomic<std::size_t> size = 0;
+        /// number of dropped spans
+        std::atomic<std::size_t> dropped = 0;
+    };
+
+    //! whether spans are recorded
+    std::atomic<bool> m_enabled = false;
+    //! number of spans per thread buffer
+    std::atomic<std::size_t> m_capacity = DEFAULT_CAPACITY;
+
+    //! serializes the creation of thread buffers and writing the trace
+    std::mutex m_mutex;
+    //! buffers of all threads which recorded spans, kept until the process exits
+    std::vector<std::unique_ptr<thread_buffer_t>> m_buffers;
+    //! file the trace is written to on destruction, set by MLC_TRACE
+    std::string m_exit_path;
+
+    /**
+     * Reads the environment variable MLC_TRACE.
+     **/
+    Tracer();
+
+    /**
+     * Get the buffer of the calling thread, created on first use.
+     **/
+    thread_buffer_t& thread_buffer();
+
+public:
+    /**
+     * Writes the trace if requested by MLC_TRACE.
+     **/
+    ~Tracer();
+
+    Tracer(Tracer const&)            = delete;
+    Tracer& operator=(Tracer const&) = delete;
+
+    /**
+     * Get the tracer of the process.
+     *
+     * @return The tracer, configured by the environment on first use.
+     **/
+    static Tracer& instance();
+
+    /**
+     * Get the time of a monotonic clock relative to its first use.
+     *
+     * @return The time in nanoseconds.
+     **/
+    static int64_t now_ns();
+
+    /**
+     * Start recording spans.
+     *
+     * @param capacity Number of spans each thread can record, applies to threads which record their first span afterwards.
+     * @throws std::invalid_argument if capacity is zero.
+     **/
+    void enable(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Stop recording spans, recorded spans are kept.
+     **/
+    void disable();
+
+    /**
+     * Get whether spans are recorded.
+     **/
+    bool enabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Discard all recorded spans. Must not be called while other threads record spans.
+     **/
+    void clear();
+
+    /**
+     * Record a span of the calling thread.
+     *
+     * @param category Category of the span, must be a string literal.
+     * @param name Name of the span, truncated to MAX_NAME_LENGTH - 1 characters.
+     * @param start_ns Start of the span, see now_ns.
+     * @param duration_ns Duration of the span in nanoseconds.
+     **/
+    void record(char const* category,
+                char const* name,
+                int64_t     start_ns,
+                int64_t     duration_ns);
+
+    /**
+     * Get the spans recorded by all threads, ordered by thread.
+     *
+     * @return Pairs of the thread id and the span.
+     **/
+    std::vector<std::pair<int64_t, span_t>> get_spans();
+
+    /**
+     * Get the number of spans which did not fit into the thread buffers.
+     **/
+    std::size_t get_dropped();
+
+    /**
+     * Write the recorded spans in the Chrome trace event format.
+     *
+     * @param path Path of the JSON file.
+     * @throws std::runtime_error if the file cannot be written.
+     **/
+    void write_chrome_trace(std::string const& path);
+};
+
+#ifdef MLC_DISABLE_TRACING
+#define MLC_TRACE_SCOPE(category, name) ((void)0)
+#else
+#define MLC_TRACE_CONCAT_IMPL(a, b) a##b
+#define MLC_TRACE_CONCAT(a, b)      MLC_TRACE_CONCAT_IMPL(a, b)
+/**
+ * Record a span from this line to the end of the enclosing scope.
+ */
+#define MLC_TRACE_SCOPE(category, name) \
+    mini_jit::Tracer::Scope MLC_TRACE_CONCAT(l_trace_scope_, __LINE__)(category, name)
+#endif
+
+#endif
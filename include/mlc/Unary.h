@@ -69,6 +69,12 @@ public:
      **/
     kernel_t get_kernel() const;
 
+    /**
+     * @brief Get the size of the generated code.
+     * @return size of the generated code in bytes, 0 if no kernel was generated.
+     **/
+    std::size_t get_code_size() const;
+
     /**
      * @brief Set extra/context pointer for kernels that need it (e.g., lookup table).
      */
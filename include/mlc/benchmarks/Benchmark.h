@@ -1,6 +1,12 @@
 #ifndef MINI_JIT_BENCHMARK_H
 #define MINI_JIT_BENCHMARK_H
 
+#include <chrono>
+#include <mlc/PerfCounters.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
 namespace mini_jit
 {
     class Benchmark;
@@ -9,15 +15,80 @@ namespace mini_jit
 class mini_jit::Benchmark
 {
 public:
+    //! Minimum duration of a timed batch of repetitions in seconds, amortizes the overhead of the timer.
+    static constexpr double MIN_SAMPLE_TIME = 1e-3;
+    //! Minimum number of timed batches of a measurement.
+    static constexpr long MIN_SAMPLES = 5;
+    //! Fraction of the run time spent on warmup repetitions.
+    static constexpr double WARMUP_FRACTION = 0.1;
+
+    /*
+     * This structure holds the statistics of a measurement.
+     * All times are seconds per repetition, computed from batches of repetitions.
+     * @param numSamples Number of timed batches.
+     * @param repsPerSample Number of repetitions per batch.
+     * @param warmupReps Number of untimed warmup repetitions.
+     * @param mean Mean time.
+     * @param median Median time.
+     * @param p5 5th percentile of the time.
+     * @param p95 95th percentile of the time.
+     * @param stddev Standard deviation of the time.
+     * @param min Minimum time.
+     * @param max Maximum time.
+     * @param numThreads Maximum number of OpenMP threads during the measurement.
+     * @param cpuFrequencyMHz Current frequency of the first CPU in MHz (0 if unknown).
+     * @param counters Hardware events per repetition, only counted if perf counters are set.
+     */
+    struct benchmark_statistics
+    {
+        long numSamples    = 0;
+        long repsPerSample = 0;
+        long warmupReps    = 0;
+
+        double mean   = 0.0;
+        double median = 0.0;
+        double p5     = 0.0;
+        double p95    = 0.0;
+        double stddev = 0.0;
+        double min    = 0.0;
+        double max    = 0.0;
+
+        int    numThreads      = 0;
+        double cpuFrequencyMHz = 0.0;
+
+        PerfCounters::values_t counters;
+    };
+
+    /*
+     * This structure relates a result to the limits of the machine.
+     * @param arithmeticIntensity Floating point operations per byte of processed data.
+     * @param peakGflops Measured peak floating point throughput in GFLOPS (0 if unknown).
+     * @param peakGibps Measured peak memory bandwidth in GiB/s (0 if unknown).
+     * @param attainableGflops Roofline limit at the arithmetic intensity in GFLOPS.
+     * @param fractionOfPeak Achieved fraction of the bandwidth peak if memory bound, of the compute peak otherwise.
+     * @param memoryBound Whether the bandwidth limits the performance at the arithmetic intensity.
+     */
+    struct benchmark_roofline
+    {
+        double arithmeticIntensity = 0.0;
+        double peakGflops          = 0.0;
+        double peakGibps           = 0.0;
+        double attainableGflops    = 0.0;
+        double fractionOfPeak      = 0.0;
+        bool   memoryBound         = false;
+    };
+
     /*
      * This structure holds the result of a benchmark run.
      * @param numReps Number of repetitions of the benchmark.
      * @param elapsedSeconds Elapsed time in seconds.
      * @param totalNumberElements Total number of elements processed.
      * @param totalOperations Total number of operations performed.
-     * @param gflops Giga FP operations per second.
+     * @param gflops Giga FP operations per second, based on the median time.
      * @param totalDataProcessed Total data processed in GiB.
-     * @param gibps Bandwidth in GiB/s.
+     * @param gibps Bandwidth in GiB/s, based on the median time.
+     * @param statistics Statistics of the time per repetition.
+     * @param roofline Relation of the result to the peaks of the machine.
      */
     struct benchmark_result
     {
@@ -31,6 +102,9 @@ public:
 
         double totalDataProcessed = 0.0f;
         double gibps              = 0.0f;
+
+        benchmark_statistics statistics;
+        benchmark_roofline   roofline;
     };
 
     virtual ~Benchmark() {}
@@ -41,9 +115,201 @@ public:
     {
         return m_benchmarkResult;
     }
+    //! Writes benchmark specific details of the last run, one line per detail.
+    virtual void write_details(std::ostream&) const {}
+
+    /**
+     * @brief Sets the counters which measure the timed repetitions of all following measurements.
+     * The counters have to outlive the measurements, nullptr disables counting.
+     *
+     * @param counters The counters.
+     */
+    static void set_perf_counters(PerfCounters* counters)
+    {
+        s_perfCounters = counters;
+    }
+
+    /**
+     * @brief Measures the time of the given function.
+     * The function is called repeatedly without timing for a warmup phase, which also determines how many
+     * repetitions form a batch that takes at least MIN_SAMPLE_TIME. Afterwards, batches are timed until
+     * the run time is over and at least MIN_SAMPLES batches were taken.
+     * If perf counters are set, the hardware events of the timed batches are counted.
+     * The counts of parallel functions are marked as incomplete if they run on more threads than are counted.
+     *
+     * @param function The function to measure.
+     * @param run_time The time spent on timed repetitions in seconds.
+     * @param o_num_reps Total number of timed repetitions.
+     * @param o_elapsed Total time of the timed repetitions in seconds.
+     * @param parallel True if the function runs on an OpenMP team.
+     * @return The statistics of the time per repetition.
+     */
+    template <typename F>
+    static benchmark_statistics measure(F&&     function,
+                                        double  run_time,
+                                        long&   o_num_reps,
+                                        double& o_elapsed,
+                                        bool    parallel = false);
+
+    /**
+     * @brief Computes the statistics of the given times of batches.
+     *
+     * @param samples Times of the batches in seconds.
+     * @param reps_per_sample Number of repetitions per batch.
+     * @param warmup_reps Number of warmup repetitions.
+     * @return The statistics of the time per repetition.
+     */
+    static benchmark_statistics compute_statistics(std::vector<double> samples,
+                                                   long                reps_per_sample,
+                                                   long                warmup_reps);
+
+    /**
+     * @brief Computes a percentile of sorted values with linear interpolation.
+     *
+     * @param sorted_values The values in ascending order.
+     * @param percentile The percentile in [0, 100].
+     * @return The percentile, 0 if there are no values.
+     */
+    static double percentile(std::vector<double> const& sorted_values,
+                             double                     percentile);
+
+    /**
+     * @brief Relates a result to the peaks of the machine.
+     * The arithmetic intensity is always computed, the remaining fields only if both peaks are known.
+     *
+     * @param result The result with total operations and processed data.
+     * @param peak_gflops Peak floating point throughput in GFLOPS.
+     * @param peak_gibps Peak memory bandwidth in GiB/s.
+     * @return The roofline of the result.
+     */
+    static benchmark_roofline compute_roofline(benchmark_result const& result,
+                                               double                  peak_gflops,
+                                               double                  peak_gibps);
+
+    /**
+     * @brief Returns the current frequency of the first CPU in MHz, 0 if it cannot be determined.
+     */
+    static double get_cpu_frequency();
+
+    /**
+     * @brief Writes the header of the CSV format of benchmark results.
+     *
+     * @param stream The output stream.
+     */
+    static void write_csv_header(std::ostream& stream);
+
+    /**
+     * @brief Writes a benchmark result as a CSV row.
+     *
+     * @param stream The output stream.
+     * @param name The name of the benchmark.
+     * @param result The result of the benchmark.
+     */
+    static void write_csv(std::ostream&           stream,
+                          std::string const&      name,
+                          benchmark_result const& result);
+
+    /**
+     * @brief Converts a benchmark result to a JSON object.
+     *
+     * @param name The name of the benchmark.
+     * @param result The result of the benchmark.
+     * @return The JSON object.
+     */
+    static std::string to_json(std::string const&      name,
+                               benchmark_result const& result);
 
 protected:
     benchmark_result m_benchmarkResult;
+
+private:
+    //! counters of the timed repetitions, nullptr if disabled
+    static inline PerfCounters* s_perfCounters = nullptr;
 };
 
-#endif // MINI_JIT_BENCHMARK_H
\ No newline at end of file
+template <typename F>
+mini_jit::Benchmark::benchmark_statistics mini_jit::Benchmark::measure(F&&     function,
+                                                                       double  run_time,
+                                                                       long&   o_num_reps,
+                                                                       double& o_elapsed,
+                                                                       bool    parallel)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto l_seconds_since = [](clock::time_point i_start)
+    {
+        return std::chrono::duration<double>(clock::now() - i_start).count();
+    };
+
+    // WARMUP
+    // batches are doubled until they are long enough, the warmup takes at least one batch of that size
+    long   l_reps_per_sample = 1;
+    long   l_warmup_reps     = 0;
+    double l_warmup_time     = WARMUP_FRACTION * run_time;
+    auto   l_warmup_start    = clock::now();
+    while (true)
+    {
+        auto l_batch_start = clock::now();
+        for (long i = 0; i < l_reps_per_sample; i++)
+        {
+            function();
+        }
+        double l_batch_time = l_seconds_since(l_batch_start);
+        l_warmup_reps += l_reps_per_sample;
+
+        if (l_batch_time < MIN_SAMPLE_TIME)
+        {
+            l_reps_per_sample *= 2;
+        }
+        else if (l_seconds_since(l_warmup_start) >= l_warmup_time)
+        {
+            break;
+        }
+    }
+    // END WARMUP
+
+    // RUN
+    PerfCounters* l_counters = s_perfCounters;
+    if (l_counters != nullptr)
+    {
+        l_counters->start();
+    }
+
+    std::vector<double> l_samples;
+    auto                l_start = clock::now();
+    do
+    {
+        auto l_batch_start = clock::now();
+        for (long i = 0; i < l_reps_per_sample; i++)
+        {
+            function();
+        }
+        l_samples.push_back(l_seconds_since(l_batch_start));
+    } while (l_seconds_since(l_start) < run_time || static_cast<long>(l_samples.size()) < MIN_SAMPLES);
+
+    if (l_counters != nullptr)
+    {
+        l_counters->stop();
+    }
+    // END RUN
+
+    o_num_reps = static_cast<long>(l_samples.size()) * l_reps_per_sample;
+    o_elapsed  = 0.0;
+    for (double l_sample : l_samples)
+    {
+        o_elapsed += l_sample;
+    }
+
+    benchmark_statistics l_stats = compute_statistics(std::move(l_samples),
+                                                      l_reps_per_sample,
+                                                      l_warmup_reps);
+    if (l_counters != nullptr)
+    {
+        l_stats.counters            = l_counters->read().per(o_num_reps);
+        l_stats.counters.incomplete = l_counters->available() && parallel && l_stats.numThreads > l_counters->num_threads();
+    }
+
+    return l_stats;
+}
+
+#endif // MINI_JIT_BENCHMARK_H
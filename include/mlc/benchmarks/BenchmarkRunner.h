@@ -0,0 +1,351 @@
+#ifndef MINI_JIT_BENCHMARK_RUNNER_H
+#define MINI_JIT_BENCHMARK_RUNNER_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mlc/benchmarks/Benchmark.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mini_jit
+{
+    namespace benchmarks
+    {
+        class BenchmarkRunner;
+    }
+} // namespace mini_jit
+
+/**
+ * @brief The BenchmarkRunner class holds a registry of benchmarks and runs a selection of them.
+ *
+ * Every benchmark is registered with a name, e.g. "matmul/gemm", a set of default parameter
+ * points and a factory which creates the benchmark for one parameter point. The command line
+ * or a config file selects benchmarks by name or regular expression and overrides parameters
+ * with lists or ranges of values. The runner executes the cartesian product of the overridden
+ * values for every default point and writes the results of a run to
+ * <output_dir>/<run_name>.json, .csv and .txt.
+ *
+ * With a baseline, the results are compared to the CSV of an earlier run and slowdowns
+ * beyond the tolerance and the measurement noise are reported as regressions.
+ *
+ * Every result is related to the peak GFLOPS and bandwidth of the machine (roofline model).
+ * The peaks are given as options or measured by probe benchmarks before the run.
+ * Optionally, hardware performance counters measure the timed repetitions of every benchmark.
+ */
+class mini_jit::benchmarks::BenchmarkRunner
+{
+public:
+    /// parameters of a benchmark, e.g. {"m": 64, "n": 64, "k": 64}
+    using params_t = std::map<std::string, int64_t>;
+
+    /// creates a benchmark for the given run time in seconds and parameters
+    using factory_t = std::function<std::unique_ptr<Benchmark>(double          run_time,
+                                                               params_t const& params)>;
+
+    /// measures a peak, i.e. GFLOPS or GiB/s, for the given run time in seconds
+    using probe_t = std::function<double(double run_time)>;
+
+    /// A registered benchmark.
+    struct entry_t
+    {
+        /// unique name, groups are separated by slashes
+        std::string name;
+        /// short description shown by --list
+        std::string description;
+        /// parameter points which are run if no parameter is overridden
+        std::vector<params_t> defaults;
+        /// creates the benchmark
+        factory_t factory;
+    };
+
+    /// The result of one benchmark run.
+    struct record_t
+    {
+        /// name of the registered benchmark
+        std::string name;
+        /// parameters of the run
+        params_t params;
+        /// measured result
+        Benchmark::benchmark_result result;
+    };
+
+    /// The comparison of a result with its baseline.
+    struct comparison_t
+    {
+        /// name and parameters of the run
+        std::string label;
+        /// median time per repetition of the baseline in seconds
+        double baseline_median = 0.0;
+        /// median time per repetition of the run in seconds
+        double median = 0.0;
+        /// baseline median divided by the median, below 1 for slowdowns
+        double speedup = 0.0;
+        /// whether the slowdown is significant
+        bool regression = false;
+    };
+
+private:
+    //! registered benchmarks in the order of registration
+    std::vector<entry_t> m_entries;
+    //! benchmark names or groups given as positional arguments
+    std::vector<std::string> m_names;
+    //! regular expression which the names of selected benchmarks have to contain
+    std::string m_filter;
+    //! overridden parameter values
+    std::map<std::string, std::vector<int64_t>> m_sweep;
+    //! run time of every benchmark in seconds
+    double m_run_time = 3.0;
+    //! directory of the result files
+    std::string m_output_dir = "benchmarks";
+    //! name of the run, the result files are named after it
+    std::string m_run_name;
+    //! list the selected benchmarks instead of running them
+    bool m_list = false;
+    //! print the usage instead of running benchmarks
+    bool m_help = false;
+    //! CSV of an earlier run which the results are compared to
+    std::string m_baseline;
+    //! overwrite the baseline with the results instead of comparing them
+    bool m_update_baseline = false;
+    //! relative slowdown of the median which is tolerated
+    double m_tolerance = 0.05;
+    //! peak floating point throughput in GFLOPS, 0 if unknown
+    double m_peak_gflops = 0.0;
+    //! peak memory bandwidth in GiB/s, 0 if unknown
+    double m_peak_gibps = 0.0;
+    //! measure unknown peaks with the probes before the run
+    bool m_roofline = false;
+    //! count hardware events of the timed repetitions
+    bool m_perf_counters = false;
+    //! measures the peak GFLOPS
+    probe_t m_compute_probe;
+    //! measures the peak bandwidth
+    probe_t m_bandwidth_probe;
+    //! results of the last run
+    std::vector<record_t> m_records;
+    //! comparisons of the last run with the baseline
+    std::vector<comparison_t> m_comparisons;
+
+    /**
+     * @brief Write the results of the last run to <output_dir>/<run_name>.json and .csv.
+     */
+    void write_results() const;
+
+    /**
+     * @brief Write the results of the last run as CSV.
+     *
+     * @param path Path of the CSV file.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    void write_csv(std::string const& path) const;
+
+public:
+    /**
+     * @brief Register a benchmark.
+     *
+     * @param name Unique name of the benchmark.
+     * @param description Short description of the benchmark.
+     * @param defaults Default parameter points, all points must have the same keys.
+     * @param factory Creates the benchmark for a parameter point.
+     * @throws std::invalid_argument if the name is already registered or there is no default point.
+     */
+    void add(std::string const&           name,
+             std::string const&           description,
+             std::vector<params_t> const& defaults,
+             factory_t                    factory);
+
+    /**
+     * @brief Set an option of the runner.
+     * Known options are filter, run_time, output_dir, name, config, baseline, update_baseline, tolerance,
+     * peak_gflops, peak_gibps, roofline, perf_counters, list and help, every other key must be a parameter of a registered benchmark.
+     *
+     * @param key The option, dashes are treated as underscores.
+     * @param value The value of the option.
+     * @throws std::invalid_argument if the option or its value is invalid.
+     */
+    void set_option(std::string const& key,
+                    std::string const& value);
+
+    /**
+     * @brief Set the benchmarks which measure the peaks if the roofline option is set.
+     *
+     * @param compute Measures the peak GFLOPS.
+     * @param bandwidth Measures the peak bandwidth in GiB/s.
+     */
+    void set_probes(probe_t compute,
+                    probe_t bandwidth);
+
+    /**
+     * @brief Parse command line arguments.
+     * Options are given as --key value or --key=value, positional arguments select benchmarks by name or group.
+     *
+     * @param argc Number of arguments.
+     * @param argv Arguments, the first one is the program name.
+     * @throws std::invalid_argument if an argument is invalid.
+     */
+    void parse_arguments(int                argc,
+                         char const* const* argv);
+
+    /**
+     * @brief Load options from a config file.
+     * Every line has the form key = value, # starts a comment.
+     *
+     * @param path Path of the config file.
+     * @throws std::runtime_error if the file cannot be opened.
+     * @throws std::invalid_argument if an option is invalid.
+     */
+    void load_config(std::string const& path);
+
+    /**
+     * @brief Parse a list of values, e.g. "1,16,32", "1:64" or "16:1024:*2".
+     * A range start:end[:step] includes both ends, a step starting with * multiplies instead of adds.
+     *
+     * @param text The values.
+     * @return The parsed values.
+     * @throws std::invalid_argument if the values cannot be parsed.
+     */
+    static std::vector<int64_t> parse_values(std::string const& text);
+
+    /**
+     * @brief Convert parameters to a string, e.g. "k=64 m=32 n=16".
+     */
+    static std::string to_string(params_t const& params);
+
+    /**
+     * @brief Get the benchmarks selected by the positional names and the filter.
+     */
+    std::vector<entry_t const*> select() const;
+
+    /**
+     * @brief Get the parameter points of a benchmark.
+     * For every default point, the cartesian product of the overridden values of its parameters is returned.
+     *
+     * @param entry The benchmark.
+     * @return The parameter points without duplicates.
+     */
+    std::vector<params_t> sweep(entry_t const& entry) const;
+
+    /**
+     * @brief Check whether the time per repetition got significantly worse.
+     * This is the case if the median slowed down by more than the tolerance and
+     * the 5th percentile of the new times lies above the 95th percentile of the baseline.
+     *
+     * @param baseline Statistics of the baseline.
+     * @param current Statistics of the new measurement.
+     * @param tolerance Relative slowdown of the median which is tolerated.
+     * @return True if the slowdown is significant.
+     */
+    static bool is_regression(Benchmark::benchmark_statistics const& baseline,
+                              Benchmark::benchmark_statistics const& current,
+                              double                                 tolerance);
+
+    /**
+     * @brief Compare the results of the last run with the CSV of an earlier run.
+     * Results are matched by the name column, results without a baseline are skipped.
+     * A missing baseline file only produces a warning and skips the whole comparison.
+     *
+     * @param path Path of the baseline CSV.
+     * @param log Stream for the comparison.
+     * @return The number of regressions.
+     * @throws std::runtime_error if the baseline misses a required column.
+     */
+    int64_t compare_to_baseline(std::string const& path,
+                                std::ostream&      log);
+
+    /**
+     * @brief Run all parameter points of the selected benchmarks and write the result files.
+     * Benchmarks which throw are reported and skipped. With a baseline, the results are
+     * compared to it afterwards or written to it if the baseline is updated.
+     *
+     * @param log Stream for progress messages.
+     * @return The number of failed benchmark runs and regressions.
+     */
+    int64_t run(std::ostream& log);
+
+    /**
+     * @brief Entry point of a benchmark binary: parses the arguments and lists or runs the selected benchmarks.
+     *
+     * @param argc Number of arguments.
+     * @param argv Arguments, the first one is the program name.
+     * @return The exit code.
+     */
+    int main(int                argc,
+             char const* const* argv);
+
+    /**
+     * @brief Print the usage of a benchmark binary.
+     *
+     * @param stream The output stream.
+     * @param program Name of the program.
+     */
+    void print_usage(std::ostream&      stream,
+                     std::string const& program) const;
+
+    /**
+     * @brief Print the selected benchmarks and their parameter points.
+     *
+     * @param stream The output stream.
+     */
+    void print_list(std::ostream& stream) const;
+
+    /**
+     * @brief Get the name of the run, a timestamp unless set.
+     */
+    std::string const& get_run_name() const
+    {
+        return m_run_name;
+    }
+
+    /**
+     * @brief Get the directory of the result files.
+     */
+    std::string const& get_output_dir() const
+    {
+        return m_output_dir;
+    }
+
+    /**
+     * @brief Get the run time of every benchmark in seconds.
+     */
+    double get_run_time() const
+    {
+        return m_run_time;
+    }
+
+    /**
+     * @brief Get the peak floating point throughput in GFLOPS, 0 if unknown.
+     */
+    double get_peak_gflops() const
+    {
+        return m_peak_gflops;
+    }
+
+    /**
+     * @brief Get the peak memory bandwidth in GiB/s, 0 if unknown.
+     */
+    double get_peak_gibps() const
+    {
+        return m_peak_gibps;
+    }
+
+    /**
+     * @brief Get the results of the last run.
+     */
+    std::vector<record_t> const& get_records() const
+    {
+        return m_records;
+    }
+
+    /**
+     * @brief Get the comparisons of the last run with the baseline.
+     */
+    std::vector<comparison_t> const& get_comparisons() const
+    {
+        return m_comparisons;
+    }
+};
+
+#endif // MINI_JIT_BENCHMARK_RUNNER_H
@@ -20,7 +20,19 @@ namespace mini_jit
                             int64_t                             thread_target,
                             int64_t                             max_kernel_size,
                             int64_t                             min_kernel_size,
-                            std::map<std::string, void const*>& tensor_inputs);
+                            std::map<std::string, void const*> const& tensor_inputs);
+
+            /**
+             * @brief Constructor for the benchmark of an einsum tree which allocates its own input tensors.
+             * The elements of every input tensor are initialized with their index modulo 100.
+             */
+            EinsumTreeBench(double                run_time,
+                            std::string const&    einsum_expression,
+                            std::vector<int64_t>& dimension_sizes,
+                            mini_jit::dtype_t     dtype,
+                            int64_t               thread_target,
+                            int64_t               max_kernel_size,
+                            int64_t               min_kernel_size);
             //! Destructor
             ~EinsumTreeBench() override
             {
@@ -32,11 +44,26 @@ namespace mini_jit
             //! Runs the benchmark.
             void run() override;
 
+            //! Returns the number of bytes of intermediate tensors zeroed per execution.
+            int64_t get_zero_fill_bytes() const;
+
+            //! Returns the number of bytes of intermediate tensors which do not need zeroing per execution.
+            int64_t get_skipped_zero_fill_bytes() const;
+
+            //! Writes the zero-fill traffic of the last run and the time it saves.
+            //! The time is measured by a second run which zeroes the outputs of all nodes upfront.
+            void write_details(std::ostream& stream) const override;
+
         private:
             double                             m_run_time;
             std::vector<int64_t>               m_dimension_sizes;
             std::map<std::string, void const*> m_tensor_inputs;
             mini_jit::einsum::EinsumNode*      m_root_node = nullptr;
+            //! median time of an execution which zeroes the outputs of all nodes, 0 if no zero-fill is skipped
+            double                             m_forced_zero_fill_median = 0.0;
+            //! input tensors owned by the benchmark
+            std::vector<std::vector<float>>    m_inputs_fp32;
+            std::vector<std::vector<double>>   m_inputs_fp64;
         };
     } // namespace benchmarks
 } // namespace mini_jit
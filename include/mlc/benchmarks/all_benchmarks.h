@@ -3,8 +3,13 @@
 
 #include <mlc/benchmarks/EinsumTree.bench.h>
 #include <mlc/benchmarks/TensorOperation.bench.h>
+#include <mlc/benchmarks/binary/binary_primitive.bench.h>
+#include <mlc/benchmarks/jit/kernel_generation.bench.h>
+#include <mlc/benchmarks/jit/tensor_operation_setup.bench.h>
 #include <mlc/benchmarks/matmul/Matmul_br_m_n_k.bench.h>
 #include <mlc/benchmarks/matmul/Matmul_m_n_k.bench.h>
+#include <mlc/benchmarks/roofline/fmla_throughput.bench.h>
+#include <mlc/benchmarks/roofline/stream_triad.bench.h>
 #include <mlc/benchmarks/unary/fast_sigmoid_primitive.bench.h>
 #include <mlc/benchmarks/unary/identity_primitive.bench.h>
 #include <mlc/benchmarks/unary/identity_trans_primitive.bench.h>
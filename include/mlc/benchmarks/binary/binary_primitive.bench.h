@@ -0,0 +1,43 @@
+#ifndef BINARY_PRIMITIVE_BENCH_H
+#define BINARY_PRIMITIVE_BENCH_H
+#include <cstdint>
+#include <mlc/benchmarks/Benchmark.h>
+#include <mlc/types.h>
+
+namespace mini_jit
+{
+    namespace benchmarks
+    {
+        class BinaryPrimitiveBench : public Benchmark
+        {
+        public:
+            /**
+             * @brief Constructor for the benchmark for the binary primitives.
+             * @param runTime The time to run the benchmark in seconds.
+             * @param m number of rows in A, B and C.
+             * @param n number of columns in A, B and C.
+             * @param ptype The binary primitive, e.g. add or max.
+             */
+            BinaryPrimitiveBench(double            runTime,
+                                 uint32_t          m,
+                                 uint32_t          n,
+                                 mini_jit::ptype_t ptype);
+            //! Destructor
+            ~BinaryPrimitiveBench() override = default;
+            //! Runs the benchmark.
+            void run() override;
+
+        private:
+            uint32_t          m_M;
+            uint32_t          m_N;
+            double            m_runTime;
+            mini_jit::ptype_t m_ptype;
+            float*            m_A;
+            float*            m_B;
+            float*            m_C;
+        };
+
+    } // namespace benchmarks
+} // namespace mini_jit
+
+#endif // BINARY_PRIMITIVE_BENCH_H
@@ -0,0 +1,46 @@
+#ifndef KERNEL_GENERATION_BENCH_H
+#define KERNEL_GENERATION_BENCH_H
+#include <cstddef>
+#include <functional>
+#include <mlc/benchmarks/Benchmark.h>
+#include <ostream>
+
+namespace mini_jit
+{
+    namespace benchmarks
+    {
+        /**
+         * @brief Latency of JIT-ing a kernel, from emitting the instructions to the executable memory.
+         * The kernels are only generated, never executed.
+         */
+        class KernelGenerationBench : public Benchmark
+        {
+        public:
+            //! Generates a kernel and returns the size of its code in bytes.
+            using generator_t = std::function<std::size_t()>;
+
+            /**
+             * @brief Constructor for the benchmark of a kernel generator.
+             * @param runTime The time to run the benchmark in seconds.
+             * @param generator Generates the kernel, throws if the configuration is not supported.
+             */
+            KernelGenerationBench(double      runTime,
+                                  generator_t generator);
+            //! Destructor
+            ~KernelGenerationBench() override = default;
+            //! Runs the benchmark.
+            void run() override;
+
+            //! Writes the size of the generated code and the time per instruction.
+            void write_details(std::ostream& stream) const override;
+
+        private:
+            double      m_runTime;
+            generator_t m_generator;
+            std::size_t m_codeSize = 0;
+        };
+
+    } // namespace benchmarks
+} // namespace mini_jit
+
+#endif // KERNEL_GENERATION_BENCH_H
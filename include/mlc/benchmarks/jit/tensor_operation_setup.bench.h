@@ -0,0 +1,76 @@
+#ifndef TENSOR_OPERATION_SETUP_BENCH_H
+#define TENSOR_OPERATION_SETUP_BENCH_H
+#include <mlc/TensorOperation.h>
+#include <mlc/benchmarks/Benchmark.h>
+#include <mlc/types.h>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace mini_jit
+{
+    namespace benchmarks
+    {
+        /**
+         * @brief Latency of TensorOperation::setup, which analyzes the loops and JIT-s all kernels.
+         * Every repetition sets up a new operation, the operations are never executed.
+         */
+        class TensorOperationSetupBench : public Benchmark
+        {
+        public:
+            /**
+             * @brief Constructor for the benchmark of the setup of tensor operations.
+             * @param run_time The time to run the benchmark in seconds.
+             * @param dtype             Datatype of all tensor elements.
+             * @param prim_first_touch  Type of the first touch primitive.
+             * @param prim_main         Type of the main primitive.
+             * @param prim_last_touch   Type of the last touch primitive.
+             * @param dim_types         Dimension type of the loops (c, m, n, or k).
+             * @param exec_types        Execution type of the loops (seq, shared, or prim).
+             * @param dim_sizes         Sizes of the dimensions.
+             * @param strides_in0       Strides of the first input tensor.
+             * @param strides_in1       Strides of the second input tensor (ignored if unary).
+             * @param strides_out       Strides of the output tensor.
+             */
+            TensorOperationSetupBench(double                   run_time,
+                                      dtype_t                  dtype,
+                                      ptype_t                  prim_first_touch,
+                                      ptype_t                  prim_main,
+                                      ptype_t                  prim_last_touch,
+                                      std::span<const dim_t>   dim_types,
+                                      std::span<const exec_t>  exec_types,
+                                      std::span<const int64_t> dim_sizes,
+                                      std::span<const int64_t> strides_in0,
+                                      std::span<const int64_t> strides_in1,
+                                      std::span<const int64_t> strides_out);
+            //! Destructor
+            ~TensorOperationSetupBench() override = default;
+            //! Runs the benchmark.
+            void run() override;
+
+            //! Writes the mean time of the phases of the setup.
+            void write_details(std::ostream& stream) const override;
+
+        private:
+            double                           m_run_time;
+            dtype_t                          m_dtype;
+            ptype_t                          m_prim_first_touch;
+            ptype_t                          m_prim_main;
+            ptype_t                          m_prim_last_touch;
+            std::vector<dim_t>               m_dim_types;
+            std::vector<exec_t>              m_exec_types;
+            std::vector<int64_t>             m_dim_sizes;
+            std::vector<int64_t>             m_strides_in0;
+            std::vector<int64_t>             m_strides_in1;
+            std::vector<int64_t>             m_strides_out;
+            //! sum of the timings of all setups of the last run
+            TensorOperation::setup_timings_t m_timings_sum;
+            //! number of setups of the last run
+            long                             m_num_setups = 0;
+            //! size of the code generated by a setup in bytes
+            std::size_t                      m_code_size = 0;
+        };
+    } // namespace benchmarks
+} // namespace mini_jit
+
+#endif // TENSOR_OPERATION_SETUP_BENCH_H
@@ -0,0 +1,48 @@
+#ifndef FMLA_THROUGHPUT_BENCH_H
+#define FMLA_THROUGHPUT_BENCH_H
+#include <cstdint>
+#include <mlc/Kernel.h>
+#include <mlc/benchmarks/Benchmark.h>
+
+namespace mini_jit
+{
+    namespace benchmarks
+    {
+        /**
+         * @brief Throughput of independent FMLA (vector, 4S) instructions on all OpenMP threads.
+         * The achieved GFLOPS serve as the compute roof of the roofline model.
+         */
+        class FmlaThroughputBench : public Benchmark
+        {
+        public:
+            //! Number of FMLA instructions per loop iteration of the kernel.
+            static constexpr int64_t FMLAS_PER_ITERATION = 100;
+
+            /**
+             * @brief Constructor for the FMLA throughput benchmark.
+             * @param runTime The time to run the benchmark in seconds.
+             * @param iterations number of loop iterations per call of the kernel.
+             */
+            FmlaThroughputBench(double  runTime,
+                                int64_t iterations);
+            //! Destructor
+            ~FmlaThroughputBench() override = default;
+            //! Runs the benchmark.
+            void run() override;
+
+            /**
+             * @brief Generates the kernel void kernel(int64_t iterations).
+             * The loop body consists of FMLAS_PER_ITERATION instructions on 20 independent accumulators.
+             * @param kernel The kernel to generate.
+             */
+            static void generate(mini_jit::Kernel& kernel);
+
+        private:
+            int64_t m_iterations;
+            double  m_runTime;
+        };
+
+    } // namespace benchmarks
+} // namespace mini_jit
+
+#endif // FMLA_THROUGHPUT_BENCH_H
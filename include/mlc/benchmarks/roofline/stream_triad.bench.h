@@ -0,0 +1,41 @@
+#ifndef STREAM_TRIAD_BENCH_H
+#define STREAM_TRIAD_BENCH_H
+#include <cstdint>
+#include <mlc/benchmarks/Benchmark.h>
+#include <vector>
+
+namespace mini_jit
+{
+    namespace benchmarks
+    {
+        /**
+         * @brief STREAM-like triad a[i] = b[i] + s * c[i] on all OpenMP threads.
+         * The achieved bandwidth serves as the memory roof of the roofline model.
+         */
+        class StreamTriadBench : public Benchmark
+        {
+        public:
+            /**
+             * @brief Constructor for the triad benchmark.
+             * @param runTime The time to run the benchmark in seconds.
+             * @param numElements number of elements per array, should exceed the caches by far.
+             */
+            StreamTriadBench(double  runTime,
+                             int64_t numElements);
+            //! Destructor
+            ~StreamTriadBench() override = default;
+            //! Runs the benchmark.
+            void run() override;
+
+        private:
+            int64_t            m_numElements;
+            double             m_runTime;
+            std::vector<float> m_A;
+            std::vector<float> m_B;
+            std::vector<float> m_C;
+        };
+
+    } // namespace benchmarks
+} // namespace mini_jit
+
+#endif // STREAM_TRIAD_BENCH_H
@@ -46,9 +46,16 @@ namespace mini_jit
             /// Strides of the output tensor
             std::vector<int64_t> m_strides_out;
 
+            /// Remainders of the peeled loops, empty if the loops are not optimized
+            std::vector<int64_t> m_dim_remainders;
+
             /// Size of the output tensor
             int64_t m_tensor_size = 1;
 
+            /// Whether the output tensor has to be zeroed before the operation is executed.
+            /// False if the lowered operation writes every output element without reading it first.
+            bool m_zero_output = true;
+
             /// The output tensor for this node
             void* m_tensor_out = nullptr;
 
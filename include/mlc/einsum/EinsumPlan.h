@@ -0,0 +1,318 @@
+#ifndef MINI_JIT_EINSUM_EINSUM_PLAN_H
+#define MINI_JIT_EINSUM_EINSUM_PLAN_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mlc/einsum/EinsumNode.h>
+#include <mlc/ir/CostModel.h>
+#include <mlc/types.h>
+#include <string>
+#include <vector>
+
+namespace mini_jit
+{
+    namespace einsum
+    {
+        class EinsumPlan;
+    }
+} // namespace mini_jit
+
+/**
+ * @brief The EinsumPlan class is a compiled, immutable einsum expression.
+ *
+ * The constructor parses, optimizes and lowers the expression once. It keeps the
+ * JIT-ed tensor operations, a flat execution schedule and a memory plan which
+ * places all intermediate tensors in a single scratch buffer.
+ *
+ * Executing a plan does not modify it. Multiple threads may therefore execute the
+ * same plan concurrently, as long as every call uses its own output and scratch buffer.
+ */
+class mini_jit::einsum::EinsumPlan
+{
+private:
+    /// Location of a tensor used by a step of the schedule.
+    struct buffer_t
+    {
+        enum class kind_t
+        {
+            none,
+            input,
+            scratch,
+            output
+        };
+
+        /// where the tensor is located
+        kind_t kind = kind_t::none;
+        /// input index for inputs, byte offset for scratch tensors
+        int64_t value = 0;
+    };
+
+    /// A single tensor operation of the schedule.
+    struct step_t
+    {
+        /// node holding the lowered tensor operation
+        EinsumNode const* node = nullptr;
+        /// first input of the operation
+        buffer_t in0;
+        /// second input of the operation (none if unary)
+        buffer_t in1;
+        /// output of the operation
+        buffer_t out;
+        /// size of the output tensor in bytes
+        int64_t out_bytes = 0;
+    };
+
+    /// root of the lowered einsum tree, also freed if the constructor throws
+    std::unique_ptr<EinsumNode> m_root;
+    /// sizes of the dimensions sorted by id
+    std::vector<int64_t> m_dimension_sizes;
+    /// data type of all tensors
+    dtype_t m_dtype = dtype_t::fp32;
+    /// expressions of the input tensors, defines the order of the inputs
+    std::vector<std::string> m_input_expressions;
+    /// operations in execution order (post order of the tree)
+    std::vector<step_t> m_steps;
+    /// number of bytes needed for all intermediate tensors
+    int64_t m_scratch_size = 0;
+    /// number of bytes of the output tensor
+    int64_t m_output_size = 0;
+    /// number of bytes of all JIT-ed kernels
+    int64_t m_code_size = 0;
+
+    /**
+     * @brief Creates the schedule for the given node and its children.
+     *
+     * @param node The node to schedule.
+     * @param is_root True if the node writes to the output tensor.
+     * @return The location of the node's output tensor.
+     */
+    buffer_t schedule(EinsumNode const* node,
+                      bool              is_root);
+
+    /**
+     * @brief Assigns scratch offsets to all intermediate tensors.
+     * Tensors whose lifetimes do not overlap share the same memory.
+     */
+    void plan_memory();
+
+    /**
+     * @brief Returns the address of the given buffer.
+     *
+     * @param buffer The buffer to resolve.
+     * @param inputs The input tensors.
+     * @param output The output tensor.
+     * @param scratch The scratch buffer.
+     */
+    static void* resolve(buffer_t const&                 buffer,
+                         std::vector<void const*> const& inputs,
+                         void*                           output,
+                         void*                           scratch);
+
+    /**
+     * @brief Executes all operations of the schedule.
+     *
+     * @param inputs The input tensors in the order of get_input_expressions().
+     * @param output The output tensor.
+     * @param scratch A buffer of at least get_scratch_size() bytes.
+     * @param parallel True if the operations may use their shared loops, false to run on the calling thread only.
+     */
+    void execute_steps(std::vector<void const*> const& inputs,
+                       void*                           output,
+                       void*                           scratch,
+                       bool                            parallel) const;
+
+public:
+    /// alignment of the scratch buffer and of the intermediate tensors inside it in bytes
+    static constexpr int64_t SCRATCH_ALIGNMENT = 64;
+
+    /**
+     * @brief Scratch buffer which is aligned to SCRATCH_ALIGNMENT bytes.
+     */
+    class scratch_t
+    {
+    private:
+        void* m_data = nullptr;
+
+    public:
+        /**
+         * @brief Allocates the scratch buffer.
+         *
+         * @param size The number of bytes, e.g. get_scratch_size().
+         */
+        explicit scratch_t(int64_t size);
+
+        //! The buffer is owned by the object and cannot be copied.
+        scratch_t(scratch_t const&) = delete;
+
+        //! The buffer is owned by the object and cannot be copied.
+        scratch_t& operator=(scratch_t const&) = delete;
+
+        /// @brief Destructor
+        ~scratch_t() noexcept;
+
+        /**
+         * @brief Get the address of the buffer.
+         */
+        void* data() const
+        {
+            return m_data;
+        }
+    };
+
+    /**
+     * @brief Compiles the given einsum expression.
+     *
+     * @param einsum_expression The string representation of the einsum operation.
+     * @param dimension_sizes The sizes of the dimensions sorted by id.
+     * @param dtype The data type of the tensors.
+     * @param thread_target The target number of threads for parallel execution.
+     * @param max_kernel_size The maximum size of a kernel dimension.
+     * @param min_kernel_size The minimum size of a kernel dimension.
+     * @param cost_model The cost model used to optimize the tensor operations.
+     * @throws std::invalid_argument if the setup of a tensor operation fails.
+     */
+    EinsumPlan(std::string const&             einsum_expression,
+               std::vector<int64_t> const&    dimension_sizes,
+               dtype_t                        dtype,
+               int64_t                        thread_target,
+               int64_t                        max_kernel_size,
+               int64_t                        min_kernel_size,
+               mini_jit::ir::CostModel const& cost_model = mini_jit::ir::CostModel());
+
+    //! The plan owns JIT-ed kernels and cannot be copied.
+    EinsumPlan(EinsumPlan const&) = delete;
+
+    //! The plan owns JIT-ed kernels and cannot be copied.
+    EinsumPlan& operator=(EinsumPlan const&) = delete;
+
+    /// @brief Destructor
+    ~EinsumPlan() noexcept;
+
+    /**
+     * @brief Executes the plan.
+     *
+     * @param inputs The input tensors in the order of get_input_expressions().
+     * @param output The output tensor.
+     * @param scratch A buffer of at least get_scratch_size() bytes, aligned to SCRATCH_ALIGNMENT bytes, see scratch_t.
+     */
+    void execute(std::vector<void const*> const& inputs,
+                 void*                           output,
+                 void*                           scratch) const;
+
+    /**
+     * @brief Executes the plan.
+     *
+     * @param inputs A map from input expressions to input tensors.
+     * @param output The output tensor.
+     * @param scratch A buffer of at least get_scratch_size() bytes, aligned to SCRATCH_ALIGNMENT bytes, see scratch_t.
+     */
+    void execute(std::map<std::string, void const*> const& inputs,
+                 void*                                     output,
+                 void*                                     scratch) const;
+
+    /**
+     * @brief Executes the plan with a scratch buffer allocated for this call.
+     *
+     * @param inputs The input tensors in the order of get_input_expressions().
+     * @param output The output tensor.
+     */
+    void execute(std::vector<void const*> const& inputs,
+                 void*                           output) const;
+
+    /**
+     * @brief Executes the plan for a batch of independent input sets.
+     * If the batch is large enough to keep all threads busy, the batch is distributed
+     * across the threads and every sample is computed by a single thread with its own
+     * scratch buffer. Otherwise, the samples are computed one after another using the
+     * shared loops of the operations.
+     *
+     * @param batch_size The number of input sets.
+     * @param inputs The input tensors of the first sample in the order of get_input_expressions().
+     * @param input_batch_strides The distance between two samples of each input in elements (0 to broadcast).
+     * @param output The output tensor of the first sample.
+     * @param output_batch_stride The distance between two samples of the output in elements.
+     */
+    void execute_batched(int64_t                         batch_size,
+                         std::vector<void const*> const& inputs,
+                         std::vector<int64_t> const&     input_batch_strides,
+                         void*                           output,
+                         int64_t                         output_batch_stride) const;
+
+    /**
+     * @brief Get the expressions of the input tensors in the order in
+     * which they appear in the einsum expression.
+     */
+    std::vector<std::string> const& get_input_expressions() const
+    {
+        return m_input_expressions;
+    }
+
+    /**
+     * @brief Get the number of bytes required for the scratch buffer.
+     */
+    int64_t get_scratch_size() const
+    {
+        return m_scratch_size;
+    }
+
+    /**
+     * @brief Get the number of bytes of the output tensor.
+     */
+    int64_t get_output_size() const
+    {
+        return m_output_size;
+    }
+
+    /**
+     * @brief Get the number of bytes of all JIT-ed kernels of the plan.
+     */
+    int64_t get_code_size() const
+    {
+        return m_code_size;
+    }
+
+    /**
+     * @brief Get the number of tensor operations executed per call.
+     */
+    int64_t get_number_of_operations() const
+    {
+        return static_cast<int64_t>(m_steps.size());
+    }
+
+    /**
+     * @brief Get the number of floating point operations per call.
+     */
+    double get_computational_operations() const
+    {
+        return m_root->m_computational_operations;
+    }
+
+    /**
+     * @brief Get the root of the lowered einsum tree.
+     */
+    EinsumNode const* get_root() const
+    {
+        return m_root.get();
+    }
+
+    /**
+     * @brief Get the data type of the tensors.
+     */
+    dtype_t get_dtype() const
+    {
+        return m_dtype;
+    }
+
+    /**
+     * @brief Convert the lowered einsum tree to a string representation.
+     */
+    std::string to_string() const;
+
+    /**
+     * @brief Convert the lowered einsum tree to JSON, including the optimization report of every operation.
+     */
+    std::string to_json() const;
+};
+
+#endif // MINI_JIT_EINSUM_EINSUM_PLAN_H
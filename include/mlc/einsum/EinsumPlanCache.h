@@ -0,0 +1,152 @@
+#ifndef MINI_JIT_EINSUM_EINSUM_PLAN_CACHE_H
+#define MINI_JIT_EINSUM_EINSUM_PLAN_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mlc/einsum/EinsumPlan.h>
+#include <mlc/types.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mini_jit
+{
+    namespace einsum
+    {
+        class EinsumPlanCache;
+    }
+} // namespace mini_jit
+
+/**
+ * @brief The EinsumPlanCache class stores compiled einsum plans, so that repeated
+ * requests for the same expression skip parsing, optimization and JIT compilation.
+ *
+ * Plans are keyed on the expression, the dimension sizes, the data type and the
+ * optimizer parameters. The least recently used plans are evicted once the memory
+ * of all cached plans (JIT-ed code and scratch buffer size) exceeds the limit.
+ * Evicted plans stay valid as long as a caller holds a reference to them.
+ *
+ * All member functions are thread-safe.
+ */
+class mini_jit::einsum::EinsumPlanCache
+{
+private:
+    /// Parameters which uniquely identify a plan.
+    struct key_t
+    {
+        /// the einsum expression
+        std::string expression;
+        /// sizes of the dimensions sorted by id
+        std::vector<int64_t> dimension_sizes;
+        /// data type of the tensors
+        dtype_t dtype;
+        /// target number of threads of the optimizer
+        int64_t thread_target;
+        /// maximum kernel size of the optimizer
+        int64_t max_kernel_size;
+        /// minimum kernel size of the optimizer
+        int64_t min_kernel_size;
+
+        bool operator==(key_t const& other) const = default;
+    };
+
+    /// Hash function for plan keys.
+    struct key_hash_t
+    {
+        std::size_t operator()(key_t const& key) const;
+    };
+
+    /// A cached plan.
+    struct entry_t
+    {
+        /// key of the plan
+        key_t key;
+        /// the compiled plan
+        std::shared_ptr<EinsumPlan const> plan;
+        /// memory accounted for the plan in bytes
+        int64_t footprint;
+    };
+
+    /// cached plans, the most recently used plan is at the front
+    std::list<entry_t> m_entries;
+    /// lookup table from keys to cached plans
+    std::unordered_map<key_t, std::list<entry_t>::iterator, key_hash_t> m_index;
+    /// maximum memory of all cached plans in bytes
+    int64_t m_max_size = 0;
+    /// current memory of all cached plans in bytes
+    int64_t m_size = 0;
+    /// number of requests served from the cache
+    int64_t m_num_hits = 0;
+    /// number of requests which compiled a new plan
+    int64_t m_num_misses = 0;
+    /// number of plans removed to stay within the memory limit
+    int64_t m_num_evictions = 0;
+    /// guards all members
+    mutable std::mutex m_mutex;
+
+    /**
+     * @brief Evicts the least recently used plans until the memory limit is met.
+     * The caller has to hold the lock.
+     */
+    void evict();
+
+public:
+    /**
+     * @brief Creates an empty cache.
+     *
+     * @param max_size Maximum memory of all cached plans in bytes.
+     */
+    explicit EinsumPlanCache(int64_t max_size);
+
+    /**
+     * @brief Returns the plan for the given parameters. The plan is compiled on a cache miss.
+     *
+     * @param einsum_expression The string representation of the einsum operation.
+     * @param dimension_sizes The sizes of the dimensions sorted by id.
+     * @param dtype The data type of the tensors.
+     * @param thread_target The target number of threads for parallel execution.
+     * @param max_kernel_size The maximum size of a kernel dimension.
+     * @param min_kernel_size The minimum size of a kernel dimension.
+     * @return The compiled plan.
+     */
+    std::shared_ptr<EinsumPlan const> get(std::string const&          einsum_expression,
+                                          std::vector<int64_t> const& dimension_sizes,
+                                          dtype_t                     dtype,
+                                          int64_t                     thread_target,
+                                          int64_t                     max_kernel_size,
+                                          int64_t                     min_kernel_size);
+
+    /**
+     * @brief Removes all plans from the cache.
+     */
+    void clear();
+
+    /**
+     * @brief Get the memory of all cached plans in bytes.
+     */
+    int64_t get_size() const;
+
+    /**
+     * @brief Get the number of cached plans.
+     */
+    int64_t get_number_of_plans() const;
+
+    /**
+     * @brief Get the number of requests served from the cache.
+     */
+    int64_t get_number_of_hits() const;
+
+    /**
+     * @brief Get the number of requests which compiled a new plan.
+     */
+    int64_t get_number_of_misses() const;
+
+    /**
+     * @brief Get the number of plans evicted from the cache.
+     */
+    int64_t get_number_of_evictions() const;
+};
+
+#endif // MINI_JIT_EINSUM_EINSUM_PLAN_CACHE_H
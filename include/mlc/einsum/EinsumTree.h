@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <mlc/einsum/EinsumNode.h>
+#include <mlc/ir/CostModel.h>
 #include <ranges>
 #include <string>
 #include <vector>
@@ -25,7 +26,8 @@ class mini_jit::einsum::EinsumTree
 public:
     /**
      * @brief Parses the einsum expression and creates an einsum tree.
-     * In case the dimensions are not in an optimal order, permutation nodes will be inserted.
+     * In case the dimensions of an input tensor are not in an optimal order, permutation nodes will be inserted.
+     * Permutations of intermediate results are folded into the layout of the producing operation.
      *
      * @param einsum_expression The string representation of the einsum operation.
      * @param dimension_sizes A vector to store the sizes of the dimensions used in the expression.
@@ -77,11 +79,78 @@ private:
      * @brief Reorders the dimensions inside the nodes of the given einsum tree
      * to ensure correct dimension positions for performant execution.
      * If this function is applied, no swapping of nodes is necessary.
+     * Intermediate results are computed in the required layout directly,
+     * permutation nodes are only inserted for input tensors.
      *
      * @param root_node The root node of the einsum tree.
      */
     static void reorder_node_dimensions(EinsumNode* root_node);
 
+    /**
+     * @brief Chooses the layouts of all intermediate tensors of the given einsum tree.
+     * The unit stride dimension of an intermediate tensor is fixed by reorder_node_dimensions,
+     * the order of the remaining dimensions is chosen jointly for the operation producing the
+     * tensor and the operation consuming it, such that both have as few non-contiguous loops as possible.
+     * Permutation nodes which end up not changing the layout are removed.
+     *
+     * @param root_node The root node of the einsum tree.
+     */
+    static void propagate_layouts(EinsumNode* root_node);
+
+    /**
+     * @brief Chooses the layout of the output tensor of a child node.
+     *
+     * @param parent_node The node consuming the tensor.
+     * @param child_node Reference to the pointer of the node producing the tensor inside the tree.
+     */
+    static void choose_layout(EinsumNode*  parent_node,
+                              EinsumNode*& child_node);
+
+    /**
+     * @brief Counts the loops of the operation of the given node which remain after
+     * fusing dimensions that are contiguous in all tensors of the operation.
+     *
+     * @param node The node of the operation.
+     * @return The number of loops, zero for input tensors and permutations which do not change the layout.
+     */
+    static int64_t count_loops(EinsumNode const* node);
+
+    /**
+     * @brief Removes permutation nodes whose input is computed by a contraction.
+     * The contraction writes its output in the permuted layout instead.
+     *
+     * @param root_node The root node of the einsum tree.
+     * @return The new root node of the einsum tree.
+     */
+    static EinsumNode* fold_permutation_nodes(EinsumNode* root_node);
+
+    /**
+     * @brief Checks whether the operation of the given node can produce its output
+     * with the given dimension as unit stride dimension, without requiring
+     * additional permutations of input tensors.
+     *
+     * @param node The node which computes the tensor.
+     * @param unit_stride_dim_id The id of the dimension which should have unit stride.
+     * @return True if the output layout of the node can be changed accordingly, false otherwise.
+     */
+    static bool can_reorder_output(EinsumNode const* node,
+                                   int64_t           unit_stride_dim_id);
+
+    /**
+     * @brief Replaces a permutation node by its child if it does not change the layout.
+     *
+     * @param node Reference to the node pointer inside the tree.
+     */
+    static void remove_redundant_permutation(EinsumNode*& node);
+
+    /**
+     * @brief Creates the string representation of the given dimension ids.
+     *
+     * @param dimension_ids The ids of the dimensions.
+     * @return The comma separated ids.
+     */
+    static std::string to_expression(std::vector<int64_t> const& dimension_ids);
+
     /**
      * @brief Optimize the einsum tree by swapping nodes.
      *
@@ -115,11 +184,13 @@ public:
      * @param thread_target The target number of threads for parallel execution.
      * @param max_kernel_size The maximum size of the kernel to be used.
      * @param min_kernel_size The minimum size of the kernel to be used.
+     * @param cost_model The cost model used to score the configurations of each node.
      */
-    static void optimize_einsum_nodes(EinsumNode* root_node,
-                                      int64_t     thread_target,
-                                      int64_t     max_kernel_size,
-                                      int64_t     min_kernel_size);
+    static void optimize_einsum_nodes(EinsumNode*                    root_node,
+                                      int64_t                        thread_target,
+                                      int64_t                        max_kernel_size,
+                                      int64_t                        min_kernel_size,
+                                      mini_jit::ir::CostModel const& cost_model = mini_jit::ir::CostModel());
 
     /**
      * @brief Lower the given einsum tree to executable tensor operations.
@@ -127,10 +198,11 @@ public:
      * @param root_node The root node of the einsum tree.
      * @param dimension_sizes The array with the dimension sizes sorted by id.
      * @param dtype The data type of the tensor.
+     * @return The first error of the setup of a tensor operation, success if all operations were set up.
      */
-    static void lower_einsum_nodes_to_tensor_operations(EinsumNode*           root_node,
-                                                        std::vector<int64_t>& dimension_sizes,
-                                                        mini_jit::dtype_t     dtype);
+    static mini_jit::error_t lower_einsum_nodes_to_tensor_operations(EinsumNode*           root_node,
+                                                                     std::vector<int64_t>& dimension_sizes,
+                                                                     mini_jit::dtype_t     dtype);
 
     /**
      * @brief Convert the einsum tree to a string representation.
@@ -138,6 +210,13 @@ public:
      * @return A string representation of the einsum tree.
      */
     static std::string to_string(EinsumNode* root_node);
+
+    /**
+     * @brief Convert the einsum tree to JSON, including the optimization report of every operation.
+     * @param root_node The root node of the einsum tree.
+     * @return A JSON object with the expression, report and children of each node.
+     */
+    static std::string to_json(EinsumNode* root_node);
 };
 
 #endif // MINI_JIT_EINSUM_EINSUM_TREE_H
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef MINI_JIT_IR_AUTOTUNER_H
+#define MINI_JIT_IR_AUTOTUNER_H
+
+#include <cstdint>
+#include <mlc/ir/Dimension.h>
+#include <mlc/types.h>
+#include <string>
+#include <vector>
+
+namespace mini_jit
+{
+    namespace ir
+    {
+        class Autotuner;
+    }
+} // namespace mini_jit
+
+/**
+ * @brief The Autotuner class empirically searches for the fastest configuration of a tensor operation.
+ *
+ * Candidates are generated by running the Optimizer for all combinations of thread targets
+ * and kernel size limits, and by permuting the sequential loops of each result. Every
+ * candidate is JIT-ed and timed on dummy data. The fastest configuration can be stored
+ * in a text file and loaded again, so that the search only has to run once per operation.
+ */
+class mini_jit::ir::Autotuner
+{
+public:
+    /// Search space of the autotuner.
+    struct parameters_t
+    {
+        /// thread targets passed to the optimizer, an empty vector uses 1, T and 4T for T OpenMP threads
+        std::vector<int64_t> thread_targets;
+        /// maximum kernel sizes passed to the optimizer
+        std::vector<int64_t> max_kernel_sizes = {32, 64, 128, 256, 512};
+        /// minimum kernel sizes passed to the optimizer
+        std::vector<int64_t> min_kernel_sizes = {1, 16};
+        /// maximum number of sequential loop orders per optimizer result
+        int64_t max_loop_orders = 4;
+        /// minimum measurement time per candidate in seconds
+        double min_time = 0.05;
+    };
+
+    /// A configuration found by the autotuner.
+    struct config_t
+    {
+        /// thread target which produced the configuration
+        int64_t thread_target = 0;
+        /// maximum kernel size which produced the configuration
+        int64_t max_kernel_size = 0;
+        /// minimum kernel size which produced the configuration
+        int64_t min_kernel_size = 0;
+        /// the optimized dimensions
+        std::vector<Dimension> dimensions;
+        /// measured time per execution in seconds
+        double time = 0.0;
+    };
+
+    //! Deleted constructor to prevent instantiation of the static Autotuner class.
+    Autotuner() = delete;
+
+    /**
+     * @brief Generate the candidate configurations for a tensor operation.
+     * Parameter combinations which the optimizer rejects are skipped and duplicates are removed.
+     *
+     * @param dimensions The dimensions of the tensor operation.
+     * @param parameters The search space.
+     * @return The candidate configurations.
+     */
+    static std::vector<config_t> generateCandidates(std::vector<Dimension> const& dimensions,
+                                                    parameters_t const&           parameters);
+
+    /**
+     * @brief JIT a configuration and measure its execution time on dummy data.
+     * A GEMM or BRGEMM main primitive is adjusted to the number of primitive dimensions.
+     *
+     * @param dtype The data type of the tensors.
+     * @param prim_first_touch The first touch primitive.
+     * @param prim_main The main primitive.
+     * @param prim_last_touch The last touch primitive.
+     * @param dimensions The optimized dimensions.
+     * @param min_time The minimum measurement time in seconds.
+     * @return The time per execution in seconds, infinity if the configuration cannot be set up.
+     */
+    static double measure(dtype_t                       dtype,
+                          ptype_t                       prim_first_touch,
+                          ptype_t                       prim_main,
+                          ptype_t                       prim_last_touch,
+                          std::vector<Dimension> const& dimensions,
+                          double                        min_time);
+
+    /**
+     * @brief Find the fastest configuration of a tensor operation using the default search space.
+     *
+     * @param dtype The data type of the tensors.
+     * @param prim_first_touch The first touch primitive.
+     * @param prim_main The main primitive.
+     * @param prim_last_touch The last touch primitive.
+     * @param dimensions The dimensions of the tensor operation.
+     * @return The fastest configuration.
+     */
+    static config_t tune(dtype_t                       dtype,
+                         ptype_t                       prim_first_touch,
+                         ptype_t                       prim_main,
+                         ptype_t                       prim_last_touch,
+                         std::vector<Dimension> const& dimensions);
+
+    /**
+     * @brief Find the fastest configuration of a tensor operation.
+     *
+     * @param dtype The data type of the tensors.
+     * @param prim_first_touch The first touch primitive.
+     * @param prim_main The main primitive.
+     * @param prim_last_touch The last touch primitive.
+     * @param dimensions The dimensions of the tensor operation.
+     * @param parameters The search space.
+     * @return The fastest configuration.
+     */
+    static config_t tune(dtype_t                       dtype,
+                         ptype_t                       prim_first_touch,
+                         ptype_t                       prim_main,
+                         ptype_t                       prim_last_touch,
+                         std::vector<Dimension> const& dimensions,
+                         parameters_t const&           parameters);
+
+    /**
+     * @brief Store a configuration in a text file.
+     *
+     * @param config The configuration to be stored.
+     * @param path Path to the file.
+     */
+    static void save(config_t const&    config,
+                     std::string const& path);
+
+    /**
+     * @brief Load a configuration from a text file written by `save`.
+     *
+     * @param path Path to the file.
+     * @return The loaded configuration.
+     */
+    static config_t load(std::string const& path);
+};
+
+#endif
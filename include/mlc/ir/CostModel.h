@@ -0,0 +1,173 @@
+#ifndef MINI_JIT_IR_COST_MODEL_H
+#define MINI_JIT_IR_COST_MODEL_H
+
+#include <cstdint>
+#include <map>
+#include <mlc/ir/Dimension.h>
+#include <mlc/types.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace mini_jit
+{
+    namespace ir
+    {
+        class CostModel;
+    }
+} // namespace mini_jit
+
+/**
+ * @brief The CostModel class estimates the runtime of an optimized tensor operation.
+ *
+ * The estimate is a roofline over three bounds: the compute time of the primitive
+ * kernels, the time to stream each kernel's working set from the cache level it fits
+ * into, and the time to move the loop order dependent memory traffic. A fixed overhead
+ * per kernel call penalizes configurations with many tiny kernels.
+ *
+ * Kernel throughputs are taken from a measured table when available (see
+ * `loadThroughputTable`) and from an analytic register-blocking model otherwise.
+ * The default hardware parameters describe a single performance core of an Apple M4.
+ */
+class mini_jit::ir::CostModel
+{
+public:
+    /// Hardware parameters used by the model.
+    struct hardware_t
+    {
+        /// size of the L1 data cache of one core in bytes
+        int64_t l1_size = 128 * 1024;
+        /// size of the L2 cache shared by all cores in bytes
+        int64_t l2_size = 16 * 1024 * 1024;
+        /// L1 bandwidth of one core in bytes per second
+        double l1_bandwidth = 200e9;
+        /// L2 bandwidth of one core in bytes per second
+        double l2_bandwidth = 100e9;
+        /// main memory bandwidth shared by all cores in bytes per second
+        double memory_bandwidth = 100e9;
+        /// peak FP32 performance of one core in GFLOPS
+        double peak_gflops = 110.0;
+        /// fixed cost of calling a kernel in seconds
+        double call_overhead = 5e-9;
+        /// size of a tensor element in bytes
+        int64_t element_size = 4;
+    };
+
+private:
+    /// key of the throughput table: m, n, k and batch-reduce size
+    using kernel_key_t = std::tuple<int64_t, int64_t, int64_t, int64_t>;
+
+    //! hardware parameters
+    hardware_t m_hardware;
+    //! measured kernel throughputs in GFLOPS
+    std::map<kernel_key_t, double> m_throughput_table;
+
+    /**
+     * @brief Returns the measured throughput of the closest kernel in the table.
+     * Distances are measured on a logarithmic scale in every dimension.
+     *
+     * @param m Size of the M dimension.
+     * @param n Size of the N dimension.
+     * @param k Size of the K dimension.
+     * @param br_size Size of the batch-reduce dimension.
+     * @return The throughput in GFLOPS.
+     */
+    double lookupThroughput(int64_t m,
+                            int64_t n,
+                            int64_t k,
+                            int64_t br_size) const;
+
+public:
+    /**
+     * @brief Creates a cost model with the default hardware parameters.
+     */
+    CostModel() = default;
+
+    /**
+     * @brief Creates a cost model with the given hardware parameters.
+     *
+     * @param hardware The hardware parameters.
+     */
+    explicit CostModel(hardware_t const& hardware);
+
+    /**
+     * @brief Loads kernel throughputs from a CSV file as written by the GEMM and BRGEMM benchmarks.
+     * The columns m, n, k and gflops are required, br_size defaults to 1 if it is missing.
+     * Entries of previously loaded tables are kept unless they are measured again.
+     *
+     * @param path Path to the CSV file.
+     * @return The number of loaded entries.
+     */
+    int64_t loadThroughputTable(std::string const& path);
+
+    /**
+     * @brief Adds a single measured kernel throughput.
+     *
+     * @param m Size of the M dimension.
+     * @param n Size of the N dimension.
+     * @param k Size of the K dimension.
+     * @param br_size Size of the batch-reduce dimension.
+     * @param gflops The measured throughput in GFLOPS.
+     */
+    void setThroughput(int64_t m,
+                       int64_t n,
+                       int64_t k,
+                       int64_t br_size,
+                       double  gflops);
+
+    /**
+     * @brief Estimates the throughput of a (BR)GEMM kernel.
+     *
+     * @param m Size of the M dimension.
+     * @param n Size of the N dimension.
+     * @param k Size of the K dimension.
+     * @param br_size Size of the batch-reduce dimension.
+     * @return The throughput in GFLOPS.
+     */
+    double getKernelThroughput(int64_t m,
+                               int64_t n,
+                               int64_t k,
+                               int64_t br_size) const;
+
+    /**
+     * @brief Estimates the number of bytes transferred between main memory and the L2 cache.
+     *
+     * The loops are visited from the innermost to the outermost one. A tensor is loaded again
+     * in every iteration of a loop which indexes it. A tensor not indexed by a loop is only
+     * reused across the iterations of the loop if all data touched by one iteration fits into
+     * the L2 cache. The estimate therefore depends on the order of the non-primitive loops.
+     *
+     * @param dimensions The dimensions of the operation with the primitive dimensions set.
+     * @return The estimated memory traffic in bytes.
+     */
+    double estimateTraffic(std::vector<Dimension> const& dimensions) const;
+
+    /**
+     * @brief Estimates the runtime of a tensor operation whose primitive and shared
+     * dimensions are already set.
+     *
+     * @param dimensions The optimized dimensions of the operation.
+     * @param thread_target The number of threads executing the shared loops.
+     * @return The estimated runtime in seconds.
+     */
+    double estimate(std::vector<Dimension> const& dimensions,
+                    int64_t                       thread_target) const;
+
+    /**
+     * @brief Get the hardware parameters.
+     */
+    hardware_t const& getHardware() const
+    {
+        return m_hardware;
+    }
+
+    /**
+     * @brief Get the number of entries in the throughput table.
+     */
+    int64_t getThroughputTableSize() const
+    {
+        return static_cast<int64_t>(m_throughput_table.size());
+    }
+};
+
+#endif
@@ -28,6 +28,8 @@ namespace mini_jit
             int64_t stride_in1 = 0;
             //! Stride in the output tensor
             int64_t stride_out = 0;
+            //! Size of the primitive block in the last iteration of a sequential or shared M or N loop (0 if all blocks are full)
+            int64_t remainder = 0;
 
             /**
              * @brief Construct a new Dimension object.
@@ -38,24 +40,31 @@ namespace mini_jit
              * @param stride_in0 Stride in the first input tensor.
              * @param stride_in1 Stride in the second input tensor.
              * @param stride_out Stride in the output tensor.
+             * @param remainder Size of the primitive block in the last iteration (0 if all blocks are full).
              */
             Dimension(dim_t   type,
                       exec_t  exec_type,
                       int64_t size,
                       int64_t stride_in0,
                       int64_t stride_in1,
-                      int64_t stride_out)
+                      int64_t stride_out,
+                      int64_t remainder = 0)
                 : type(type),
                   exec_type(exec_type),
                   size(size),
                   stride_in0(stride_in0),
                   stride_in1(stride_in1),
-                  stride_out(stride_out)
+                  stride_out(stride_out),
+                  remainder(remainder)
             {
                 if (size <= 0)
                 {
                     throw std::invalid_argument("Dimension size needs to be greater than 0");
                 }
+                if (remainder < 0)
+                {
+                    throw std::invalid_argument("Dimension remainder needs to be greater than or equal to 0");
+                }
             }
         };
     } // namespace ir
@@ -45,8 +45,30 @@ public:
                                           std::span<const int64_t> i_strides_out,
                                           std::vector<Dimension>&  o_dimensions);
 
+    /**
+     * @brief Convert configuration parameters including the remainders of peeled loops to a vector of Dimension objects.
+     *
+     * @param i_dim_types A span of dimension types (M, N, K).
+     * @param i_exec_types A span of execution types (Prim, Seq, Shared).
+     * @param i_dim_sizes A span of dimension sizes.
+     * @param i_strides_in0 A span of strides for the first input tensor.
+     * @param i_strides_in1 A span of strides for the second input tensor.
+     * @param i_strides_out A span of strides for the output tensor.
+     * @param i_dim_remainders A span of remainders, may be empty if no loop is peeled.
+     * @param o_dimensions A vector to store the converted Dimension objects.
+     */
+    static void convertConfigToDimensions(std::span<const dim_t>   i_dim_types,
+                                          std::span<const exec_t>  i_exec_types,
+                                          std::span<const int64_t> i_dim_sizes,
+                                          std::span<const int64_t> i_strides_in0,
+                                          std::span<const int64_t> i_strides_in1,
+                                          std::span<const int64_t> i_strides_out,
+                                          std::span<const int64_t> i_dim_remainders,
+                                          std::vector<Dimension>&  o_dimensions);
+
     /**
      * @brief Convert a vector of Dimension objects to configuration parameters.
+     * Throws std::invalid_argument if a dimension has a remainder, which cannot be represented.
      *
      * @param i_dimensions A vector of Dimension objects to be converted.
      * @param o_dim_types A vector to store the dimension types.
@@ -63,6 +85,27 @@ public:
                                           std::vector<int64_t>&         o_strides_in0,
                                           std::vector<int64_t>&         o_strides_in1,
                                           std::vector<int64_t>&         o_strides_out);
+
+    /**
+     * @brief Convert a vector of Dimension objects to configuration parameters including the remainders of peeled loops.
+     *
+     * @param i_dimensions A vector of Dimension objects to be converted.
+     * @param o_dim_types A vector to store the dimension types.
+     * @param o_exec_types A vector to store the execution types.
+     * @param o_dim_sizes A vector to store the dimension sizes.
+     * @param o_strides_in0 A vector to store the strides for the first input tensor.
+     * @param o_strides_in1 A vector to store the strides for the second input tensor.
+     * @param o_strides_out A vector to store the strides for the output tensor.
+     * @param o_dim_remainders A vector to store the remainders.
+     */
+    static void convertDimensionsToConfig(const std::vector<Dimension>& i_dimensions,
+                                          std::vector<dim_t>&           o_dim_types,
+                                          std::vector<exec_t>&          o_exec_types,
+                                          std::vector<int64_t>&         o_dim_sizes,
+                                          std::vector<int64_t>&         o_strides_in0,
+                                          std::vector<int64_t>&         o_strides_in1,
+                                          std::vector<int64_t>&         o_strides_out,
+                                          std::vector<int64_t>&         o_dim_remainders);
 };
 
 #endif
\ No newline at end of file
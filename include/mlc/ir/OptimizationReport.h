@@ -0,0 +1,179 @@
+#ifndef MINI_JIT_IR_OPTIMIZATION_REPORT_H
+#define MINI_JIT_IR_OPTIMIZATION_REPORT_H
+
+#include <cstdint>
+#include <mlc/ir/CostModel.h>
+#include <mlc/ir/Dimension.h>
+#include <string>
+#include <vector>
+
+namespace mini_jit
+{
+    namespace ir
+    {
+        class OptimizationReport;
+    }
+} // namespace mini_jit
+
+/**
+ * @brief The OptimizationReport class records the decisions of the Optimizer for one tensor operation.
+ *
+ * Besides the dimensions before and after the optimization, the report lists every
+ * transformation in the order it was applied and the metrics of the chosen configuration
+ * as estimated by the cost model. The report can be serialized to JSON to diagnose slow
+ * operations without stepping through the optimizer.
+ */
+class mini_jit::ir::OptimizationReport
+{
+public:
+    /// A single decision of the optimizer.
+    struct decision_t
+    {
+        /// optimization stage, e.g. fuse, split, peel, shared, reorder or tile
+        std::string stage;
+        /// human readable description of the decision
+        std::string description;
+    };
+
+private:
+    //! dimensions passed to the optimizer
+    std::vector<Dimension> m_input;
+    //! optimized dimensions
+    std::vector<Dimension> m_output;
+    //! decisions in the order they were made
+    std::vector<decision_t> m_decisions;
+    //! thread target used for the optimization
+    int64_t m_thread_target = 0;
+    //! primitive sizes M, N, K and BR of the chosen configuration
+    int64_t m_prim_sizes[4] = {1, 1, 1, 1};
+    //! floating point operations of the operation
+    double m_flops = 0.0;
+    //! estimated bytes transferred from main memory
+    double m_bytes = 0.0;
+    //! number of tasks of the shared loops
+    int64_t m_num_tasks = 1;
+    //! estimated runtime in seconds
+    double m_estimated_time = 0.0;
+
+public:
+    /**
+     * @brief Remove all recorded data.
+     */
+    void clear();
+
+    /**
+     * @brief Store the dimensions passed to the optimizer.
+     *
+     * @param dimensions The unoptimized dimensions.
+     */
+    void set_input(std::vector<Dimension> const& dimensions);
+
+    /**
+     * @brief Record a decision of the optimizer.
+     *
+     * @param stage The optimization stage.
+     * @param description Human readable description of the decision.
+     */
+    void add_decision(std::string const& stage,
+                      std::string const& description);
+
+    /**
+     * @brief Store the chosen configuration and compute its metrics.
+     *
+     * @param dimensions The optimized dimensions.
+     * @param thread_target The number of threads executing the shared loops.
+     * @param cost_model The cost model which scored the configuration.
+     * @param estimated_time The estimated runtime in seconds.
+     */
+    void set_result(std::vector<Dimension> const& dimensions,
+                    int64_t                       thread_target,
+                    CostModel const&              cost_model,
+                    double                        estimated_time);
+
+    /**
+     * @brief Get the dimensions passed to the optimizer.
+     */
+    std::vector<Dimension> const& get_input() const
+    {
+        return m_input;
+    }
+
+    /**
+     * @brief Get the optimized dimensions.
+     */
+    std::vector<Dimension> const& get_output() const
+    {
+        return m_output;
+    }
+
+    /**
+     * @brief Get the recorded decisions.
+     */
+    std::vector<decision_t> const& get_decisions() const
+    {
+        return m_decisions;
+    }
+
+    /**
+     * @brief Get the floating point operations of the operation.
+     * Contractions count a multiplication and an addition per iteration, other operations one operation per element.
+     */
+    double get_flops() const
+    {
+        return m_flops;
+    }
+
+    /**
+     * @brief Get the estimated number of bytes transferred from main memory.
+     */
+    double get_bytes() const
+    {
+        return m_bytes;
+    }
+
+    /**
+     * @brief Get the arithmetic intensity in FLOPs per byte.
+     */
+    double get_arithmetic_intensity() const
+    {
+        return m_bytes > 0.0 ? m_flops / m_bytes : 0.0;
+    }
+
+    /**
+     * @brief Get the number of tasks of the shared loops.
+     */
+    int64_t get_num_tasks() const
+    {
+        return m_num_tasks;
+    }
+
+    /**
+     * @brief Get the fraction of the thread time spent on tasks with a static schedule.
+     */
+    double get_parallel_efficiency() const;
+
+    /**
+     * @brief Get the estimated runtime in seconds.
+     */
+    double get_estimated_time() const
+    {
+        return m_estimated_time;
+    }
+
+    /**
+     * @brief Get whether the report contains an optimization result.
+     */
+    bool is_empty() const
+    {
+        return m_output.empty();
+    }
+
+    /**
+     * @brief Serialize the report to JSON.
+     *
+     * @return The report as a JSON object.
+     */
+    std::string to_json() const;
+};
+
+#endif
@@ -2,9 +2,13 @@
 #define MINI_JIT_IR_OPTIMIZER_H
 
 #include <cstdint>
+#include <mlc/ir/CostModel.h>
 #include <mlc/ir/Dimension.h>
+#include <mlc/ir/OptimizationReport.h>
 #include <mlc/types.h>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace mini_jit
 {
@@ -28,20 +32,44 @@ public:
     Optimizer() = delete;
 
     /**
-     * @brief Optimize the dimensions of a tensor operation.
+     * @brief Optimize the dimensions of a tensor operation using the default cost model.
      *
      * @param dimensions A vector of dimensions to be optimized.
      * @param thread_target The target number of threads for optimization.
      * @param max_kernel_size The maximum size of a kernel dimension
      * @param min_kernel_size The minimum size of a kernel dimension
+     * @return The estimated runtime of the chosen configuration in seconds.
+     */
+    static double optimize(std::vector<Dimension>& dimensions,
+                           int64_t                 thread_target,
+                           int64_t                 max_kernel_size,
+                           int64_t                 min_kernel_size);
+
+    /**
+     * @brief Optimize the dimensions of a tensor operation.
+     * All combinations of dimension splits are scored with the cost model
+     * and the configuration with the lowest estimated runtime is chosen.
+     * Primitive M and N dimensions which cannot be split evenly are peeled,
+     * so that the resulting loops may have a remainder (see `peelDimensions`).
+     *
+     * @param dimensions A vector of dimensions to be optimized.
+     * @param thread_target The target number of threads, values <= 0 use the number of OpenMP threads.
+     * @param max_kernel_size The maximum size of a kernel dimension
+     * @param min_kernel_size The minimum size of a kernel dimension
+     * @param cost_model The cost model used to score the configurations.
+     * @param report Optional report which receives the decisions of the optimizer.
+     * @return The estimated runtime of the chosen configuration in seconds.
      */
-    static void optimize(std::vector<Dimension>& dimensions,
-                         int64_t                 thread_target,
-                         int64_t                 max_kernel_size,
-                         int64_t                 min_kernel_size);
+    static double optimize(std::vector<Dimension>& dimensions,
+                           int64_t                 thread_target,
+                           int64_t                 max_kernel_size,
+                           int64_t                 min_kernel_size,
+                           CostModel const&        cost_model,
+                           OptimizationReport*     report = nullptr);
 
     /**
      * @brief Optimize the dimensions of a tensor operation.
+     * Dimensions are not peeled, since the configuration cannot represent remainders.
      *
      * @param dim_types A vector of dimension types (M, N, K).
      * @param exec_types A vector of execution types (Prim, Seq, Shared).
@@ -52,16 +80,49 @@ public:
      * @param thread_target The target number of threads for optimization.
      * @param max_kernel_size The maximum size of a kernel dimension
      * @param min_kernel_size The minimum size of a kernel dimension
+     * @param cost_model The cost model used to score the configurations.
+     * @return The estimated runtime of the chosen configuration in seconds.
      */
-    static void optimize(std::vector<dim_t>&   dim_types,
-                         std::vector<exec_t>&  exec_types,
-                         std::vector<int64_t>& dim_sizes,
-                         std::vector<int64_t>& strides_in0,
-                         std::vector<int64_t>& strides_in1,
-                         std::vector<int64_t>& strides_out,
-                         int64_t               thread_target,
-                         int64_t               max_kernel_size,
-                         int64_t               min_kernel_size);
+    static double optimize(std::vector<dim_t>&   dim_types,
+                           std::vector<exec_t>&  exec_types,
+                           std::vector<int64_t>& dim_sizes,
+                           std::vector<int64_t>& strides_in0,
+                           std::vector<int64_t>& strides_in1,
+                           std::vector<int64_t>& strides_out,
+                           int64_t               thread_target,
+                           int64_t               max_kernel_size,
+                           int64_t               min_kernel_size,
+                           CostModel const&      cost_model = CostModel());
+
+    /**
+     * @brief Optimize the dimensions of a tensor operation, allowing peeled loops with remainders.
+     *
+     * @param dim_types A vector of dimension types (M, N, K).
+     * @param exec_types A vector of execution types (Prim, Seq, Shared).
+     * @param dim_sizes A vector of dimension sizes.
+     * @param strides_in0 A vector of strides for the first input tensor.
+     * @param strides_in1 A vector of strides for the second input tensor.
+     * @param strides_out A vector of strides for the output tensor.
+     * @param dim_remainders A vector to store the remainders of the optimized loops.
+     * @param thread_target The target number of threads for optimization.
+     * @param max_kernel_size The maximum size of a kernel dimension
+     * @param min_kernel_size The minimum size of a kernel dimension
+     * @param cost_model The cost model used to score the configurations.
+     * @param report Optional report which receives the decisions of the optimizer.
+     * @return The estimated runtime of the chosen configuration in seconds.
+     */
+    static double optimize(std::vector<dim_t>&   dim_types,
+                           std::vector<exec_t>&  exec_types,
+                           std::vector<int64_t>& dim_sizes,
+                           std::vector<int64_t>& strides_in0,
+                           std::vector<int64_t>& strides_in1,
+                           std::vector<int64_t>& strides_out,
+                           std::vector<int64_t>& dim_remainders,
+                           int64_t               thread_target,
+                           int64_t               max_kernel_size,
+                           int64_t               min_kernel_size,
+                           CostModel const&      cost_model = CostModel(),
+                           OptimizationReport*   report     = nullptr);
 
     /**
      * @brief Identify primitive dimensions in the tensor operation and adjust their order.
@@ -81,8 +142,23 @@ public:
                                 int64_t                 max_kernel_size,
                                 int64_t                 min_kernel_size);
 
+    /**
+     * @brief Peel primitive M and N dimensions which exceed the maximum kernel size.
+     * A peeled dimension becomes a primitive block of a register friendly size and a
+     * sequential loop over the blocks whose last iteration covers the remaining elements.
+     * The remainder is stored in the loop dimension and handled by separate kernels.
+     *
+     * @param dimensions A vector of dimensions with identified primitive dimensions.
+     * @param max_kernel_size The maximum size allowed for a kernel dimension.
+     */
+    static void peelDimensions(std::vector<Dimension>& dimensions,
+                               int64_t                 max_kernel_size);
+
     /**
      * @brief Fuse small dimensions into larger dimensions.
+     * Two dimensions of the same type are fused if one of them is smaller than the minimum kernel size
+     * and they are contiguous in all tensors. A SEQ dimension may be fused into a SHARED or PRIM one.
+     * Fusion is repeated until no more dimensions can be fused.
      *
      * @param dimensions A vector of dimensions to be processed.
      * @param min_kernel_size The minimum size for a kernel dimension to be considered for fusion.
@@ -93,15 +169,157 @@ public:
     /**
      * @brief Turn sequential dimensions into shared dimensions.
      *
+     * All combinations of sharing a sequential non-K dimension completely, sharing the outer
+     * part of a split of it, or keeping it sequential are evaluated. The combination with the
+     * highest parallel efficiency is chosen, ties are resolved in favor of fewer tasks. The
+     * number of tasks may exceed the number of threads by at most MAX_OVERSUBSCRIPTION.
+     *
      * @param dimensions A vector of dimensions to be processed.
-     * @param thread_target The target number of threads for optimization.
+     * @param thread_target The target number of threads, values <= 0 use the number of OpenMP threads.
      */
     static void createSharedLoops(std::vector<Dimension>& dimensions,
                                   int64_t                 thread_target);
 
+    /**
+     * @brief Computes the fraction of the thread time which is spent on tasks
+     * if the given number of equally sized tasks is distributed statically.
+     *
+     * @param num_tasks The number of tasks.
+     * @param num_threads The number of threads.
+     * @return The parallel efficiency in (0, 1].
+     */
+    static double getParallelEfficiency(int64_t num_tasks,
+                                        int64_t num_threads);
+
+    /**
+     * @brief Reorder the sequential loops to minimize the memory traffic estimated by the cost model.
+     * Shared and primitive dimensions keep their positions. If several orders result in the
+     * same traffic, the original order is kept.
+     *
+     * @param dimensions A vector of dimensions to be processed.
+     * @param cost_model The cost model used to estimate the memory traffic.
+     */
+    static void reorderDimensions(std::vector<Dimension>& dimensions,
+                                  CostModel const&        cost_model);
+
+    /**
+     * @brief Tile the sequential loops of a contraction for the L1 and L2 cache.
+     *
+     * The innermost sequential K and N loops are split into an outer and an inner part. The
+     * inner K part is sized so that the panel of the first input used by one kernel row fits
+     * into half of the L1 cache, the inner N part so that the panel of the second input fits
+     * into half of the L2 cache. The loops are ordered N outer, K outer, M, N inner, K inner,
+     * so that the second input's panel is reused across the M loop and the first input's panel
+     * across the inner N loop. Operations without sequential K and N loops are not modified.
+     *
+     * @param dimensions A vector of dimensions with primitive and shared dimensions set.
+     * @param cost_model The cost model providing the cache sizes.
+     */
+    static void tileDimensions(std::vector<Dimension>& dimensions,
+                               CostModel const&        cost_model);
+
 private:
+    //! Maximum number of sequential loops whose orders are searched exhaustively.
+    static constexpr int64_t MAX_REORDER_LOOPS = 6;
+    //! Maximum number of split sizes considered per dimension.
+    static constexpr int64_t MAX_SPLIT_CANDIDATES = 4;
+    //! Maximum number of configurations scored by the cost model.
+    static constexpr int64_t MAX_CONFIGURATIONS = 256;
+    //! Maximum ratio of shared loop iterations to threads.
+    static constexpr int64_t MAX_OVERSUBSCRIPTION = 4;
+
     // Helper functions
 
+    /**
+     * @brief Optimize the dimensions of a tensor operation.
+     *
+     * @param dimensions A vector of dimensions to be optimized.
+     * @param thread_target The target number of threads, values <= 0 use the number of OpenMP threads.
+     * @param max_kernel_size The maximum size of a kernel dimension
+     * @param min_kernel_size The minimum size of a kernel dimension
+     * @param cost_model The cost model used to score the configurations.
+     * @param peel Whether primitive dimensions may be peeled.
+     * @param report Optional report which receives the decisions of the optimizer.
+     * @return The estimated runtime of the chosen configuration in seconds.
+     */
+    static double optimizeDimensions(std::vector<Dimension>& dimensions,
+                                     int64_t                 thread_target,
+                                     int64_t                 max_kernel_size,
+                                     int64_t                 min_kernel_size,
+                                     CostModel const&        cost_model,
+                                     bool                    peel,
+                                     OptimizationReport*     report);
+
+    /**
+     * @brief Describe how the dimensions of each type were decomposed into loops and primitives.
+     *
+     * @param i_input The dimensions passed to the optimizer.
+     * @param i_output The optimized dimensions.
+     * @param o_report The report which receives one decision per dimension type.
+     */
+    static void reportDecomposition(std::vector<Dimension> const& i_input,
+                                    std::vector<Dimension> const& i_output,
+                                    OptimizationReport&           o_report);
+
+    /**
+     * @brief Identify the primitive dimensions and create the shared loops.
+     *
+     * @param dimensions A vector of dimensions to be processed.
+     * @param thread_target The target number of threads for optimization.
+     * @param max_kernel_size The maximum size of a kernel dimension, primitive dimensions exceeding it are peeled if > 0.
+     */
+    static void assignExecutionTypes(std::vector<Dimension>& dimensions,
+                                     int64_t                 thread_target,
+                                     int64_t                 max_kernel_size);
+
+    /**
+     * @brief Find the valid splits for a given dimension size, largest kernel sizes first.
+     * At most MAX_SPLIT_CANDIDATES splits are returned.
+     *
+     * @param i_size The size of the dimension to be split.
+     * @param i_max_kernel_size The maximum size allowed for the dimension.
+     * @param i_min_kernel_size The minimum size allowed for the dimension.
+     * @return Pairs of the sizes of the SEQ and the PRIM part of the split.
+     */
+    static std::vector<std::pair<int64_t, int64_t>> findSplitCandidates(int64_t i_size,
+                                                                        int64_t i_max_kernel_size,
+                                                                        int64_t i_min_kernel_size);
+
+    /**
+     * @brief Recursively enumerate all combinations of split candidates for the
+     * dimensions starting at the given index.
+     *
+     * @param i_dimensions The dimensions split so far.
+     * @param i_index The index of the next dimension to be checked.
+     * @param i_max_kernel_size The maximum size allowed for a kernel dimension.
+     * @param i_min_kernel_size The minimum size allowed for a kernel dimension.
+     * @param o_configurations The vector the enumerated configurations are appended to.
+     */
+    static void enumerateSplits(std::vector<Dimension> const&        i_dimensions,
+                                size_t                               i_index,
+                                int64_t                              i_max_kernel_size,
+                                int64_t                              i_min_kernel_size,
+                                std::vector<std::vector<Dimension>>& o_configurations);
+
+    /**
+     * @brief Recursively search the combination of shared loop sizes with the highest parallel efficiency.
+     *
+     * @param i_options The allowed shared sizes per candidate dimension, 1 keeps the dimension sequential.
+     * @param i_index The index of the next candidate dimension.
+     * @param i_num_tasks The number of tasks of the shared loops chosen so far.
+     * @param i_num_threads The number of threads.
+     * @param io_choice The shared sizes chosen so far.
+     * @param o_best_choice The best combination found so far.
+     * @param o_best_tasks The number of tasks of the best combination.
+     */
+    static void searchSharedLoops(std::vector<std::vector<int64_t>> const& i_options,
+                                  size_t                                   i_index,
+                                  int64_t                                  i_num_tasks,
+                                  int64_t                                  i_num_threads,
+                                  std::vector<int64_t>&                    io_choice,
+                                  std::vector<int64_t>&                    o_best_choice,
+                                  int64_t&                                 o_best_tasks);
+
     /**
      * @brief Find the best split for a given dimension size and type.
      *
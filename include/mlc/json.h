@@ -0,0 +1,62 @@
+#ifndef MINI_JIT_JSON_H
+#define MINI_JIT_JSON_H
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace mini_jit
+{
+    /**
+     * Escape a string for a JSON string literal.
+     * Quotes, backslashes and control characters are escaped.
+     *
+     * @param text The unescaped string.
+     * @return The escaped string without the enclosing quotes.
+     */
+    inline std::string escape_json(std::string_view text)
+    {
+        std::string l_escaped;
+        l_escaped.reserve(text.size());
+        for (char l_char : text)
+        {
+            switch (l_char)
+            {
+            case '"':
+                l_escaped += "\\\"";
+                break;
+            case '\\':
+                l_escaped += "\\\\";
+                break;
+            case '\b':
+                l_escaped += "\\b";
+                break;
+            case '\f':
+                l_escaped += "\\f";
+                break;
+            case '\n':
+                l_escaped += "\\n";
+                break;
+            case '\r':
+                l_escaped += "\\r";
+                break;
+            case '\t':
+                l_escaped += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(l_char) < 0x20)
+                {
+                    char l_code[7];
+                    std::snprintf(l_code, sizeof(l_code), "\\u%04x", static_cast<unsigned char>(l_char));
+                    l_escaped += l_code;
+                }
+                else
+                {
+                    l_escaped += l_char;
+                }
+            }
+        }
+        return l_escaped;
+    }
+} // namespace mini_jit
+#endif // MINI_JIT_JSON_H
@@ -36,6 +36,7 @@ mini_jit::error_t mini_jit::Binary::generate(uint32_t m,
     }
 
     reset_kernel();
+    m_kernel->set_name(to_string(ptype) + (trans_c ? "_trans" : "") + "_m" + std::to_string(m) + "_n" + std::to_string(n));
 
     switch (ptype)
     {
@@ -118,6 +119,11 @@ mini_jit::Binary::kernel_t mini_jit::Binary::get_kernel() const
     return reinterpret_cast<kernel_t>(const_cast<void*>(m_kernel->get_kernel()));
 }
 
+std::size_t mini_jit::Binary::get_code_size() const
+{
+    return m_kernel ? m_kernel->get_size() : 0;
+}
+
 void mini_jit::Binary::reset_kernel()
 {
     if (m_kernel)
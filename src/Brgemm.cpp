@@ -72,6 +72,11 @@ mini_jit::error_t mini_jit::Brgemm::generate(uint32_t m,
     else
     {
         reset_kernel();
+        m_kernel->set_name((br_size == 1 ? "gemm" : "brgemm") +
+                           std::string("_m") + std::to_string(m) +
+                           "_n" + std::to_string(n) +
+                           "_k" + std::to_string(k) +
+                           (br_size == 1 ? "" : "_br" + std::to_string(br_size)));
 
         if (br_size == 1)
         {
@@ -92,6 +97,11 @@ mini_jit::Brgemm::kernel_t mini_jit::Brgemm::get_kernel() const
     return reinterpret_cast<kernel_t>(const_cast<void*>(m_kernel->get_kernel()));
 }
 
+std::size_t mini_jit::Brgemm::get_code_size() const
+{
+    return m_kernel ? m_kernel->get_size() : 0;
+}
+
 void mini_jit::Brgemm::reset_kernel()
 {
     if (m_kernel)
@@ -2,6 +2,7 @@
 #include <cstring>
 #include <fstream>
 #include <mlc/Kernel.h>
+#include <mlc/PerfMap.h>
 #include <stdexcept>
 #include <string>
 #include <sys/mman.h>
@@ -16,43 +17,103 @@ mini_jit::Kernel::~Kernel() noexcept
 void mini_jit::Kernel::add_instr(uint32_t ins)
 {
     m_buffer.push_back(ins);
+}
+
+void mini_jit::Kernel::add_instr(std::vector<uint32_t> const& ins)
+{
+    m_buffer.insert(m_buffer.end(), ins.begin(), ins.end());
+}
+
+mini_jit::Kernel::label_t mini_jit::Kernel::new_label()
+{
+    m_labels.emplace_back();
+    return static_cast<label_t>(m_labels.size() - 1);
+}
 
-    // update labels
-    for (auto& label : m_labels)
+void mini_jit::Kernel::bind(label_t label)
+{
+    if (label >= m_labels.size())
+    {
+        throw std::invalid_argument("Unknown label: " + std::to_string(label));
+    }
+    label_info_t& l_label = m_labels[label];
+    if (l_label.position != -1)
     {
-        label.second += 1;
+        throw std::invalid_argument("Label already bound: " + std::to_string(label));
     }
+
+    // labels store their position, so adding instructions does not touch them
+    l_label.position = static_cast<int64_t>(m_buffer.size());
+    for (std::size_t l_fixup : l_label.fixups)
+    {
+        patch_branch(l_fixup, m_buffer.size());
+    }
+    m_num_unresolved -= l_label.fixups.size();
+    l_label.fixups.clear();
 }
 
-void mini_jit::Kernel::add_instr(std::vector<uint32_t> ins)
+mini_jit::Kernel::label_t mini_jit::Kernel::add_label()
 {
-    m_buffer.reserve(m_buffer.size() + ins.size());
-    m_buffer.insert(m_buffer.end(), ins.begin(), ins.end());
+    label_t l_label = new_label();
+    bind(l_label);
+    return l_label;
+}
+
+void mini_jit::Kernel::add_branch(uint32_t ins,
+                                  label_t  label)
+{
+    if (label >= m_labels.size())
+    {
+        throw std::invalid_argument("Unknown label: " + std::to_string(label));
+    }
+
+    // forward branches are patched when their label is bound, the offset 0 only checks the instruction
+    label_info_t& l_label    = m_labels[label];
+    std::size_t   l_position = m_buffer.size();
+    std::size_t   l_target   = l_label.position != -1 ? static_cast<std::size_t>(l_label.position) : l_position;
 
-    // update labels
-    for (auto& label : m_labels)
+    m_buffer.push_back(ins);
+    try
     {
-        label.second += ins.size();
+        patch_branch(l_position, l_target);
     }
+    catch (std::invalid_argument const&)
+    {
+        m_buffer.pop_back();
+        throw;
+    }
+
+    if (l_label.position == -1)
+    {
+        l_label.fixups.push_back(l_position);
+        m_num_unresolved++;
+    }
+}
+
+void mini_jit::Kernel::patch_branch(std::size_t position,
+                                    std::size_t target)
+{
+    m_buffer[position] = Peephole::set_branch_offset(m_buffer[position],
+                                                     static_cast<int64_t>(target) - static_cast<int64_t>(position));
 }
 
 void mini_jit::Kernel::add_label(std::string const& label)
 {
-    if (m_labels.find(label) != m_labels.end())
+    if (m_label_names.find(label) != m_label_names.end())
     {
         throw std::runtime_error("Label already exists: " + label);
     }
-    m_labels[label] = 0;
+    m_label_names[label] = add_label();
 }
 
 int mini_jit::Kernel::getInstrCountFromLabel(std::string const& label) const
 {
-    auto it = m_labels.find(label);
-    if (it == m_labels.end())
+    auto it = m_label_names.find(label);
+    if (it == m_label_names.end())
     {
         throw std::runtime_error("Label not found: " + label);
     }
-    return it->second;
+    return static_cast<int>(m_buffer.size() - m_labels[it->second].position);
 }
 
 std::size_t mini_jit::Kernel::get_size() const
@@ -102,10 +163,57 @@ void mini_jit::Kernel::set_exec(std::size_t num_bytes,
     }
 }
 
+void mini_jit::Kernel::set_name(std::string const& name)
+{
+    m_name = name;
+}
+
+std::string const& mini_jit::Kernel::get_name() const
+{
+    return m_name;
+}
+
+void mini_jit::Kernel::set_optimize(bool optimize)
+{
+    m_optimize = optimize;
+}
+
+mini_jit::Peephole::stats_t const& mini_jit::Kernel::get_peephole_stats() const
+{
+    return m_peephole_stats;
+}
+
+void mini_jit::Kernel::optimize()
+{
+    std::vector<std::size_t> l_positions;
+    m_peephole_stats = Peephole::optimize(m_buffer,
+                                          &l_positions);
+
+    // labels keep pointing to the same instructions
+    for (label_info_t& l_label : m_labels)
+    {
+        if (l_label.position != -1)
+        {
+            l_label.position = static_cast<int64_t>(l_positions[l_label.position]);
+        }
+    }
+}
+
 void mini_jit::Kernel::set_kernel()
 {
     release_memory();
 
+    if (m_num_unresolved > 0)
+    {
+        throw std::runtime_error("Failed to set kernel: " + std::to_string(m_num_unresolved) + " branches target labels which are not bound");
+    }
+
+    m_peephole_stats = Peephole::stats_t();
+    if (m_optimize)
+    {
+        optimize();
+    }
+
     if (m_buffer.empty())
     {
         return;
@@ -136,6 +244,15 @@ void mini_jit::Kernel::set_kernel()
     // set executable
     set_exec(m_size_alloc,
              m_kernel);
+
+    // name the anonymous mapping for perf and other profilers
+    PerfMap& l_perf_map = PerfMap::instance();
+    if (l_perf_map.enabled())
+    {
+        l_perf_map.add(m_kernel,
+                       m_size_alloc,
+                       m_name);
+    }
 }
 
 void const* mini_jit::Kernel::get_kernel() const
@@ -0,0 +1,875 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mlc/Peephole.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    using Peephole     = mini_jit::Peephole;
+    using reg_class_t  = Peephole::reg_class_t;
+    using instr_kind_t = Peephole::instr_kind_t;
+    using instr_t      = Peephole::instr_t;
+
+    //! id of SP in the register masks
+    constexpr uint32_t SP = 31;
+    //! highest general purpose register which the pass may rename or remove writes of, x29 is the frame pointer
+    constexpr uint32_t MAX_FREE_GPR = 28;
+
+    //! access of a register field
+    enum access_t : uint8_t
+    {
+        none = 0,
+        r    = 1,
+        w    = 2,
+        rw   = 3
+    };
+
+    //! register field of an instruction
+    struct field_t
+    {
+        access_t    access    = none;
+        reg_class_t reg_class = reg_class_t::gpr;
+    };
+
+    constexpr field_t NO   = {none, reg_class_t::gpr};
+    constexpr field_t X_R  = {r, reg_class_t::gpr};
+    constexpr field_t X_W  = {w, reg_class_t::gpr};
+    constexpr field_t X_RW = {rw, reg_class_t::gpr};
+    constexpr field_t V_R  = {r, reg_class_t::simd};
+    constexpr field_t V_W  = {w, reg_class_t::simd};
+    constexpr field_t V_RW = {rw, reg_class_t::simd};
+
+    /**
+     * Encoding of an arithmetic instruction with the register fields Rd (bit 0), Rn (bit 5), Rm (bit 16) and Ra (bit 10).
+     * The register fields and the size or arrangement bits are cleared by the mask.
+     */
+    struct encoding_t
+    {
+        uint32_t mask;
+        uint32_t value;
+        field_t  rd;
+        field_t  rn;
+        field_t  rm;
+        field_t  ra;
+        //! Rd and Rn encode SP instead of the zero register as 31
+        bool sp;
+    };
+
+    constexpr encoding_t ENCODINGS[] = {
+        // base
+        {0x7F800000, 0x11000000, X_W, X_R, NO, NO, true},    // ADD (immediate), MOV (to/from SP)
+        {0x7F800000, 0x51000000, X_W, X_R, NO, NO, true},    // SUB (immediate)
+        {0x7F200000, 0x0B000000, X_W, X_R, X_R, NO, false},  // ADD (shifted register)
+        {0x7F200000, 0x4B000000, X_W, X_R, X_R, NO, false},  // SUB (shifted register)
+        {0x7F000000, 0x0A000000, X_W, X_R, X_R, NO, false},  // AND, BIC (shifted register)
+        {0x7F000000, 0x2A000000, X_W, X_R, X_R, NO, false},  // ORR, ORN (shifted register), MOV (register)
+        {0x7F000000, 0x4A000000, X_W, X_R, X_R, NO, false},  // EOR, EON (shifted register)
+        {0x7F800000, 0x12800000, X_W, NO, NO, NO, false},    // MOVN
+        {0x7F800000, 0x52800000, X_W, NO, NO, NO, false},    // MOVZ
+        {0x7F800000, 0x72800000, X_RW, NO, NO, NO, false},   // MOVK
+        {0x7F800000, 0x13000000, X_W, X_R, NO, NO, false},   // SBFM
+        {0x7F800000, 0x53000000, X_W, X_R, NO, NO, false},   // UBFM, LSL (immediate)
+        {0x7FE00000, 0x1B000000, X_W, X_R, X_R, X_R, false}, // MADD, MSUB, MUL
+        {0xFFFFFFFF, 0xD503201F, NO, NO, NO, NO, false},     // NOP
+
+        // SIMD three same
+        {0xBFA0FC00, 0x0E20D400, V_W, V_R, V_R, NO, false},  // FADD (vector)
+        {0xBFA0FC00, 0x0EA0D400, V_W, V_R, V_R, NO, false},  // FSUB (vector)
+        {0xBFA0FC00, 0x2E20DC00, V_W, V_R, V_R, NO, false},  // FMUL (vector)
+        {0xBFA0FC00, 0x2E20FC00, V_W, V_R, V_R, NO, false},  // FDIV (vector)
+        {0xBFA0FC00, 0x0E20F400, V_W, V_R, V_R, NO, false},  // FMAX (vector)
+        {0xBFA0FC00, 0x0EA0F400, V_W, V_R, V_R, NO, false},  // FMIN (vector)
+        {0xBFA0FC00, 0x0E20FC00, V_W, V_R, V_R, NO, false},  // FRECPS (vector)
+        {0xBFA0FC00, 0x0E20CC00, V_RW, V_R, V_R, NO, false}, // FMLA (vector)
+        {0xBFA0FC00, 0x0EA0CC00, V_RW, V_R, V_R, NO, false}, // FMLS (vector)
+        {0xBFE0FC00, 0x0E201C00, V_W, V_R, V_R, NO, false},  // AND (vector)
+        {0xBFE0FC00, 0x0EA01C00, V_W, V_R, V_R, NO, false},  // ORR (vector), MOV (vector)
+        {0xBFE0FC00, 0x2E201C00, V_W, V_R, V_R, NO, false},  // EOR (vector)
+        {0xFFA0FC00, 0x5E20FC00, V_W, V_R, V_R, NO, false},  // FRECPS (scalar)
+
+        // SIMD two-register miscellaneous
+        {0xBFBFFC00, 0x0EA0F800, V_W, V_R, NO, NO, false}, // FABS (vector)
+        {0xBFBFFC00, 0x2EA0F800, V_W, V_R, NO, NO, false}, // FNEG (vector)
+        {0xBFBFFC00, 0x0EA1D800, V_W, V_R, NO, NO, false}, // FRECPE (vector)
+        {0xBFBFFC00, 0x0E21B800, V_W, V_R, NO, NO, false}, // FCVTMS (vector)
+        {0xBFBFFC00, 0x0E219800, V_W, V_R, NO, NO, false}, // FRINTM (vector)
+        {0xBFBFFC00, 0x0E218800, V_W, V_R, NO, NO, false}, // FRINTN (vector)
+        {0xBFBFFC00, 0x0E21D800, V_W, V_R, NO, NO, false}, // SCVTF (vector, integer)
+        {0xFFBFFC00, 0x5EA1D800, V_W, V_R, NO, NO, false}, // FRECPE (scalar)
+        {0xFFBFFC00, 0x5E21B800, V_W, V_R, NO, NO, false}, // FCVTMS (scalar)
+        {0xFFBFFC00, 0x5E21D800, V_W, V_R, NO, NO, false}, // SCVTF (scalar, integer)
+
+        // SIMD permute, by element, modified immediate and copy
+        {0xBF20BC00, 0x0E001800, V_W, V_R, V_R, NO, false},  // UZP1, UZP2
+        {0xBF20BC00, 0x0E002800, V_W, V_R, V_R, NO, false},  // TRN1, TRN2
+        {0xBF20BC00, 0x0E003800, V_W, V_R, V_R, NO, false},  // ZIP1, ZIP2
+        {0xBF80F400, 0x0F801000, V_RW, V_R, V_R, NO, false}, // FMLA (by element)
+        {0xBF80F400, 0x0F805000, V_RW, V_R, V_R, NO, false}, // FMLS (by element)
+        {0xBF80F400, 0x0F809000, V_W, V_R, V_R, NO, false},  // FMUL (by element)
+        {0x9FF8FC00, 0x0F00F400, V_W, NO, NO, NO, false},    // FMOV (vector, immediate)
+        {0xFFE08400, 0x6E000400, V_RW, V_R, NO, NO, false},  // INS (element), MOV (element)
+        {0xFFE0FC00, 0x4E001C00, V_RW, X_R, NO, NO, false},  // INS (general), MOV (from general)
+        {0xBFE0FC00, 0x0E003C00, X_W, V_R, NO, NO, false},   // UMOV
+
+        // floating-point scalar
+        {0xFF20FC00, 0x1E200800, V_W, V_R, V_R, NO, false},  // FMUL (scalar)
+        {0xFF20FC00, 0x1E201800, V_W, V_R, V_R, NO, false},  // FDIV (scalar)
+        {0xFF20FC00, 0x1E202800, V_W, V_R, V_R, NO, false},  // FADD (scalar)
+        {0xFF20FC00, 0x1E203800, V_W, V_R, V_R, NO, false},  // FSUB (scalar)
+        {0xFF20FC00, 0x1E204800, V_W, V_R, V_R, NO, false},  // FMAX (scalar)
+        {0xFF20FC00, 0x1E205800, V_W, V_R, V_R, NO, false},  // FMIN (scalar)
+        {0xFF3FFC00, 0x1E204000, V_W, V_R, NO, NO, false},   // FMOV (register)
+        {0xFF3FFC00, 0x1E20C000, V_W, V_R, NO, NO, false},   // FABS (scalar)
+        {0xFF3FFC00, 0x1E214000, V_W, V_R, NO, NO, false},   // FNEG (scalar)
+        {0xFF3FFC00, 0x1E244000, V_W, V_R, NO, NO, false},   // FRINTN (scalar)
+        {0xFF3FFC00, 0x1E254000, V_W, V_R, NO, NO, false},   // FRINTM (scalar)
+        {0xFF201FE0, 0x1E201000, V_W, NO, NO, NO, false},    // FMOV (scalar, immediate)
+        {0xFF20FC07, 0x1E202000, NO, V_R, V_R, NO, false},   // FCMP
+        {0xFF200000, 0x1F000000, V_W, V_R, V_R, V_R, false}, // FMADD, FMSUB
+        {0x7F3FFC00, 0x1E220000, V_W, X_R, NO, NO, false},   // SCVTF (scalar, integer)
+        {0x7F3F0000, 0x1E020000, V_W, X_R, NO, NO, false},   // SCVTF (scalar, fixed-point)
+    };
+
+    /**
+     * Adds a register operand to a decoded instruction.
+     * A general purpose register encoded as 31 is the zero register and no operand, unless the field holds SP.
+     */
+    void add_operand(instr_t&    instr,
+                     uint8_t     shift,
+                     reg_class_t reg_class,
+                     bool        read,
+                     bool        write,
+                     bool        sp = false)
+    {
+        if (reg_class == reg_class_t::gpr && !sp && ((instr.ins >> shift) & 0x1f) == 31)
+        {
+            return;
+        }
+        instr.operands[instr.num_operands++] = {shift, reg_class, read, write};
+    }
+
+    //! adds an operand of the field of an encoding
+    void add_field(instr_t&       instr,
+                   uint8_t        shift,
+                   field_t const& field,
+                   bool           sp)
+    {
+        if (field.access != none)
+        {
+            add_operand(instr, shift, field.reg_class, field.access & r, field.access & w, sp);
+        }
+    }
+
+    //! decodes LDP, STP, LDNP and STNP
+    void decode_pair(instr_t& instr)
+    {
+        uint32_t l_ins  = instr.ins;
+        bool     l_simd = (l_ins >> 26) & 0x1;
+        uint32_t l_opc  = l_ins >> 30;
+        if (l_opc == 3 || (!l_simd && l_opc == 1))
+        {
+            return;
+        }
+
+        bool        l_load      = (l_ins >> 22) & 0x1;
+        uint32_t    l_index     = (l_ins >> 23) & 0x3;
+        bool        l_writeback = l_index == 1 || l_index == 3;
+        reg_class_t l_class     = l_simd ? reg_class_t::simd : reg_class_t::gpr;
+
+        instr.kind = l_load ? instr_kind_t::load : instr_kind_t::store;
+        add_operand(instr, 0, l_class, !l_load, l_load);
+        add_operand(instr, 10, l_class, !l_load, l_load);
+        add_operand(instr, 5, reg_class_t::gpr, true, l_writeback, true);
+    }
+
+    //! decodes LDR and STR with an unsigned offset, an unscaled or indexed immediate or a register offset
+    void decode_single(instr_t& instr)
+    {
+        uint32_t l_ins       = instr.ins;
+        bool     l_writeback = false;
+        bool     l_offset    = false;
+        if ((l_ins & 0x3B000000) == 0x39000000)
+        {
+            // unsigned offset
+        }
+        else if ((l_ins & 0x3B200000) == 0x38000000)
+        {
+            // unscaled, post-index, unprivileged and pre-index
+            uint32_t l_index = (l_ins >> 10) & 0x3;
+            if (l_index == 2)
+            {
+                return;
+            }
+            l_writeback = l_index != 0;
+        }
+        else if ((l_ins & 0x3B200C00) == 0x38200800)
+        {
+            l_offset = true;
+        }
+        else
+        {
+            return;
+        }
+
+        bool l_simd = (l_ins >> 26) & 0x1;
+        bool l_load = false;
+        if (l_simd)
+        {
+            // the upper opc bit selects the 128-bit registers, only with size 00
+            if (((l_ins >> 23) & 0x1) && (l_ins >> 30) != 0)
+            {
+                return;
+            }
+            l_load = (l_ins >> 22) & 0x1;
+        }
+        else
+        {
+            // sign-extending loads and prefetches are not supported
+            uint32_t l_opc = (l_ins >> 22) & 0x3;
+            if (l_opc > 1)
+            {
+                return;
+            }
+            l_load = l_opc == 1;
+        }
+
+        instr.kind = l_load ? instr_kind_t::load : instr_kind_t::store;
+        add_operand(instr, 0, l_simd ? reg_class_t::simd : reg_class_t::gpr, !l_load, l_load);
+        add_operand(instr, 5, reg_class_t::gpr, true, l_writeback, true);
+        if (l_offset)
+        {
+            add_operand(instr, 16, reg_class_t::gpr, true, false);
+        }
+    }
+
+    //! decodes LD1 and ST1 of a single structure, i.e. a lane, and LD1R
+    void decode_structure(instr_t& instr)
+    {
+        uint32_t l_ins     = instr.ins;
+        bool     l_post    = (l_ins >> 23) & 0x1;
+        bool     l_load    = (l_ins >> 22) & 0x1;
+        uint32_t l_opcode  = (l_ins >> 13) & 0x7;
+        uint32_t l_rm      = (l_ins >> 16) & 0x1f;
+        bool     l_replace = l_opcode == 6;
+        if ((!l_post && l_rm != 0) || (l_replace && !l_load))
+        {
+            return;
+        }
+
+        // loading a lane keeps the other lanes of the register
+        instr.kind = l_load ? instr_kind_t::load : instr_kind_t::store;
+        add_operand(instr, 0, reg_class_t::simd, !l_load || !l_replace, l_load);
+        add_operand(instr, 5, reg_class_t::gpr, true, l_post, true);
+        if (l_post && l_rm != 31)
+        {
+            add_operand(instr, 16, reg_class_t::gpr, true, false);
+        }
+    }
+
+    /**
+     * Gets the immediate field of a branch.
+     *
+     * @return false if the instruction is no supported branch.
+     */
+    bool get_branch_field(uint32_t  ins,
+                          uint32_t& shift,
+                          uint32_t& bits)
+    {
+        if ((ins & 0x7C000000) == 0x14000000)
+        {
+            // B, BL
+            shift = 0;
+            bits  = 26;
+        }
+        else if ((ins & 0x7E000000) == 0x34000000 || (ins & 0xFF000010) == 0x54000000)
+        {
+            // CBZ, CBNZ, B.cond
+            shift = 5;
+            bits  = 19;
+        }
+        else if ((ins & 0x7E000000) == 0x36000000)
+        {
+            // TBZ, TBNZ
+            shift = 5;
+            bits  = 14;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Gets the registers of a 64-bit register move, i.e. MOV (register) or MOV (to/from SP).
+     *
+     * @return false if the instruction is no such move.
+     */
+    bool get_move(instr_t const& instr,
+                  uint32_t&      dest,
+                  uint32_t&      src)
+    {
+        dest = instr.ins & 0x1f;
+        if ((instr.ins & 0xFFE0FFE0) == 0xAA0003E0)
+        {
+            // ORR Xd, XZR, Xm, moves from or to the zero register are excluded
+            src = (instr.ins >> 16) & 0x1f;
+            return dest != 31 && src != 31;
+        }
+        if ((instr.ins & 0xFFFFFC00) == 0x91000000)
+        {
+            // ADD Xd, Xn, #0
+            src = (instr.ins >> 5) & 0x1f;
+            return true;
+        }
+        return false;
+    }
+
+    //! whether the instruction only writes a register, i.e. MOV (register, wide immediate or to/from SP)
+    bool is_move(instr_t const& instr)
+    {
+        uint32_t l_ins = instr.ins;
+        return (l_ins & 0x7FE0FFE0) == 0x2A0003E0 ||
+               (l_ins & 0x7FFFFC00) == 0x11000000 ||
+               (l_ins & 0x7F800000) == 0x52800000 ||
+               (l_ins & 0x7F800000) == 0x12800000;
+    }
+
+    //! whether the instruction is STP <Xt1|Dt1>, <Xt2|Dt2>, [SP, #-16]!
+    bool is_push(uint32_t ins)
+    {
+        return (ins & 0xFFFF83E0) == 0xA9BF03E0 || (ins & 0xFFFF83E0) == 0x6DBF03E0;
+    }
+
+    //! whether the instruction is LDP <Xt1|Dt1>, <Xt2|Dt2>, [SP], #16
+    bool is_pop(uint32_t ins)
+    {
+        return (ins & 0xFFFF83E0) == 0xA8C103E0 || (ins & 0xFFFF83E0) == 0x6CC103E0;
+    }
+
+    /**
+     * Removes moves of a register to itself and moves to registers which are never read,
+     * and propagates copies of registers which are never written.
+     *
+     * @return number of removed moves.
+     */
+    std::size_t remove_moves(std::vector<instr_t>&    instrs,
+                             std::vector<bool> const& covered,
+                             std::vector<bool>&       removed)
+    {
+        std::size_t l_size    = instrs.size();
+        std::size_t l_removed = 0;
+        bool        l_changed = true;
+        while (l_changed)
+        {
+            l_changed = false;
+
+            // the save and restore of callee-saved registers is no use of the registers,
+            // as long as the restore is executed exactly once and after all other uses
+            uint32_t    l_num_reads[64]  = {};
+            uint32_t    l_num_writes[64] = {};
+            std::size_t l_last_read[64]  = {};
+            std::size_t l_first_read[64];
+            std::size_t l_first_restore[64];
+            std::fill(l_first_read, l_first_read + 64, l_size);
+            std::fill(l_first_restore, l_first_restore + 64, l_size);
+            for (std::size_t l_in = 0; l_in < l_size; l_in++)
+            {
+                if (removed[l_in])
+                {
+                    continue;
+                }
+                uint64_t l_reads    = instrs[l_in].reads();
+                uint64_t l_writes   = instrs[l_in].writes();
+                uint64_t l_restores = 0;
+                if (is_push(instrs[l_in].ins))
+                {
+                    l_reads &= uint64_t(1) << SP;
+                }
+                else if (is_pop(instrs[l_in].ins) && !covered[l_in])
+                {
+                    l_restores = l_writes & ~(uint64_t(1) << SP);
+                    l_writes &= uint64_t(1) << SP;
+                }
+
+                for (uint32_t l_reg = 0; l_reg < 64; l_reg++)
+                {
+                    if ((l_reads >> l_reg) & 0x1)
+                    {
+                        l_num_reads[l_reg]++;
+                        l_first_read[l_reg] = std::min(l_first_read[l_reg], l_in);
+                        l_last_read[l_reg]  = l_in;
+                    }
+                    if ((l_restores >> l_reg) & 0x1)
+                    {
+                        l_first_restore[l_reg] = std::min(l_first_restore[l_reg], l_in);
+                    }
+                    l_num_writes[l_reg] += (l_writes >> l_reg) & 0x1;
+                }
+            }
+
+            for (std::size_t l_in = 0; l_in < l_size; l_in++)
+            {
+                if (removed[l_in])
+                {
+                    continue;
+                }
+                instr_t const& l_instr = instrs[l_in];
+                uint32_t       l_dest  = 0;
+                uint32_t       l_src   = 0;
+                bool           l_copy  = get_move(l_instr, l_dest, l_src);
+
+                // mov x8, x8
+                if (l_copy && l_dest == l_src)
+                {
+                    removed[l_in] = true;
+                    l_removed++;
+                    l_changed = true;
+                    continue;
+                }
+
+                // moves to registers which are never read, the frame pointer and SP are kept
+                if (is_move(l_instr) && l_instr.num_operands > 0 && l_instr.operands[0].write)
+                {
+                    uint32_t l_reg = l_instr.get_reg(0);
+                    if (l_reg <= MAX_FREE_GPR && l_num_reads[l_reg] == 0)
+                    {
+                        removed[l_in] = true;
+                        l_removed++;
+                        l_changed = true;
+                        continue;
+                    }
+                }
+
+                // mov x20, x1 which is executed exactly once, before any read of x20, and neither register is written elsewhere
+                if (l_copy &&
+                    l_dest <= MAX_FREE_GPR &&
+                    l_src <= MAX_FREE_GPR &&
+                    !covered[l_in] &&
+                    l_num_writes[l_dest] == 1 &&
+                    l_num_writes[l_src] == 0 &&
+                    l_first_read[l_dest] > l_in &&
+                    l_last_read[l_dest] < std::min(l_first_restore[l_dest], l_first_restore[l_src]))
+                {
+                    for (std::size_t l_use = l_in + 1; l_use < l_size; l_use++)
+                    {
+                        instr_t& l_user = instrs[l_use];
+                        for (uint8_t l_op = 0; l_op < l_user.num_operands; l_op++)
+                        {
+                            Peephole::operand_t const& l_operand = l_user.operands[l_op];
+                            if (l_operand.read && l_user.get_reg(l_op) == l_dest)
+                            {
+                                l_user.ins = (l_user.ins & ~(0x1fu << l_operand.shift)) | (l_src << l_operand.shift);
+                            }
+                        }
+                    }
+                    removed[l_in] = true;
+                    l_removed++;
+                    l_changed = true;
+
+                    // the counts of the registers changed
+                    break;
+                }
+            }
+        }
+
+        return l_removed;
+    }
+
+    /**
+     * Removes the save and restore of callee-saved registers which are never written.
+     * Only done if SP is changed by pairs of pushes and pops which are executed exactly once,
+     * and only copied to other registers otherwise, e.g. to the frame pointer.
+     *
+     * @return number of removed instructions.
+     */
+    std::size_t remove_spills(std::vector<instr_t> const& instrs,
+                              std::vector<bool> const&    covered,
+                              std::vector<bool>&          removed)
+    {
+        std::size_t                                      l_size = instrs.size();
+        std::vector<std::size_t>                         l_stack;
+        std::vector<std::pair<std::size_t, std::size_t>> l_pairs;
+        std::vector<std::size_t>                         l_copies;
+        uint32_t                                         l_num_writes[64] = {};
+
+        for (std::size_t l_in = 0; l_in < l_size; l_in++)
+        {
+            if (removed[l_in])
+            {
+                continue;
+            }
+            instr_t const& l_instr  = instrs[l_in];
+            uint64_t       l_writes = l_instr.writes();
+            for (uint32_t l_reg = 0; l_reg < 64; l_reg++)
+            {
+                l_num_writes[l_reg] += (l_writes >> l_reg) & 0x1;
+            }
+
+            if (l_instr.kind == instr_kind_t::ret && !l_stack.empty())
+            {
+                return 0;
+            }
+            if ((((l_instr.reads() | l_writes) >> SP) & 0x1) == 0)
+            {
+                continue;
+            }
+            if (covered[l_in])
+            {
+                return 0;
+            }
+
+            uint32_t l_dest = 0;
+            uint32_t l_src  = 0;
+            if (is_push(l_instr.ins))
+            {
+                l_stack.push_back(l_in);
+            }
+            else if (is_pop(l_instr.ins))
+            {
+                // the registers of the pop have to match the last push
+                if (l_stack.empty() || (instrs[l_stack.back()].ins & 0xC4007C1F) != (l_instr.ins & 0xC4007C1F))
+                {
+                    return 0;
+                }
+                l_pairs.emplace_back(l_stack.back(), l_in);
+                l_stack.pop_back();
+            }
+            else if (get_move(l_instr, l_dest, l_src) && l_src == SP && l_dest != SP)
+            {
+                l_copies.push_back(l_in);
+            }
+            else
+            {
+                return 0;
+            }
+        }
+        if (!l_stack.empty())
+        {
+            return 0;
+        }
+
+        std::size_t l_removed = 0;
+        for (auto const& [l_push, l_pop] : l_pairs)
+        {
+            // the pop is the only write of both registers
+            instr_t const& l_instr = instrs[l_pop];
+            if (l_instr.num_operands != 3 ||
+                l_num_writes[l_instr.get_reg(0)] != 1 || l_num_writes[l_instr.get_reg(1)] != 1)
+            {
+                continue;
+            }
+
+            // copies of SP between push and pop would change
+            bool l_copied = std::any_of(l_copies.begin(),
+                                        l_copies.end(),
+                                        [&](std::size_t l_copy)
+                                        { return l_push < l_copy && l_copy < l_pop; });
+            if (l_copied)
+            {
+                continue;
+            }
+
+            removed[l_push] = true;
+            removed[l_pop]  = true;
+            l_removed += 2;
+        }
+
+        return l_removed;
+    }
+
+    /**
+     * Moves loads above the arithmetic instructions of the same basic block which do not depend on them.
+     * Loads are not moved across other loads or stores, so the order of the memory accesses is kept.
+     *
+     * @return number of moved loads.
+     */
+    std::size_t schedule_loads(std::vector<instr_t>&    instrs,
+                               std::vector<bool> const& leaders)
+    {
+        std::size_t l_hoisted = 0;
+        for (std::size_t l_in = 1; l_in < instrs.size(); l_in++)
+        {
+            if (instrs[l_in].kind != instr_kind_t::load)
+            {
+                continue;
+            }
+
+            uint64_t    l_reads  = instrs[l_in].reads();
+            uint64_t    l_writes = instrs[l_in].writes();
+            std::size_t l_pos    = l_in;
+            while (l_pos > 0 && !leaders[l_pos])
+            {
+                instr_t const& l_prev = instrs[l_pos - 1];
+                if (l_prev.kind != instr_kind_t::alu ||
+                    (l_prev.writes() & (l_reads | l_writes)) != 0 ||
+                    (l_prev.reads() & l_writes) != 0)
+                {
+                    break;
+                }
+                l_pos--;
+            }
+
+            if (l_pos < l_in)
+            {
+                std::rotate(instrs.begin() + l_pos,
+                            instrs.begin() + l_in,
+                            instrs.begin() + l_in + 1);
+                l_hoisted++;
+            }
+        }
+        return l_hoisted;
+    }
+} // namespace
+
+uint32_t mini_jit::Peephole::instr_t::get_reg(std::size_t operand) const
+{
+    return reg_id(operands[operand].reg_class, (ins >> operands[operand].shift) & 0x1f);
+}
+
+uint64_t mini_jit::Peephole::instr_t::reads() const
+{
+    uint64_t l_mask = 0;
+    for (uint8_t l_op = 0; l_op < num_operands; l_op++)
+    {
+        if (operands[l_op].read)
+        {
+            l_mask |= uint64_t(1) << get_reg(l_op);
+        }
+    }
+    return l_mask;
+}
+
+uint64_t mini_jit::Peephole::instr_t::writes() const
+{
+    uint64_t l_mask = 0;
+    for (uint8_t l_op = 0; l_op < num_operands; l_op++)
+    {
+        if (operands[l_op].write)
+        {
+            l_mask |= uint64_t(1) << get_reg(l_op);
+        }
+    }
+    return l_mask;
+}
+
+uint32_t mini_jit::Peephole::reg_id(reg_class_t reg_class,
+                                    uint32_t    reg)
+{
+    return reg_class == reg_class_t::simd ? 32 + reg : reg;
+}
+
+mini_jit::Peephole::instr_t mini_jit::Peephole::decode(uint32_t ins)
+{
+    instr_t l_instr;
+    l_instr.ins = ins;
+
+    // branches, BL is not supported since it clobbers the link register
+    uint32_t l_shift = 0;
+    uint32_t l_bits  = 0;
+    if (get_branch_field(ins, l_shift, l_bits))
+    {
+        if ((ins & 0xFC000000) != 0x94000000)
+        {
+            l_instr.kind = instr_kind_t::branch;
+            if (l_shift == 5 && (ins & 0xFF000010) != 0x54000000)
+            {
+                // CBZ, CBNZ, TBZ, TBNZ
+                add_operand(l_instr, 0, reg_class_t::gpr, true, false);
+            }
+        }
+        return l_instr;
+    }
+    if ((ins & 0xFFFFFC1F) == 0xD65F0000)
+    {
+        l_instr.kind = instr_kind_t::ret;
+        add_operand(l_instr, 5, reg_class_t::gpr, true, false);
+        return l_instr;
+    }
+
+    // loads and stores
+    if ((ins & 0x3A000000) == 0x28000000)
+    {
+        decode_pair(l_instr);
+        return l_instr;
+    }
+    if ((ins & 0x3A000000) == 0x38000000)
+    {
+        decode_single(l_instr);
+        return l_instr;
+    }
+    if ((ins & 0xBF202000) == 0x0D000000)
+    {
+        decode_structure(l_instr);
+        return l_instr;
+    }
+
+    // arithmetic
+    for (encoding_t const& l_enc : ENCODINGS)
+    {
+        if ((ins & l_enc.mask) == l_enc.value)
+        {
+            l_instr.kind = instr_kind_t::alu;
+            add_field(l_instr, 0, l_enc.rd, l_enc.sp);
+            add_field(l_instr, 5, l_enc.rn, l_enc.sp);
+            add_field(l_instr, 16, l_enc.rm, false);
+            add_field(l_instr, 10, l_enc.ra, false);
+            return l_instr;
+        }
+    }
+
+    return l_instr;
+}
+
+bool mini_jit::Peephole::get_branch_offset(uint32_t ins,
+                                           int64_t& offset)
+{
+    uint32_t l_shift = 0;
+    uint32_t l_bits  = 0;
+    if (!get_branch_field(ins, l_shift, l_bits))
+    {
+        return false;
+    }
+
+    // sign-extend the immediate
+    uint32_t l_imm = (ins >> l_shift) & ((uint32_t(1) << l_bits) - 1);
+    offset         = static_cast<int64_t>(l_imm) - ((l_imm >> (l_bits - 1)) ? (int64_t(1) << l_bits) : 0);
+    return true;
+}
+
+uint32_t mini_jit::Peephole::set_branch_offset(uint32_t ins,
+                                               int64_t  offset)
+{
+    // the offset is counted in instructions and stored in a signed immediate field
+    uint32_t l_shift = 0;
+    uint32_t l_bits  = 0;
+    if (!get_branch_field(ins, l_shift, l_bits))
+    {
+        throw std::invalid_argument("Instruction is not a supported branch: " + std::to_string(ins));
+    }
+
+    int64_t l_limit = int64_t(1) << (l_bits - 1);
+    if (offset < -l_limit || offset >= l_limit)
+    {
+        throw std::invalid_argument("Branch target out of range: " + std::to_string(offset) + " instructions");
+    }
+
+    uint32_t l_mask = ((uint32_t(1) << l_bits) - 1) << l_shift;
+    return (ins & ~l_mask) | ((static_cast<uint32_t>(offset) << l_shift) & l_mask);
+}
+
+mini_jit::Peephole::stats_t mini_jit::Peephole::optimize(std::vector<uint32_t>&    code,
+                                                         std::vector<std::size_t>* positions)
+{
+    stats_t     l_stats;
+    std::size_t l_size = code.size();
+    if (positions != nullptr)
+    {
+        positions->resize(l_size + 1);
+        for (std::size_t l_in = 0; l_in <= l_size; l_in++)
+        {
+            (*positions)[l_in] = l_in;
+        }
+    }
+
+    // decode the code and find the targets of the branches
+    std::vector<instr_t> l_instrs(l_size);
+    std::vector<int64_t> l_targets(l_size, -1);
+    std::vector<int64_t> l_cover(l_size + 1, 0);
+    for (std::size_t l_in = 0; l_in < l_size; l_in++)
+    {
+        l_instrs[l_in] = decode(code[l_in]);
+        if (l_instrs[l_in].kind == instr_kind_t::unknown)
+        {
+            l_stats.analyzed = false;
+            return l_stats;
+        }
+
+        int64_t l_offset = 0;
+        if (l_instrs[l_in].kind == instr_kind_t::branch && get_branch_offset(code[l_in], l_offset))
+        {
+            int64_t l_target = static_cast<int64_t>(l_in) + l_offset;
+            if (l_target < 0 || l_target > static_cast<int64_t>(l_size))
+            {
+                l_stats.analyzed = false;
+                return l_stats;
+            }
+            l_targets[l_in] = l_target;
+
+            // instructions between a branch and its target may be skipped or executed repeatedly
+            std::size_t l_first = std::min<std::size_t>(l_in, l_target);
+            std::size_t l_last  = std::min<std::size_t>(std::max<std::size_t>(l_in, l_target), l_size - 1);
+            l_cover[l_first]++;
+            l_cover[l_last + 1]--;
+        }
+    }
+
+    std::vector<bool> l_covered(l_size, false);
+    int64_t           l_num_covering = 0;
+    for (std::size_t l_in = 0; l_in < l_size; l_in++)
+    {
+        l_num_covering += l_cover[l_in];
+        l_covered[l_in] = l_num_covering > 0;
+    }
+
+    std::vector<bool> l_removed(l_size, false);
+    l_stats.removed_moves  = remove_moves(l_instrs, l_covered, l_removed);
+    l_stats.removed_spills = remove_spills(l_instrs, l_covered, l_removed);
+
+    // compact the code, branches to removed instructions target the next instruction
+    std::vector<std::size_t> l_new_positions(l_size + 1);
+    std::size_t              l_num_kept = 0;
+    for (std::size_t l_in = 0; l_in < l_size; l_in++)
+    {
+        l_new_positions[l_in] = l_num_kept;
+        l_num_kept += l_removed[l_in] ? 0 : 1;
+    }
+    l_new_positions[l_size] = l_num_kept;
+
+    std::vector<instr_t> l_kept;
+    std::vector<bool>    l_leaders(l_num_kept + 1, false);
+    l_kept.reserve(l_num_kept);
+    for (std::size_t l_in = 0; l_in < l_size; l_in++)
+    {
+        if (l_removed[l_in])
+        {
+            continue;
+        }
+        instr_t l_instr = l_instrs[l_in];
+        if (l_targets[l_in] != -1)
+        {
+            std::size_t l_target = l_new_positions[l_targets[l_in]];
+            l_instr.ins          = set_branch_offset(l_instr.ins,
+                                                     static_cast<int64_t>(l_target) - static_cast<int64_t>(l_kept.size()));
+            l_leaders[l_target]  = true;
+        }
+        l_kept.push_back(l_instr);
+    }
+
+    l_stats.hoisted_loads = schedule_loads(l_kept, l_leaders);
+
+    code.resize(l_num_kept);
+    for (std::size_t l_in = 0; l_in < l_num_kept; l_in++)
+    {
+        code[l_in] = l_kept[l_in].ins;
+    }
+    if (positions != nullptr)
+    {
+        *positions = std::move(l_new_positions);
+    }
+
+    return l_stats;
+}
+
+bool mini_jit::Peephole::enabled_by_default()
+{
+    static bool const l_enabled = []()
+    {
+        char const* l_value = std::getenv("MLC_PEEPHOLE");
+        return l_value == nullptr || std::strcmp(l_value, "0") != 0;
+    }();
+    return l_enabled;
+}
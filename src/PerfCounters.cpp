@@ -0,0 +1,217 @@
+#include <mlc/PerfCounters.h>
+#include <omp.h>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+namespace
+{
+    /**
+     * Open a counter of the calling thread and its future children, the counter is stopped.
+     *
+     * @param type Type of the event, e.g. PERF_TYPE_HARDWARE.
+     * @param config Event of the type, e.g. PERF_COUNT_HW_CPU_CYCLES.
+     * @return The file descriptor, -1 if the event cannot be counted.
+     */
+    int open_event(uint32_t type,
+                   uint64_t config)
+    {
+        perf_event_attr l_attr;
+        std::memset(&l_attr, 0, sizeof(l_attr));
+        l_attr.size           = sizeof(l_attr);
+        l_attr.type           = type;
+        l_attr.config         = config;
+        l_attr.disabled       = 1;
+        l_attr.inherit        = 1;
+        l_attr.exclude_kernel = 1;
+        l_attr.exclude_hv     = 1;
+        l_attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast<int>(syscall(SYS_perf_event_open, &l_attr, 0, -1, -1, 0));
+    }
+
+    /**
+     * Config of a read miss event of a cache.
+     */
+    constexpr uint64_t cache_read_misses(uint64_t cache)
+    {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    /**
+     * Open the counters of all events of the calling thread.
+     *
+     * @return The file descriptors indexed by event, -1 if the event cannot be counted.
+     */
+    std::array<int, mini_jit::PerfCounters::NUM_EVENTS> open_events()
+    {
+        using event_t = mini_jit::PerfCounters::event_t;
+
+        std::array<int, mini_jit::PerfCounters::NUM_EVENTS> l_fds;
+        l_fds[static_cast<std::size_t>(event_t::cycles)]        = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        l_fds[static_cast<std::size_t>(event_t::instructions)]  = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        l_fds[static_cast<std::size_t>(event_t::l1d_misses)]    = open_event(PERF_TYPE_HW_CACHE, cache_read_misses(PERF_COUNT_HW_CACHE_L1D));
+        l_fds[static_cast<std::size_t>(event_t::llc_misses)]    = open_event(PERF_TYPE_HW_CACHE, cache_read_misses(PERF_COUNT_HW_CACHE_LL));
+        l_fds[static_cast<std::size_t>(event_t::branch_misses)] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        return l_fds;
+    }
+} // namespace
+#endif
+
+mini_jit::PerfCounters::values_t mini_jit::PerfCounters::values_t::per(double divisor) const
+{
+    values_t l_values = *this;
+    for (std::size_t i = 0; i < NUM_EVENTS; i++)
+    {
+        l_values.counts[i] = divisor > 0.0 ? counts[i] / divisor : 0.0;
+    }
+    return l_values;
+}
+
+mini_jit::PerfCounters::PerfCounters()
+{
+    std::array<int, NUM_EVENTS> l_closed;
+    l_closed.fill(-1);
+    m_fds.assign(omp_get_max_threads(), l_closed);
+#ifdef __linux__
+    // the other threads of the team open their counters first, so that the inherited
+    // counters of the calling thread only include threads which are created afterwards
+#pragma omp parallel num_threads(static_cast<int>(m_fds.size()))
+    {
+        int l_thread = omp_get_thread_num();
+        if (l_thread > 0)
+        {
+            m_fds[l_thread] = open_events();
+        }
+    }
+    m_fds[0] = open_events();
+
+    // threads which miss events of the calling thread would distort the sums, so they count nothing
+    for (std::array<int, NUM_EVENTS>& l_thread_fds : m_fds)
+    {
+        bool l_complete = true;
+        bool l_counted  = false;
+        for (std::size_t i = 0; i < NUM_EVENTS; i++)
+        {
+            l_complete = l_complete && (m_fds[0][i] < 0 || l_thread_fds[i] >= 0);
+            l_counted  = l_counted || m_fds[0][i] >= 0;
+        }
+        for (std::size_t i = 0; i < NUM_EVENTS; i++)
+        {
+            if (l_thread_fds[i] >= 0 && (m_fds[0][i] < 0 || !l_complete))
+            {
+                close(l_thread_fds[i]);
+                l_thread_fds[i] = -1;
+            }
+        }
+        m_num_threads += l_complete && l_counted ? 1 : 0;
+    }
+#endif
+}
+
+mini_jit::PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (std::array<int, NUM_EVENTS> const& l_thread_fds : m_fds)
+    {
+        for (int l_fd : l_thread_fds)
+        {
+            if (l_fd >= 0)
+            {
+                close(l_fd);
+            }
+        }
+    }
+#endif
+}
+
+bool mini_jit::PerfCounters::available() const
+{
+    return m_num_threads > 0;
+}
+
+void mini_jit::PerfCounters::start()
+{
+#ifdef __linux__
+    for (std::array<int, NUM_EVENTS> const& l_thread_fds : m_fds)
+    {
+        for (int l_fd : l_thread_fds)
+        {
+            if (l_fd >= 0)
+            {
+                ioctl(l_fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(l_fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+#endif
+}
+
+void mini_jit::PerfCounters::stop()
+{
+#ifdef __linux__
+    for (std::array<int, NUM_EVENTS> const& l_thread_fds : m_fds)
+    {
+        for (int l_fd : l_thread_fds)
+        {
+            if (l_fd >= 0)
+            {
+                ioctl(l_fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+    }
+#endif
+}
+
+mini_jit::PerfCounters::values_t mini_jit::PerfCounters::read() const
+{
+    values_t l_values;
+#ifdef __linux__
+    for (std::array<int, NUM_EVENTS> const& l_thread_fds : m_fds)
+    {
+        for (std::size_t i = 0; i < NUM_EVENTS; i++)
+        {
+            // value, time enabled, time running
+            uint64_t l_buffer[3] = {0, 0, 0};
+            if (l_thread_fds[i] < 0 || ::read(l_thread_fds[i], l_buffer, sizeof(l_buffer)) != sizeof(l_buffer))
+            {
+                continue;
+            }
+
+            // events which were enabled but never scheduled on the PMU have no meaningful count
+            if (l_buffer[2] == 0 && l_buffer[1] != 0)
+            {
+                continue;
+            }
+            double l_scale      = l_buffer[2] > 0 ? static_cast<double>(l_buffer[1]) / l_buffer[2] : 1.0;
+            l_values.counts[i] += l_buffer[0] * l_scale;
+            l_values.counted[i] = true;
+        }
+    }
+#endif
+    return l_values;
+}
+
+char const* mini_jit::PerfCounters::name(event_t event)
+{
+    switch (event)
+    {
+    case event_t::cycles:
+        return "cycles";
+    case event_t::instructions:
+        return "instructions";
+    case event_t::l1d_misses:
+        return "l1d_misses";
+    case event_t::llc_misses:
+        return "llc_misses";
+    case event_t::branch_misses:
+        return "branch_misses";
+    }
+    return "unknown";
+}
@@ -0,0 +1,271 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <ios>
+#include <mlc/PerfMap.h>
+#include <stdexcept>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace
+{
+    /**
+     * Check whether an environment variable is set to a value other than 0.
+     */
+    bool env_enabled(char const* name)
+    {
+        char const* l_value = std::getenv(name);
+        return l_value != nullptr && l_value[0] != '\0' && std::strcmp(l_value, "0") != 0;
+    }
+
+#ifdef __linux__
+    //! magic number of jitdump files, "JiTD"
+    constexpr uint32_t JITDUMP_MAGIC = 0x4A695444;
+    //! id of the code load record
+    constexpr uint32_t JIT_CODE_LOAD = 0;
+
+    /// File header of the jitdump format.
+    struct jitdump_header_t
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t total_size;
+        uint32_t elf_mach;
+        uint32_t pad1;
+        uint32_t pid;
+        uint64_t timestamp;
+        uint64_t flags;
+    };
+
+    /// Code load record of the jitdump format, followed by the name and the code.
+    struct jitdump_code_load_t
+    {
+        uint32_t id;
+        uint32_t total_size;
+        uint64_t timestamp;
+        uint32_t pid;
+        uint32_t tid;
+        uint64_t vma;
+        uint64_t code_addr;
+        uint64_t code_size;
+        uint64_t code_index;
+    };
+
+    /**
+     * Timestamp of the monotonic clock in nanoseconds, the clock of perf record -k mono.
+     */
+    uint64_t monotonic_ns()
+    {
+        timespec l_time;
+        clock_gettime(CLOCK_MONOTONIC, &l_time);
+        return static_cast<uint64_t>(l_time.tv_sec) * 1000000000ull + l_time.tv_nsec;
+    }
+
+    /**
+     * Write the whole buffer, retrying after interrupts and partial writes.
+     */
+    bool write_all(int         fd,
+                   void const* data,
+                   std::size_t size)
+    {
+        char const* l_data = static_cast<char const*>(data);
+        while (size > 0)
+        {
+            ssize_t l_written = ::write(fd, l_data, size);
+            if (l_written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (l_written <= 0)
+            {
+                return false;
+            }
+            l_data += l_written;
+            size -= l_written;
+        }
+        return true;
+    }
+#endif
+} // namespace
+
+mini_jit::PerfMap::PerfMap()
+{
+    // profiling should never break the application, so invalid settings only disable the output
+    try
+    {
+        if (env_enabled("MLC_PERF_MAP"))
+        {
+            enable_perf_map();
+        }
+        if (env_enabled("MLC_JITDUMP"))
+        {
+            char const* l_dir = std::getenv("MLC_JITDUMP_DIR");
+            enable_jitdump(l_dir != nullptr ? l_dir : ".");
+        }
+    }
+    catch (std::runtime_error const&)
+    {
+    }
+}
+
+mini_jit::PerfMap::~PerfMap()
+{
+    disable();
+}
+
+mini_jit::PerfMap& mini_jit::PerfMap::instance()
+{
+    static PerfMap l_instance;
+    return l_instance;
+}
+
+void mini_jit::PerfMap::enable_perf_map(std::string const& path)
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+
+    std::string l_path = path.empty() ? "/tmp/perf-" + std::to_string(getpid()) + ".map" : path;
+    m_map.close();
+    m_map.open(l_path, std::ios::out | std::ios::app);
+    if (!m_map.is_open())
+    {
+        m_map_path.clear();
+        throw std::runtime_error("Failed to open perf map: " + l_path);
+    }
+    m_map_path = l_path;
+}
+
+void mini_jit::PerfMap::enable_jitdump(std::string const& dir)
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    close_jitdump();
+
+#ifdef __linux__
+    std::string l_path = dir + "/jit-" + std::to_string(getpid()) + ".dump";
+    int         l_fd   = open(l_path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (l_fd < 0)
+    {
+        throw std::runtime_error("Failed to open jitdump: " + l_path + ": " + std::strerror(errno));
+    }
+
+    jitdump_header_t l_header;
+    std::memset(&l_header, 0, sizeof(l_header));
+    l_header.magic      = JITDUMP_MAGIC;
+    l_header.version    = 1;
+    l_header.total_size = sizeof(l_header);
+#if defined(__aarch64__)
+    l_header.elf_mach = EM_AARCH64;
+#elif defined(__x86_64__)
+    l_header.elf_mach = EM_X86_64;
+#endif
+    l_header.pid       = static_cast<uint32_t>(getpid());
+    l_header.timestamp = monotonic_ns();
+
+    // perf record only picks up jitdump files which are mapped executable by the process
+    void* l_marker = MAP_FAILED;
+    if (write_all(l_fd, &l_header, sizeof(l_header)))
+    {
+        l_marker = mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, l_fd, 0);
+    }
+    if (l_marker == MAP_FAILED)
+    {
+        close(l_fd);
+        throw std::runtime_error("Failed to initialize jitdump: " + l_path + ": " + std::strerror(errno));
+    }
+
+    m_jitdump_fd     = l_fd;
+    m_jitdump_marker = l_marker;
+    m_jitdump_path   = l_path;
+#else
+    (void)dir;
+    throw std::runtime_error("jitdump is only supported on Linux");
+#endif
+}
+
+void mini_jit::PerfMap::close_jitdump()
+{
+#ifdef __linux__
+    if (m_jitdump_marker != nullptr)
+    {
+        munmap(m_jitdump_marker, sysconf(_SC_PAGESIZE));
+        m_jitdump_marker = nullptr;
+    }
+    if (m_jitdump_fd >= 0)
+    {
+        close(m_jitdump_fd);
+        m_jitdump_fd = -1;
+    }
+#endif
+    m_jitdump_path.clear();
+}
+
+void mini_jit::PerfMap::disable()
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    m_map.close();
+    m_map_path.clear();
+    close_jitdump();
+}
+
+bool mini_jit::PerfMap::enabled()
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return m_map.is_open() || m_jitdump_fd >= 0;
+}
+
+std::string mini_jit::PerfMap::get_perf_map_path()
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return m_map_path;
+}
+
+std::string mini_jit::PerfMap::get_jitdump_path()
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return m_jitdump_path;
+}
+
+void mini_jit::PerfMap::add(void const*        code,
+                            std::size_t        size,
+                            std::string const& name)
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+
+    if (m_map.is_open())
+    {
+        // flushed per kernel, the process may not exit cleanly
+        m_map << std::hex << reinterpret_cast<uintptr_t>(code) << " " << size << std::dec << " " << name << std::endl;
+    }
+
+#ifdef __linux__
+    if (m_jitdump_fd >= 0)
+    {
+        jitdump_code_load_t l_record;
+        std::memset(&l_record, 0, sizeof(l_record));
+        l_record.id         = JIT_CODE_LOAD;
+        l_record.total_size = static_cast<uint32_t>(sizeof(l_record) + name.size() + 1 + size);
+        l_record.timestamp  = monotonic_ns();
+        l_record.pid        = static_cast<uint32_t>(getpid());
+        l_record.tid        = static_cast<uint32_t>(syscall(SYS_gettid));
+        l_record.vma        = reinterpret_cast<uintptr_t>(code);
+        l_record.code_addr  = reinterpret_cast<uintptr_t>(code);
+        l_record.code_size  = size;
+        l_record.code_index = m_code_index++;
+
+        bool l_ok = write_all(m_jitdump_fd, &l_record, sizeof(l_record)) &&
+                    write_all(m_jitdump_fd, name.c_str(), name.size() + 1) &&
+                    write_all(m_jitdump_fd, code, size);
+        if (!l_ok)
+        {
+            // a truncated record would corrupt all following ones
+            close_jitdump();
+        }
+    }
+#endif
+}
@@ -1,8 +1,75 @@
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <mlc/TensorOperation.h>
+#include <mlc/Tracer.h>
+#include <new>
+#include <omp.h>
 #include <ostream>
 
+namespace
+{
+    /// alignment of the packed blocks in bytes, a cache line
+    constexpr std::size_t PACK_ALIGNMENT = 64;
+
+    /// Allocator which aligns the packed blocks to PACK_ALIGNMENT bytes.
+    template <typename T>
+    struct pack_allocator_t
+    {
+        using value_type = T;
+
+        pack_allocator_t() = default;
+
+        template <typename U>
+        pack_allocator_t(pack_allocator_t<U> const&)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{PACK_ALIGNMENT}));
+        }
+
+        void deallocate(T* ptr, std::size_t)
+        {
+            ::operator delete(ptr, std::align_val_t{PACK_ALIGNMENT});
+        }
+
+        template <typename U>
+        bool operator==(pack_allocator_t<U> const&) const
+        {
+            return true;
+        }
+    };
+
+    /// Packed input blocks of the calling thread.
+    struct pack_state_t
+    {
+        /// operation which packed the blocks
+        mini_jit::TensorOperation const* owner = nullptr;
+        /// source of the packed block of the first input
+        char const* src_in0 = nullptr;
+        /// source of the packed block of the second input
+        char const* src_in1 = nullptr;
+        /// packed block of the first input
+        std::vector<char, pack_allocator_t<char>> buffer_in0;
+        /// packed block of the second input
+        std::vector<char, pack_allocator_t<char>> buffer_in1;
+    };
+
+    thread_local pack_state_t t_pack_state;
+
+    /**
+     * Forget the packed blocks of the calling thread, since the inputs may have changed.
+     */
+    void reset_pack_state()
+    {
+        t_pack_state.owner   = nullptr;
+        t_pack_state.src_in0 = nullptr;
+        t_pack_state.src_in1 = nullptr;
+    }
+} // namespace
+
 mini_jit::error_t mini_jit::TensorOperation::setup(dtype_t                  dtype,
                                                    ptype_t                  prim_first_touch,
                                                    ptype_t                  prim_main,
@@ -12,8 +79,20 @@ mini_jit::error_t mini_jit::TensorOperation::setup(dtype_t                  dtyp
                                                    std::span<const int64_t> dim_sizes,
                                                    std::span<const int64_t> strides_in0,
                                                    std::span<const int64_t> strides_in1,
-                                                   std::span<const int64_t> strides_out)
+                                                   std::span<const int64_t> strides_out,
+                                                   std::span<const int64_t> dim_remainders)
 {
+    // every call of l_end_phase ends the current phase of the setup and starts the next one
+    m_setup_timings    = setup_timings_t();
+    auto l_phase_start = std::chrono::steady_clock::now();
+    auto l_end_phase   = [&]()
+    {
+        auto    l_now = std::chrono::steady_clock::now();
+        int64_t l_ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(l_now - l_phase_start).count();
+        l_phase_start = l_now;
+        return l_ns;
+    };
+
     /////////////////////////////////////////////////////////////////////
     // Check the number of dimensions
     /////////////////////////////////////////////////////////////////////
@@ -24,6 +103,10 @@ mini_jit::error_t mini_jit::TensorOperation::setup(dtype_t                  dtyp
     {
         return error_t::wrong_dimension;
     }
+    if (!dim_remainders.empty() && dim_types.size() != dim_remainders.size())
+    {
+        return error_t::wrong_dimension;
+    }
 
     /////////////////////////////////////////////////////////////////////
     // Check the number of prim exec types
@@ -250,6 +333,45 @@ mini_jit::error_t mini_jit::TensorOperation::setup(dtype_t                  dtyp
         }
     }
 
+    /////////////////////////////////////////////////////////////////////
+    // Find loops with remainders
+    /////////////////////////////////////////////////////////////////////
+    // only the last iteration of a SEQ or SHARED M or N loop may have a
+    // remainder, which has to be smaller than the primary dimension of the same type
+    m_dim_id_rem_M = -1;
+    m_dim_id_rem_N = -1;
+    for (size_t i = 0; i < dim_remainders.size(); ++i)
+    {
+        if (dim_remainders[i] == 0)
+        {
+            continue;
+        }
+
+        int64_t l_dim_id_prim = m_dim_types[i] == dim_t::m ? m_dim_id_prim_M : m_dim_id_prim_N;
+        int64_t l_dim_id_rem  = m_dim_types[i] == dim_t::m ? m_dim_id_rem_M : m_dim_id_rem_N;
+        if ((m_dim_types[i] != dim_t::m && m_dim_types[i] != dim_t::n) ||
+            (m_exec_types[i] != exec_t::seq && m_exec_types[i] != exec_t::shared) ||
+            l_dim_id_prim == -1 ||
+            m_dim_types[l_dim_id_prim] != m_dim_types[i] ||
+            l_dim_id_rem != -1 ||
+            dim_remainders[i] < 0 ||
+            dim_remainders[i] >= m_dim_sizes[l_dim_id_prim])
+        {
+            m_dim_id_rem_M = -1;
+            m_dim_id_rem_N = -1;
+            return error_t::wrong_dimension;
+        }
+
+        if (m_dim_types[i] == dim_t::m)
+        {
+            m_dim_id_rem_M = i;
+        }
+        else
+        {
+            m_dim_id_rem_N = i;
+        }
+    }
+
     /////////////////////////////////////////////////////////////////////
     // Check for Transposition
     /////////////////////////////////////////////////////////////////////
@@ -302,6 +424,8 @@ mini_jit::error_t mini_jit::TensorOperation::setup(dtype_t                  dtyp
     m_adjusted_br_size_A = m_dim_id_prim_BR != -1 ? m_strides_in0[m_dim_id_prim_BR] : 1;
     m_adjusted_br_size_B = m_dim_id_prim_BR != -1 ? m_strides_in1[m_dim_id_prim_BR] : 1;
 
+    m_setup_timings.analysis_ns = l_end_phase();
+
     /////////////////////////////////////////////////////////////////////
     // Generate kernels
     /////////////////////////////////////////////////////////////////////
@@ -380,6 +504,122 @@ mini_jit::error_t mini_jit::TensorOperation::setup(dtype_t                  dtyp
         m_kernel_last_touch = m_unary_last_touch.get_kernel();
     }
 
+    m_setup_timings.kernels_ns  = l_end_phase();
+    m_setup_timings.num_kernels = (prim_first_touch != ptype_t::none) +
+                                  (prim_main != ptype_t::none) +
+                                  (prim_last_touch != ptype_t::none);
+
+    /////////////////////////////////////////////////////////////////////
+    // Generate packing kernels
+    /////////////////////////////////////////////////////////////////////
+    m_pack_in0 = false;
+    m_pack_in1 = false;
+    if (m_packing &&
+        (prim_main == ptype_t::gemm || prim_main == ptype_t::brgemm) &&
+        m_strides_in0[m_dim_id_prim_M] == 1 &&
+        m_strides_in1[m_dim_id_prim_K] == 1)
+    {
+        const int64_t l_size_M  = m_dim_sizes[m_dim_id_prim_M];
+        const int64_t l_size_N  = m_dim_sizes[m_dim_id_prim_N];
+        const int64_t l_size_K  = m_dim_sizes[m_dim_id_prim_K];
+        const bool    l_has_br  = prim_main == ptype_t::brgemm && m_dim_sizes[m_dim_id_prim_BR] > 1;
+
+        // only blocks which are not stored contiguously benefit from packing
+        m_pack_in0 = m_adjusted_stride_in0 != l_size_M ||
+                     (l_has_br && m_adjusted_br_size_A != l_size_M * l_size_K);
+        m_pack_in1 = m_adjusted_stride_in1 != l_size_K ||
+                     (l_has_br && m_adjusted_br_size_B != l_size_K * l_size_N);
+
+        if (m_pack_in0)
+        {
+            m_unary_pack_in0.generate(l_size_M,
+                                      l_size_K,
+                                      0,
+                                      dtype,
+                                      ptype_t::identity);
+            m_kernel_pack_in0 = m_unary_pack_in0.get_kernel();
+        }
+        if (m_pack_in1)
+        {
+            m_unary_pack_in1.generate(l_size_K,
+                                      l_size_N,
+                                      0,
+                                      dtype,
+                                      ptype_t::identity);
+            m_kernel_pack_in1 = m_unary_pack_in1.get_kernel();
+        }
+    }
+
+    m_setup_timings.packing_ns = l_end_phase();
+    m_setup_timings.num_kernels += m_pack_in0 + m_pack_in1;
+
+    /////////////////////////////////////////////////////////////////////
+    // Generate remainder kernels
+    /////////////////////////////////////////////////////////////////////
+    // every combination of M and N remainders is an operation on the primitive dimensions only
+    for (int64_t l_variant = 1; l_variant < 4; l_variant++)
+    {
+        m_remainder_ops[l_variant].reset();
+
+        bool l_rem_M = (l_variant & 1) != 0;
+        bool l_rem_N = (l_variant & 2) != 0;
+        if ((l_rem_M && m_dim_id_rem_M == -1) || (l_rem_N && m_dim_id_rem_N == -1))
+        {
+            continue;
+        }
+
+        std::vector<dim_t>   l_dim_types;
+        std::vector<exec_t>  l_exec_types;
+        std::vector<int64_t> l_dim_sizes;
+        std::vector<int64_t> l_strides_in0;
+        std::vector<int64_t> l_strides_in1;
+        std::vector<int64_t> l_strides_out;
+        for (size_t i = 0; i < m_dim_types.size(); ++i)
+        {
+            if (m_exec_types[i] != exec_t::prim)
+            {
+                continue;
+            }
+
+            int64_t l_size = m_dim_sizes[i];
+            if (l_rem_M && static_cast<int64_t>(i) == m_dim_id_prim_M)
+            {
+                l_size = dim_remainders[m_dim_id_rem_M];
+            }
+            else if (l_rem_N && static_cast<int64_t>(i) == m_dim_id_prim_N)
+            {
+                l_size = dim_remainders[m_dim_id_rem_N];
+            }
+
+            l_dim_types.push_back(m_dim_types[i]);
+            l_exec_types.push_back(exec_t::prim);
+            l_dim_sizes.push_back(l_size);
+            l_strides_in0.push_back(m_strides_in0[i]);
+            l_strides_in1.push_back(m_strides_in1[i]);
+            l_strides_out.push_back(m_strides_out[i]);
+        }
+
+        auto l_op = std::make_unique<TensorOperation>();
+        l_op->set_packing(m_packing);
+        error_t l_err = l_op->setup(dtype,
+                                    prim_first_touch,
+                                    prim_main,
+                                    prim_last_touch,
+                                    l_dim_types,
+                                    l_exec_types,
+                                    l_dim_sizes,
+                                    l_strides_in0,
+                                    l_strides_in1,
+                                    l_strides_out);
+        if (l_err != error_t::success)
+        {
+            return l_err;
+        }
+        m_setup_timings.num_kernels += l_op->get_setup_timings().num_kernels;
+        m_remainder_ops[l_variant] = std::move(l_op);
+    }
+    m_setup_timings.remainders_ns = l_end_phase();
+
     m_kernel_first_touch_type = prim_first_touch;
     m_kernel_main_type        = prim_main;
     m_kernel_last_touch_type  = prim_last_touch;
@@ -391,7 +631,7 @@ mini_jit::error_t mini_jit::TensorOperation::setup(dtype_t                  dtyp
 
 void mini_jit::TensorOperation::execute(void const* tensor_in0,
                                         void const* tensor_in1,
-                                        void*       tensor_out)
+                                        void*       tensor_out) const
 {
     if (!m_has_been_setup)
     {
@@ -399,12 +639,15 @@ void mini_jit::TensorOperation::execute(void const* tensor_in0,
         return;
     }
 
+    MLC_TRACE_SCOPE("tensor_operation", "execute");
+
     auto ptr_in0 = static_cast<char const*>(tensor_in0);
     auto ptr_in1 = static_cast<char const*>(tensor_in1);
     auto ptr_out = static_cast<char*>(tensor_out);
 
     if (m_num_parallel_loops == 0)
     {
+        reset_pack_state();
         // No shared loops, execute sequentially
         execute_iter(0,
                      ptr_in0,
@@ -424,12 +667,51 @@ void mini_jit::TensorOperation::execute(void const* tensor_in0,
     }
 }
 
+void mini_jit::TensorOperation::execute_sequential(void const* tensor_in0,
+                                                   void const* tensor_in1,
+                                                   void*       tensor_out) const
+{
+    if (!m_has_been_setup)
+    {
+        std::cerr << "TensorOperation has not been setup. Call setup() before execute_sequential()." << std::endl;
+        return;
+    }
+
+    MLC_TRACE_SCOPE("tensor_operation", "execute_sequential");
+
+    reset_pack_state();
+
+    execute_iter(0,
+                 static_cast<char const*>(tensor_in0),
+                 static_cast<char const*>(tensor_in1),
+                 static_cast<char*>(tensor_out),
+                 true,
+                 true);
+}
+
+mini_jit::PerfCounters::values_t mini_jit::TensorOperation::execute_profiled(void const*   tensor_in0,
+                                                                             void const*   tensor_in1,
+                                                                             void*         tensor_out,
+                                                                             PerfCounters& counters) const
+{
+    counters.start();
+    execute(tensor_in0,
+            tensor_in1,
+            tensor_out);
+    counters.stop();
+
+    PerfCounters::values_t l_values = counters.read();
+    l_values.incomplete             = counters.available() && is_parallel() && omp_get_max_threads() > counters.num_threads();
+    return l_values;
+}
+
 void mini_jit::TensorOperation::execute_iter(int64_t     id_loop,
                                              char const* ptr_in0,
                                              char const* ptr_in1,
                                              char*       ptr_out,
                                              bool        first_access,
-                                             bool        last_access)
+                                             bool        last_access,
+                                             int64_t     variant) const
 {
     // there is only one iteration if the dimension is the first primitive
     const int64_t l_size       = id_loop != m_id_first_primitive_loop ? m_dim_sizes[id_loop] : 1;
@@ -449,6 +731,14 @@ void mini_jit::TensorOperation::execute_iter(int64_t     id_loop,
             is_last  = last_access && (l_iter == m_dim_sizes[id_loop] - 1);
         }
 
+        // the last iteration of a peeled loop uses the remainder kernels
+        int64_t l_variant = variant;
+        if (l_iter == l_size - 1)
+        {
+            l_variant |= id_loop == m_dim_id_rem_M ? 1 : 0;
+            l_variant |= id_loop == m_dim_id_rem_N ? 2 : 0;
+        }
+
         char const* sub_ptr_in0 = ptr_in0 + l_iter * l_stride_in0;
         char const* sub_ptr_in1 = ptr_in1 + l_iter * l_stride_in1;
         char*       sub_ptr_out = ptr_out + l_iter * l_stride_out;
@@ -461,7 +751,17 @@ void mini_jit::TensorOperation::execute_iter(int64_t     id_loop,
                          sub_ptr_in1,
                          sub_ptr_out,
                          is_first,
-                         is_last);
+                         is_last,
+                         l_variant);
+        }
+        else if (l_variant != 0)
+        {
+            m_remainder_ops[l_variant]->execute_iter(0,
+                                                     sub_ptr_in0,
+                                                     sub_ptr_in1,
+                                                     sub_ptr_out,
+                                                     is_first,
+                                                     is_last);
         }
         else
         {
@@ -470,14 +770,38 @@ void mini_jit::TensorOperation::execute_iter(int64_t     id_loop,
                 execute_kernel_first_touch(sub_ptr_out,
                                            m_adjusted_stride_out);
             }
-            execute_kernel_main(sub_ptr_in0,
-                                sub_ptr_in1,
-                                sub_ptr_out,
-                                m_adjusted_stride_in0,
-                                m_adjusted_stride_in1,
-                                m_adjusted_stride_out,
-                                m_adjusted_br_size_A,
-                                m_adjusted_br_size_B);
+            if (m_pack_in0 || m_pack_in1)
+            {
+                int64_t l_ld_A      = m_adjusted_stride_in0;
+                int64_t l_ld_B      = m_adjusted_stride_in1;
+                int64_t l_br_size_A = m_adjusted_br_size_A;
+                int64_t l_br_size_B = m_adjusted_br_size_B;
+                pack_inputs(sub_ptr_in0,
+                            sub_ptr_in1,
+                            l_ld_A,
+                            l_ld_B,
+                            l_br_size_A,
+                            l_br_size_B);
+                execute_kernel_main(sub_ptr_in0,
+                                    sub_ptr_in1,
+                                    sub_ptr_out,
+                                    l_ld_A,
+                                    l_ld_B,
+                                    m_adjusted_stride_out,
+                                    l_br_size_A,
+                                    l_br_size_B);
+            }
+            else
+            {
+                execute_kernel_main(sub_ptr_in0,
+                                    sub_ptr_in1,
+                                    sub_ptr_out,
+                                    m_adjusted_stride_in0,
+                                    m_adjusted_stride_in1,
+                                    m_adjusted_stride_out,
+                                    m_adjusted_br_size_A,
+                                    m_adjusted_br_size_B);
+            }
 
             if (is_last)
             {
@@ -492,7 +816,7 @@ void mini_jit::TensorOperation::execute_iter_parallel(char const* ptr_in0,
                                                       char const* ptr_in1,
                                                       char*       ptr_out,
                                                       bool        first_access,
-                                                      bool        last_access)
+                                                      bool        last_access) const
 {
     // Compute total number of iterations over shared loops
     int64_t l_size_parallel_loops = 1;
@@ -503,47 +827,62 @@ void mini_jit::TensorOperation::execute_iter_parallel(char const* ptr_in0,
 
     int64_t l_first_id_loop = (m_id_first_seq_loop != -1) ? m_id_first_seq_loop : m_id_first_primitive_loop;
 
-#pragma omp parallel for
-    for (int64_t l_it_all = 0; l_it_all < l_size_parallel_loops; ++l_it_all)
+#pragma omp parallel
     {
-        // Unflatten l_it_all into loop indices
-        int64_t              remainder = l_it_all;
-        std::vector<int64_t> loop_indices(m_shared_loop_ids.size());
-
-        for (int64_t i = m_shared_loop_ids.size() - 1; i >= 0; --i)
+        // ends before the barrier, so the spans of the threads show the load imbalance
+        MLC_TRACE_SCOPE("tensor_operation", "worker");
+#pragma omp for nowait
+        for (int64_t l_it_all = 0; l_it_all < l_size_parallel_loops; ++l_it_all)
         {
-            loop_indices[i] = remainder % m_shared_loop_sizes[i];
-            remainder /= m_shared_loop_sizes[i];
-        }
+            // Unflatten l_it_all into loop indices
+            int64_t              remainder = l_it_all;
+            std::vector<int64_t> loop_indices(m_shared_loop_ids.size());
 
-        // Compute pointer offsets using strides and loop indices
-        char const* sub_ptr_in0 = ptr_in0;
-        char const* sub_ptr_in1 = ptr_in1;
-        char*       sub_ptr_out = ptr_out;
+            for (int64_t i = m_shared_loop_ids.size() - 1; i >= 0; --i)
+            {
+                loop_indices[i] = remainder % m_shared_loop_sizes[i];
+                remainder /= m_shared_loop_sizes[i];
+            }
 
-        const int64_t dtype_sz = dtype_size();
-        for (size_t i = 0; i < m_shared_loop_ids.size(); ++i)
-        {
-            const int64_t dim_id = m_shared_loop_ids[i];
-            const int64_t idx    = loop_indices[i];
+            // Compute pointer offsets using strides and loop indices
+            char const* sub_ptr_in0 = ptr_in0;
+            char const* sub_ptr_in1 = ptr_in1;
+            char*       sub_ptr_out = ptr_out;
 
-            sub_ptr_in0 += idx * m_strides_in0[dim_id] * dtype_sz;
-            sub_ptr_in1 += idx * m_strides_in1[dim_id] * dtype_sz;
-            sub_ptr_out += idx * m_strides_out[dim_id] * dtype_sz;
-        }
+            const int64_t dtype_sz  = dtype_size();
+            int64_t       l_variant = 0;
+            for (size_t i = 0; i < m_shared_loop_ids.size(); ++i)
+            {
+                const int64_t dim_id = m_shared_loop_ids[i];
+                const int64_t idx    = loop_indices[i];
+
+                sub_ptr_in0 += idx * m_strides_in0[dim_id] * dtype_sz;
+                sub_ptr_in1 += idx * m_strides_in1[dim_id] * dtype_sz;
+                sub_ptr_out += idx * m_strides_out[dim_id] * dtype_sz;
+
+                // the last iteration of a peeled loop uses the remainder kernels
+                if (idx == m_shared_loop_sizes[i] - 1)
+                {
+                    l_variant |= dim_id == m_dim_id_rem_M ? 1 : 0;
+                    l_variant |= dim_id == m_dim_id_rem_N ? 2 : 0;
+                }
+            }
 
-        // Call remaining loops
-        execute_iter(l_first_id_loop,
-                     sub_ptr_in0,
-                     sub_ptr_in1,
-                     sub_ptr_out,
-                     first_access,
-                     last_access);
+            // Call remaining loops
+            reset_pack_state();
+            execute_iter(l_first_id_loop,
+                         sub_ptr_in0,
+                         sub_ptr_in1,
+                         sub_ptr_out,
+                         first_access,
+                         last_access,
+                         l_variant);
+        }
     }
 }
 
 void mini_jit::TensorOperation::execute_kernel_first_touch(char*   ptr_out,
-                                                           int64_t ldOut)
+                                                           int64_t ldOut) const
 {
     if (m_kernel_first_touch_type == ptype_t::zero)
     {
@@ -574,7 +913,7 @@ void mini_jit::TensorOperation::execute_kernel_main(char const* ptr_in0,
                                                     int64_t     ldB,
                                                     int64_t     ldC,
                                                     int64_t     br_size_A,
-                                                    int64_t     br_size_B)
+                                                    int64_t     br_size_B) const
 {
     if (m_kernel_main_type == ptype_t::gemm)
     {
@@ -620,7 +959,7 @@ void mini_jit::TensorOperation::execute_kernel_main(char const* ptr_in0,
 }
 
 void mini_jit::TensorOperation::execute_kernel_last_touch(char*   ptr_out,
-                                                          int64_t ldOut)
+                                                          int64_t ldOut) const
 {
     if (m_kernel_last_touch_type == ptype_t::zero)
     {
@@ -644,4 +983,91 @@ void mini_jit::TensorOperation::execute_kernel_last_touch(char*   ptr_out,
                             ldOut,
                             m_unary_last_touch.get_extra());
     }
-}
\ No newline at end of file
+}
+
+void mini_jit::TensorOperation::pack_inputs(char const*& ptr_in0,
+                                            char const*& ptr_in1,
+                                            int64_t&     ldA,
+                                            int64_t&     ldB,
+                                            int64_t&     br_size_A,
+                                            int64_t&     br_size_B) const
+{
+    const int64_t l_size_M  = m_dim_sizes[m_dim_id_prim_M];
+    const int64_t l_size_N  = m_dim_sizes[m_dim_id_prim_N];
+    const int64_t l_size_K  = m_dim_sizes[m_dim_id_prim_K];
+    const int64_t l_size_BR = m_kernel_main_type == ptype_t::brgemm ? m_dim_sizes[m_dim_id_prim_BR] : 1;
+    const int64_t dtype_sz  = dtype_size();
+
+    pack_state_t& l_state = t_pack_state;
+    if (l_state.owner != this)
+    {
+        reset_pack_state();
+        l_state.owner = this;
+    }
+
+    if (m_pack_in0)
+    {
+        if (l_state.src_in0 != ptr_in0)
+        {
+            l_state.buffer_in0.resize(l_size_M * l_size_K * l_size_BR * dtype_sz);
+            for (int64_t l_br = 0; l_br < l_size_BR; l_br++)
+            {
+                m_kernel_pack_in0(ptr_in0 + l_br * br_size_A * dtype_sz,
+                                  l_state.buffer_in0.data() + l_br * l_size_M * l_size_K * dtype_sz,
+                                  ldA,
+                                  l_size_M,
+                                  m_unary_pack_in0.get_extra());
+            }
+            l_state.src_in0 = ptr_in0;
+        }
+        ptr_in0   = l_state.buffer_in0.data();
+        ldA       = l_size_M;
+        br_size_A = l_size_M * l_size_K;
+    }
+
+    if (m_pack_in1)
+    {
+        if (l_state.src_in1 != ptr_in1)
+        {
+            l_state.buffer_in1.resize(l_size_K * l_size_N * l_size_BR * dtype_sz);
+            for (int64_t l_br = 0; l_br < l_size_BR; l_br++)
+            {
+                m_kernel_pack_in1(ptr_in1 + l_br * br_size_B * dtype_sz,
+                                  l_state.buffer_in1.data() + l_br * l_size_K * l_size_N * dtype_sz,
+                                  ldB,
+                                  l_size_K,
+                                  m_unary_pack_in1.get_extra());
+            }
+            l_state.src_in1 = ptr_in1;
+        }
+        ptr_in1   = l_state.buffer_in1.data();
+        ldB       = l_size_K;
+        br_size_B = l_size_K * l_size_N;
+    }
+}
+
+std::size_t mini_jit::TensorOperation::get_code_size() const
+{
+    std::size_t l_code_size = m_brgemm_main.get_code_size() +
+                              m_unary_first_touch.get_code_size() +
+                              m_unary_main.get_code_size() +
+                              m_binary_main.get_code_size() +
+                              m_unary_last_touch.get_code_size();
+    // pack kernels of an earlier setup are kept, only the ones in use are counted
+    if (m_pack_in0)
+    {
+        l_code_size += m_unary_pack_in0.get_code_size();
+    }
+    if (m_pack_in1)
+    {
+        l_code_size += m_unary_pack_in1.get_code_size();
+    }
+    for (auto const& l_op : m_remainder_ops)
+    {
+        if (l_op)
+        {
+            l_code_size += l_op->get_code_size();
+        }
+    }
+    return l_code_size;
+}
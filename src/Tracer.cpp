@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <mlc/Tracer.h>
+#include <mlc/json.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace
+{
+    /**
+     * Write a time in nanoseconds as the microseconds of a trace event.
+     */
+    void write_us(std::ofstream& stream,
+                  int64_t        ns)
+    {
+        stream << ns / 1000 << "." << std::setw(3) << std::setfill('0') << ns % 1000;
+    }
+} // namespace
+
+mini_jit::Tracer::Scope::Scope(char const* category,
+                               char const* name)
+{
+    if (Tracer::instance().enabled())
+    {
+        m_category                  = category;
+        std::strncpy(m_name, name, MAX_NAME_LENGTH - 1);
+        m_name[MAX_NAME_LENGTH - 1] = '\0';
+        m_start_ns                  = now_ns();
+    }
+}
+
+mini_jit::Tracer::Scope::~Scope()
+{
+    if (m_category != nullptr)
+    {
+        Tracer::instance().record(m_category, m_name, m_start_ns, now_ns() - m_start_ns);
+    }
+}
+
+mini_jit::Tracer::Tracer()
+{
+    char const* l_path = std::getenv("MLC_TRACE");
+    if (l_path != nullptr && l_path[0] != '\0')
+    {
+        m_exit_path = l_path;
+        enable();
+    }
+}
+
+mini_jit::Tracer::~Tracer()
+{
+    if (m_exit_path.empty())
+    {
+        return;
+    }
+    // tracing should never break the application, so a failed write only loses the trace
+    try
+    {
+        write_chrome_trace(m_exit_path);
+    }
+    catch (std::runtime_error const&)
+    {
+    }
+}
+
+mini_jit::Tracer& mini_jit::Tracer::instance()
+{
+    static Tracer l_instance;
+    return l_instance;
+}
+
+int64_t mini_jit::Tracer::now_ns()
+{
+    static auto const l_epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_epoch).count();
+}
+
+void mini_jit::Tracer::enable(std::size_t capacity)
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("Trace capacity must be greater than zero");
+    }
+    m_capacity.store(capacity, std::memory_order_relaxed);
+    m_enabled.store(true, std::memory_order_relaxed);
+}
+
+void mini_jit::Tracer::disable()
+{
+    m_enabled.store(false, std::memory_order_relaxed);
+}
+
+void mini_jit::Tracer::clear()
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    for (std::unique_ptr<thread_buffer_t>& l_buffer : m_buffers)
+    {
+        l_buffer->size.store(0, std::memory_order_relaxed);
+        l_buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+mini_jit::Tracer::thread_buffer_t& mini_jit::Tracer::thread_buffer()
+{
+    // the buffers are owned by the single tracer instance and never freed before it
+    thread_local thread_buffer_t* l_buffer = nullptr;
+    if (l_buffer == nullptr)
+    {
+        std::unique_ptr<thread_buffer_t> l_new = std::make_unique<thread_buffer_t>();
+        l_new->spans.resize(m_capacity.load(std::memory_order_relaxed));
+
+        std::lock_guard<std::mutex> l_lock(m_mutex);
+        l_new->tid = static_cast<int64_t>(m_buffers.size());
+        l_buffer   = l_new.get();
+        m_buffers.push_back(std::move(l_new));
+    }
+    return *l_buffer;
+}
+
+void mini_jit::Tracer::record(char const* category,
+                              char const* name,
+                              int64_t     start_ns,
+                              int64_t     duration_ns)
+{
+    thread_buffer_t& l_buffer = thread_buffer();
+
+    // only this thread writes the buffer, readers see the span once the size is published
+    std::size_t l_index = l_buffer.size.load(std::memory_order_relaxed);
+    if (l_index >= l_buffer.spans.size())
+    {
+        l_buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    span_t& l_span = l_buffer.spans[l_index];
+    std::strncpy(l_span.name, name, MAX_NAME_LENGTH - 1);
+    l_span.name[MAX_NAME_LENGTH - 1] = '\0';
+    l_span.category                  = category;
+    l_span.start_ns                  = start_ns;
+    l_span.duration_ns               = duration_ns;
+
+    l_buffer.size.store(l_index + 1, std::memory_order_release);
+}
+
+std::vector<std::pair<int64_t, mini_jit::Tracer::span_t>> mini_jit::Tracer::get_spans()
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+
+    std::vector<std::pair<int64_t, span_t>> l_spans;
+    for (std::unique_ptr<thread_buffer_t>& l_buffer : m_buffers)
+    {
+        std::size_t l_size = l_buffer->size.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < l_size; i++)
+        {
+            l_spans.emplace_back(l_buffer->tid, l_buffer->spans[i]);
+        }
+    }
+    return l_spans;
+}
+
+std::size_t mini_jit::Tracer::get_dropped()
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+
+    std::size_t l_dropped = 0;
+    for (std::unique_ptr<thread_buffer_t>& l_buffer : m_buffers)
+    {
+        l_dropped += l_buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return l_dropped;
+}
+
+void mini_jit::Tracer::write_chrome_trace(std::string const& path)
+{
+    std::vector<std::pair<int64_t, span_t>> l_spans   = get_spans();
+    std::size_t                             l_dropped = get_dropped();
+
+    std::ofstream l_file(path);
+    if (!l_file.is_open())
+    {
+        throw std::runtime_error("Failed to open trace: " + path);
+    }
+
+    int64_t l_pid         = static_cast<int64_t>(getpid());
+    int64_t l_num_threads = 0;
+    for (std::pair<int64_t, span_t> const& l_span : l_spans)
+    {
+        l_num_threads = std::max(l_num_threads, l_span.first + 1);
+    }
+
+    char const* l_separator = "\n  ";
+    l_file << "{\"traceEvents\": [";
+    for (int64_t l_tid = 0; l_tid < l_num_threads; l_tid++)
+    {
+        l_file << l_separator << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << l_pid
+               << ", \"tid\": " << l_tid << ", \"args\": {\"name\": \"thread " << l_tid << "\"}}";
+        l_separator = ",\n  ";
+    }
+    for (std::pair<int64_t, span_t> const& l_span : l_spans)
+    {
+        l_file << l_separator << "{\"name\": \"" << escape_json(l_span.second.name) << "\""
+               << ", \"cat\": \"" << escape_json(l_span.second.category) << "\""
+               << ", \"ph\": \"X\", \"ts\": ";
+        write_us(l_file, l_span.second.start_ns);
+        l_file << ", \"dur\": ";
+        write_us(l_file, l_span.second.duration_ns);
+        l_file << ", \"pid\": " << l_pid << ", \"tid\": " << l_span.first << "}";
+        l_separator = ",\n  ";
+    }
+    l_file << "\n],\n\"displayTimeUnit\": \"ns\",\n\"otherData\": {\"dropped_spans\": " << l_dropped << "}}\n";
+
+    if (!l_file)
+    {
+        throw std::runtime_error("Failed to write trace: " + path);
+    }
+}
@@ -38,6 +38,7 @@ mini_jit::error_t mini_jit::Unary::generate(uint32_t m,
 
     reset_kernel();
     m_extra = nullptr; // reset extra/context pointer
+    m_kernel->set_name(to_string(ptype) + (trans_b ? "_trans" : "") + "_m" + std::to_string(m) + "_n" + std::to_string(n));
 
     switch (ptype)
     {
@@ -152,6 +153,11 @@ mini_jit::Unary::kernel_t mini_jit::Unary::get_kernel() const
     return reinterpret_cast<kernel_t>(const_cast<void*>(m_kernel->get_kernel()));
 }
 
+std::size_t mini_jit::Unary::get_code_size() const
+{
+    return m_kernel ? m_kernel->get_size() : 0;
+}
+
 void mini_jit::Unary::set_extra(void* extra)
 {
     m_extra = extra;
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <mlc/benchmarks/Benchmark.h>
+#include <omp.h>
+#include <sstream>
+
+/**
+ * Writes the count of an event, nothing if the event was not counted.
+ */
+static void write_count(std::ostream&                           stream,
+                        mini_jit::PerfCounters::values_t const& counters,
+                        mini_jit::PerfCounters::event_t         event)
+{
+    if (counters.has(event))
+    {
+        stream << counters.get(event);
+    }
+}
+
+mini_jit::Benchmark::benchmark_statistics mini_jit::Benchmark::compute_statistics(std::vector<double> samples,
+                                                                                  long                reps_per_sample,
+                                                                                  long                warmup_reps)
+{
+    benchmark_statistics l_stats;
+    l_stats.numSamples      = static_cast<long>(samples.size());
+    l_stats.repsPerSample   = reps_per_sample;
+    l_stats.warmupReps      = warmup_reps;
+    l_stats.numThreads      = omp_get_max_threads();
+    l_stats.cpuFrequencyMHz = get_cpu_frequency();
+
+    if (samples.empty() || reps_per_sample <= 0)
+    {
+        return l_stats;
+    }
+
+    // time per repetition of each batch
+    for (double& l_sample : samples)
+    {
+        l_sample /= static_cast<double>(reps_per_sample);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    double l_sum = 0.0;
+    for (double l_sample : samples)
+    {
+        l_sum += l_sample;
+    }
+    l_stats.mean = l_sum / samples.size();
+
+    double l_sum_squares = 0.0;
+    for (double l_sample : samples)
+    {
+        l_sum_squares += (l_sample - l_stats.mean) * (l_sample - l_stats.mean);
+    }
+    l_stats.stddev = samples.size() > 1 ? std::sqrt(l_sum_squares / (samples.size() - 1)) : 0.0;
+
+    l_stats.median = percentile(samples, 50.0);
+    l_stats.p5     = percentile(samples, 5.0);
+    l_stats.p95    = percentile(samples, 95.0);
+    l_stats.min    = samples.front();
+    l_stats.max    = samples.back();
+
+    return l_stats;
+}
+
+double mini_jit::Benchmark::percentile(std::vector<double> const& sorted_values,
+                                       double                     percentile)
+{
+    if (sorted_values.empty())
+    {
+        return 0.0;
+    }
+
+    double l_position = std::clamp(percentile, 0.0, 100.0) / 100.0 * (sorted_values.size() - 1);
+    size_t l_lower    = static_cast<size_t>(l_position);
+    size_t l_upper    = std::min(l_lower + 1, sorted_values.size() - 1);
+    double l_weight   = l_position - l_lower;
+
+    return sorted_values[l_lower] * (1.0 - l_weight) + sorted_values[l_upper] * l_weight;
+}
+
+mini_jit::Benchmark::benchmark_roofline mini_jit::Benchmark::compute_roofline(benchmark_result const& result,
+                                                                              double                  peak_gflops,
+                                                                              double                  peak_gibps)
+{
+    constexpr double GIB = 1024.0 * 1024.0 * 1024.0;
+
+    benchmark_roofline l_roofline;
+    if (result.totalDataProcessed > 0.0)
+    {
+        l_roofline.arithmeticIntensity = result.totalOperations / (result.totalDataProcessed * GIB);
+    }
+    if (peak_gflops <= 0.0 || peak_gibps <= 0.0)
+    {
+        return l_roofline;
+    }
+
+    // the attainable performance is the minimum of the compute roof and the bandwidth roof,
+    // kernels which do not move data are only limited by the compute roof
+    double l_bandwidth_gflops   = result.totalDataProcessed > 0.0 ? l_roofline.arithmeticIntensity * peak_gibps * GIB / 1e9
+                                                                  : std::numeric_limits<double>::infinity();
+    l_roofline.peakGflops       = peak_gflops;
+    l_roofline.peakGibps        = peak_gibps;
+    l_roofline.memoryBound      = l_bandwidth_gflops < peak_gflops;
+    l_roofline.attainableGflops = std::min(peak_gflops, l_bandwidth_gflops);
+    l_roofline.fractionOfPeak   = l_roofline.memoryBound ? result.gibps / peak_gibps : result.gflops / peak_gflops;
+
+    return l_roofline;
+}
+
+double mini_jit::Benchmark::get_cpu_frequency()
+{
+    // Linux with cpufreq reports kHz
+    std::ifstream l_cpufreq("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq");
+    double        l_khz = 0.0;
+    if (l_cpufreq >> l_khz && l_khz > 0.0)
+    {
+        return l_khz / 1000.0;
+    }
+
+    // fall back to the first frequency listed in /proc/cpuinfo
+    std::ifstream l_cpuinfo("/proc/cpuinfo");
+    std::string   l_line;
+    while (std::getline(l_cpuinfo, l_line))
+    {
+        if (l_line.rfind("cpu MHz", 0) == 0)
+        {
+            size_t l_colon = l_line.find(':');
+            if (l_colon != std::string::npos)
+            {
+                return std::stod(l_line.substr(l_colon + 1));
+            }
+        }
+    }
+
+    return 0.0;
+}
+
+void mini_jit::Benchmark::write_csv_header(std::ostream& stream)
+{
+    stream << "name,num_reps,elapsed_seconds,total_operations,gflops,total_data_gib,gibps,"
+           << "num_samples,reps_per_sample,warmup_reps,mean,median,p5,p95,stddev,min,max,"
+           << "num_threads,cpu_frequency_mhz,"
+           << "arithmetic_intensity,peak_gflops,peak_gibps,attainable_gflops,fraction_of_peak,bound,"
+           << "cycles,instructions,ipc,l1d_misses,llc_misses,branch_misses,counters_incomplete\n";
+}
+
+void mini_jit::Benchmark::write_csv(std::ostream&           stream,
+                                    std::string const&      name,
+                                    benchmark_result const& result)
+{
+    using event_t = PerfCounters::event_t;
+
+    benchmark_statistics const&   l_stats    = result.statistics;
+    benchmark_roofline const&     l_roofline = result.roofline;
+    PerfCounters::values_t const& l_counters = l_stats.counters;
+    stream << name << ","
+           << result.numReps << ","
+           << result.elapsedSeconds << ","
+           << result.totalOperations << ","
+           << result.gflops << ","
+           << result.totalDataProcessed << ","
+           << result.gibps << ","
+           << l_stats.numSamples << ","
+           << l_stats.repsPerSample << ","
+           << l_stats.warmupReps << ","
+           << l_stats.mean << ","
+           << l_stats.median << ","
+           << l_stats.p5 << ","
+           << l_stats.p95 << ","
+           << l_stats.stddev << ","
+           << l_stats.min << ","
+           << l_stats.max << ","
+           << l_stats.numThreads << ","
+           << l_stats.cpuFrequencyMHz << ","
+           << l_roofline.arithmeticIntensity << ","
+           << l_roofline.peakGflops << ","
+           << l_roofline.peakGibps << ","
+           << l_roofline.attainableGflops << ","
+           << l_roofline.fractionOfPeak << ","
+           << (l_roofline.peakGflops > 0.0 ? (l_roofline.memoryBound ? "memory" : "compute") : "") << ",";
+
+    // hardware events per repetition, empty if not counted
+    write_count(stream, l_counters, event_t::cycles);
+    stream << ",";
+    write_count(stream, l_counters, event_t::instructions);
+    stream << ",";
+    if (l_counters.has(event_t::cycles) && l_counters.has(event_t::instructions))
+    {
+        stream << l_counters.ipc();
+    }
+    stream << ",";
+    write_count(stream, l_counters, event_t::l1d_misses);
+    stream << ",";
+    write_count(stream, l_counters, event_t::llc_misses);
+    stream << ",";
+    write_count(stream, l_counters, event_t::branch_misses);
+    stream << "," << (l_counters.incomplete ? 1 : 0) << "\n";
+}
+
+std::string mini_jit::Benchmark::to_json(std::string const&      name,
+                                         benchmark_result const& result)
+{
+    benchmark_statistics const& l_stats    = result.statistics;
+    benchmark_roofline const&   l_roofline = result.roofline;
+
+    std::ostringstream l_json;
+    l_json.precision(9);
+    l_json << "{\"name\": \"" << name << "\""
+           << ", \"num_reps\": " << result.numReps
+           << ", \"elapsed_seconds\": " << result.elapsedSeconds
+           << ", \"total_operations\": " << result.totalOperations
+           << ", \"gflops\": " << result.gflops
+           << ", \"total_data_gib\": " << result.totalDataProcessed
+           << ", \"gibps\": " << result.gibps
+           << ", \"statistics\": {\"num_samples\": " << l_stats.numSamples
+           << ", \"reps_per_sample\": " << l_stats.repsPerSample
+           << ", \"warmup_reps\": " << l_stats.warmupReps
+           << ", \"mean\": " << l_stats.mean
+           << ", \"median\": " << l_stats.median
+           << ", \"p5\": " << l_stats.p5
+           << ", \"p95\": " << l_stats.p95
+           << ", \"stddev\": " << l_stats.stddev
+           << ", \"min\": " << l_stats.min
+           << ", \"max\": " << l_stats.max << "}"
+           << ", \"num_threads\": " << l_stats.numThreads
+           << ", \"cpu_frequency_mhz\": " << l_stats.cpuFrequencyMHz
+           << ", \"roofline\": {\"arithmetic_intensity\": " << l_roofline.arithmeticIntensity
+           << ", \"peak_gflops\": " << l_roofline.peakGflops
+           << ", \"peak_gibps\": " << l_roofline.peakGibps
+           << ", \"attainable_gflops\": " << l_roofline.attainableGflops
+           << ", \"fraction_of_peak\": " << l_roofline.fractionOfPeak
+           << ", \"bound\": " << (l_roofline.peakGflops > 0.0 ? (l_roofline.memoryBound ? "\"memory\"" : "\"compute\"") : "null") << "}"
+           << ", \"counters\": {";
+
+    // hardware events per repetition, null if not counted
+    PerfCounters::values_t const& l_counters = l_stats.counters;
+    for (std::size_t i = 0; i < PerfCounters::NUM_EVENTS; i++)
+    {
+        PerfCounters::event_t l_event = static_cast<PerfCounters::event_t>(i);
+        l_json << (i > 0 ? ", " : "") << "\"" << PerfCounters::name(l_event) << "\": ";
+        if (l_counters.has(l_event))
+        {
+            l_json << l_counters.get(l_event);
+        }
+        else
+        {
+            l_json << "null";
+        }
+    }
+    l_json << ", \"ipc\": ";
+    if (l_counters.has(PerfCounters::event_t::cycles) && l_counters.has(PerfCounters::event_t::instructions))
+    {
+        l_json << l_counters.ipc();
+    }
+    else
+    {
+        l_json << "null";
+    }
+    l_json << ", \"incomplete\": " << (l_counters.incomplete ? "true" : "false");
+    l_json << "}}";
+    return l_json.str();
+}
@@ -0,0 +1,809 @@
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mlc/benchmarks/BenchmarkRunner.h>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * Remove leading and trailing whitespace.
+     */
+    std::string trim(std::string const& text)
+    {
+        size_t l_begin = text.find_first_not_of(" \t\r\n");
+        if (l_begin == std::string::npos)
+        {
+            return "";
+        }
+        size_t l_end = text.find_last_not_of(" \t\r\n");
+        return text.substr(l_begin, l_end - l_begin + 1);
+    }
+
+    /**
+     * Parse a single integer, the whole text has to be consumed.
+     */
+    int64_t parse_integer(std::string const& text)
+    {
+        size_t  l_pos   = 0;
+        int64_t l_value = 0;
+        try
+        {
+            l_value = std::stoll(text, &l_pos);
+        }
+        catch (std::exception const&)
+        {
+            throw std::invalid_argument("Error: Invalid integer: \"" + text + "\"");
+        }
+        if (l_pos != text.size())
+        {
+            throw std::invalid_argument("Error: Invalid integer: \"" + text + "\"");
+        }
+        return l_value;
+    }
+
+    /**
+     * Parse a single non-negative floating point number, the whole text has to be consumed.
+     *
+     * @param text The number.
+     * @param what Description of the number for the error message.
+     * @param allow_zero Whether zero is a valid value.
+     */
+    double parse_number(std::string const& text,
+                        std::string const& what,
+                        bool               allow_zero)
+    {
+        size_t l_pos   = 0;
+        double l_value = 0.0;
+        try
+        {
+            l_value = std::stod(text, &l_pos);
+        }
+        catch (std::exception const&)
+        {
+            l_pos = std::string::npos;
+        }
+        if (l_pos != text.size() || l_value < 0.0 || (l_value == 0.0 && !allow_zero))
+        {
+            throw std::invalid_argument("Error: Invalid " + what + ": \"" + text + "\"");
+        }
+        return l_value;
+    }
+
+    /**
+     * Write the hardware events per repetition, n/a for events which were not counted.
+     */
+    void write_counters(std::ostream&                           stream,
+                        mini_jit::PerfCounters::values_t const& counters)
+    {
+        using event_t = mini_jit::PerfCounters::event_t;
+
+        auto l_count = [&](event_t event)
+        {
+            return counters.has(event) ? std::to_string(static_cast<int64_t>(counters.get(event))) : std::string("n/a");
+        };
+        stream << "Cycles, instructions per rep, IPC:    " << l_count(event_t::cycles) << ", " << l_count(event_t::instructions)
+               << ", " << counters.ipc() << std::endl;
+        stream << "L1D, LLC, branch misses per rep:      " << l_count(event_t::l1d_misses) << ", " << l_count(event_t::llc_misses)
+               << ", " << l_count(event_t::branch_misses) << std::endl;
+        if (counters.incomplete)
+        {
+            stream << "Counters are incomplete, the function ran on more threads than were counted" << std::endl;
+        }
+    }
+
+    /**
+     * Current local time as a run name, e.g. 20250101_120000.
+     */
+    std::string timestamp()
+    {
+        std::time_t l_now = std::time(nullptr);
+        std::tm     l_tm  = *std::localtime(&l_now);
+        char        l_buffer[32];
+        std::strftime(l_buffer, sizeof(l_buffer), "%Y%m%d_%H%M%S", &l_tm);
+        return l_buffer;
+    }
+} // namespace
+
+void mini_jit::benchmarks::BenchmarkRunner::add(std::string const&           name,
+                                                std::string const&           description,
+                                                std::vector<params_t> const& defaults,
+                                                factory_t                    factory)
+{
+    for (entry_t const& l_entry : m_entries)
+    {
+        if (l_entry.name == name)
+        {
+            throw std::invalid_argument("Error: Benchmark \"" + name + "\" is already registered");
+        }
+    }
+    if (defaults.empty())
+    {
+        throw std::invalid_argument("Error: Benchmark \"" + name + "\" needs at least one default parameter point");
+    }
+    m_entries.push_back({name, description, defaults, std::move(factory)});
+}
+
+void mini_jit::benchmarks::BenchmarkRunner::set_option(std::string const& key,
+                                                       std::string const& value)
+{
+    std::string l_key = key;
+    std::replace(l_key.begin(), l_key.end(), '-', '_');
+
+    if (l_key == "filter")
+    {
+        try
+        {
+            std::regex l_check(value);
+        }
+        catch (std::regex_error const&)
+        {
+            throw std::invalid_argument("Error: Invalid filter: \"" + value + "\"");
+        }
+        m_filter = value;
+    }
+    else if (l_key == "run_time")
+    {
+        m_run_time = parse_number(value, "run time", false);
+    }
+    else if (l_key == "output_dir")
+    {
+        m_output_dir = value;
+    }
+    else if (l_key == "name")
+    {
+        if (value.empty() || value.find('/') != std::string::npos)
+        {
+            throw std::invalid_argument("Error: Invalid run name: \"" + value + "\"");
+        }
+        m_run_name = value;
+    }
+    else if (l_key == "config")
+    {
+        load_config(value);
+    }
+    else if (l_key == "baseline")
+    {
+        m_baseline = value;
+    }
+    else if (l_key == "update_baseline")
+    {
+        m_update_baseline = value != "0" && value != "false";
+    }
+    else if (l_key == "tolerance")
+    {
+        m_tolerance = parse_number(value, "tolerance", true);
+    }
+    else if (l_key == "peak_gflops")
+    {
+        m_peak_gflops = parse_number(value, "peak GFLOPS", true);
+    }
+    else if (l_key == "peak_gibps")
+    {
+        m_peak_gibps = parse_number(value, "peak bandwidth", true);
+    }
+    else if (l_key == "roofline")
+    {
+        m_roofline = value != "0" && value != "false";
+    }
+    else if (l_key == "perf_counters")
+    {
+        m_perf_counters = value != "0" && value != "false";
+    }
+    else if (l_key == "list")
+    {
+        m_list = value != "0" && value != "false";
+    }
+    else if (l_key == "help")
+    {
+        m_help = value != "0" && value != "false";
+    }
+    else
+    {
+        // every other option overrides a parameter
+        bool l_known = false;
+        for (entry_t const& l_entry : m_entries)
+        {
+            l_known |= l_entry.defaults.front().count(l_key) > 0;
+        }
+        if (!l_known)
+        {
+            throw std::invalid_argument("Error: Unknown option: \"" + key + "\"");
+        }
+        m_sweep[l_key] = parse_values(value);
+    }
+}
+
+void mini_jit::benchmarks::BenchmarkRunner::set_probes(probe_t compute,
+                                                       probe_t bandwidth)
+{
+    m_compute_probe   = std::move(compute);
+    m_bandwidth_probe = std::move(bandwidth);
+}
+
+void mini_jit::benchmarks::BenchmarkRunner::parse_arguments(int                argc,
+                                                            char const* const* argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string l_arg = argv[i];
+
+        if (l_arg == "help" || l_arg == "-h" || l_arg == "--help")
+        {
+            m_help = true;
+        }
+        else if (l_arg == "--list")
+        {
+            m_list = true;
+        }
+        else if (l_arg == "--update-baseline" || l_arg == "--update_baseline")
+        {
+            m_update_baseline = true;
+        }
+        else if (l_arg == "--roofline")
+        {
+            m_roofline = true;
+        }
+        else if (l_arg == "--perf-counters" || l_arg == "--perf_counters")
+        {
+            m_perf_counters = true;
+        }
+        else if (l_arg.rfind("--", 0) == 0)
+        {
+            std::string l_key   = l_arg.substr(2);
+            std::string l_value = "";
+            size_t      l_equal = l_key.find('=');
+            if (l_equal != std::string::npos)
+            {
+                l_value = l_key.substr(l_equal + 1);
+                l_key   = l_key.substr(0, l_equal);
+            }
+            else if (i + 1 < argc)
+            {
+                l_value = argv[++i];
+            }
+            else
+            {
+                throw std::invalid_argument("Error: Missing value of option: \"" + l_arg + "\"");
+            }
+            set_option(l_key, l_value);
+        }
+        else
+        {
+            bool l_known = false;
+            for (entry_t const& l_entry : m_entries)
+            {
+                l_known |= l_entry.name == l_arg || l_entry.name.rfind(l_arg + "/", 0) == 0;
+            }
+            if (!l_known)
+            {
+                throw std::invalid_argument("Error: Unknown benchmark: \"" + l_arg + "\"");
+            }
+            m_names.push_back(l_arg);
+        }
+    }
+}
+
+void mini_jit::benchmarks::BenchmarkRunner::load_config(std::string const& path)
+{
+    std::ifstream l_file(path);
+    if (!l_file.is_open())
+    {
+        throw std::runtime_error("Error: Could not open config file: " + path);
+    }
+
+    std::string l_line;
+    int64_t     l_line_number = 0;
+    while (std::getline(l_file, l_line))
+    {
+        l_line_number++;
+        l_line = trim(l_line.substr(0, l_line.find('#')));
+        if (l_line.empty())
+        {
+            continue;
+        }
+
+        size_t l_equal = l_line.find('=');
+        if (l_equal == std::string::npos)
+        {
+            throw std::invalid_argument("Error: Expected key = value in " + path + ":" + std::to_string(l_line_number));
+        }
+        set_option(trim(l_line.substr(0, l_equal)),
+                   trim(l_line.substr(l_equal + 1)));
+    }
+}
+
+std::vector<int64_t> mini_jit::benchmarks::BenchmarkRunner::parse_values(std::string const& text)
+{
+    std::vector<int64_t> l_values;
+    std::stringstream    l_stream(text);
+    std::string          l_item;
+    while (std::getline(l_stream, l_item, ','))
+    {
+        l_item = trim(l_item);
+
+        size_t l_colon = l_item.find(':');
+        if (l_colon == std::string::npos)
+        {
+            l_values.push_back(parse_integer(l_item));
+            continue;
+        }
+
+        // range start:end[:step]
+        size_t      l_colon_step = l_item.find(':', l_colon + 1);
+        int64_t     l_start      = parse_integer(trim(l_item.substr(0, l_colon)));
+        int64_t     l_end        = parse_integer(trim(l_item.substr(l_colon + 1, l_colon_step - l_colon - 1)));
+        std::string l_step       = l_colon_step == std::string::npos ? "1" : trim(l_item.substr(l_colon_step + 1));
+        bool        l_multiply   = !l_step.empty() && l_step[0] == '*';
+        int64_t     l_step_value = parse_integer(l_multiply ? l_step.substr(1) : l_step);
+
+        if (l_end < l_start || (l_multiply && (l_step_value < 2 || l_start < 1)) || (!l_multiply && l_step_value < 1))
+        {
+            throw std::invalid_argument("Error: Invalid range: \"" + l_item + "\"");
+        }
+        for (int64_t l_value = l_start; l_value <= l_end; l_value = l_multiply ? l_value * l_step_value : l_value + l_step_value)
+        {
+            l_values.push_back(l_value);
+        }
+    }
+
+    if (l_values.empty())
+    {
+        throw std::invalid_argument("Error: No values given: \"" + text + "\"");
+    }
+    return l_values;
+}
+
+std::string mini_jit::benchmarks::BenchmarkRunner::to_string(params_t const& params)
+{
+    std::string l_text;
+    for (auto const& [l_key, l_value] : params)
+    {
+        l_text += (l_text.empty() ? "" : " ") + l_key + "=" + std::to_string(l_value);
+    }
+    return l_text;
+}
+
+std::vector<mini_jit::benchmarks::BenchmarkRunner::entry_t const*> mini_jit::benchmarks::BenchmarkRunner::select() const
+{
+    std::regex l_filter(m_filter);
+
+    std::vector<entry_t const*> l_selected;
+    for (entry_t const& l_entry : m_entries)
+    {
+        bool l_named = m_names.empty();
+        for (std::string const& l_name : m_names)
+        {
+            l_named |= l_entry.name == l_name || l_entry.name.rfind(l_name + "/", 0) == 0;
+        }
+        if (l_named && std::regex_search(l_entry.name, l_filter))
+        {
+            l_selected.push_back(&l_entry);
+        }
+    }
+    return l_selected;
+}
+
+std::vector<mini_jit::benchmarks::BenchmarkRunner::params_t> mini_jit::benchmarks::BenchmarkRunner::sweep(entry_t const& entry) const
+{
+    std::vector<params_t> l_points;
+    for (params_t const& l_default : entry.defaults)
+    {
+        std::vector<params_t> l_expanded = {l_default};
+        for (auto const& [l_key, l_values] : m_sweep)
+        {
+            if (l_default.count(l_key) == 0)
+            {
+                continue;
+            }
+
+            std::vector<params_t> l_next;
+            for (params_t const& l_point : l_expanded)
+            {
+                for (int64_t l_value : l_values)
+                {
+                    params_t l_new = l_point;
+                    l_new[l_key]   = l_value;
+                    l_next.push_back(l_new);
+                }
+            }
+            l_expanded = std::move(l_next);
+        }
+
+        for (params_t const& l_point : l_expanded)
+        {
+            if (std::find(l_points.begin(), l_points.end(), l_point) == l_points.end())
+            {
+                l_points.push_back(l_point);
+            }
+        }
+    }
+    return l_points;
+}
+
+int64_t mini_jit::benchmarks::BenchmarkRunner::run(std::ostream& log)
+{
+    if (m_run_name.empty())
+    {
+        m_run_name = timestamp();
+    }
+    std::filesystem::create_directories(m_output_dir);
+
+    std::ofstream l_text(m_output_dir + "/" + m_run_name + ".txt");
+    if (!l_text.is_open())
+    {
+        throw std::runtime_error("Error: Could not open output file: " + m_output_dir + "/" + m_run_name + ".txt");
+    }
+
+    // the counters are opened on every thread of the OpenMP team, which the benchmarks reuse
+    std::unique_ptr<PerfCounters> l_counters;
+    if (m_perf_counters)
+    {
+        l_counters = std::make_unique<PerfCounters>();
+        if (!l_counters->available())
+        {
+            log << "Hardware performance counters are not available, check /proc/sys/kernel/perf_event_paranoid" << std::endl;
+        }
+        Benchmark::set_perf_counters(l_counters.get());
+    }
+
+    // peaks which are not given are measured by the probes
+    if (m_roofline && m_peak_gflops <= 0.0 && m_compute_probe)
+    {
+        log << "Measuring peak GFLOPS" << std::endl;
+        m_peak_gflops = m_compute_probe(m_run_time);
+    }
+    if (m_roofline && m_peak_gibps <= 0.0 && m_bandwidth_probe)
+    {
+        log << "Measuring peak bandwidth" << std::endl;
+        m_peak_gibps = m_bandwidth_probe(m_run_time);
+    }
+    if (m_peak_gflops > 0.0 && m_peak_gibps > 0.0)
+    {
+        log << "Roofline peaks: " << m_peak_gflops << " GFLOPS, " << m_peak_gibps << " GiB/s" << std::endl;
+        l_text << "Peak GFLOPS/sec:                      " << m_peak_gflops << std::endl;
+        l_text << "Peak bandwidth (GiB/s):               " << m_peak_gibps << std::endl;
+        l_text << "--------------------------------------------------" << std::endl;
+    }
+
+    m_records.clear();
+    int64_t l_num_failed = 0;
+    for (entry_t const* l_entry : select())
+    {
+        for (params_t const& l_params : sweep(*l_entry))
+        {
+            std::string l_label = l_entry->name + " " + to_string(l_params);
+            log << "Running " << l_label << std::endl;
+            l_text << "Running " << l_label << std::endl;
+
+            try
+            {
+                std::unique_ptr<Benchmark> l_bench = l_entry->factory(m_run_time, l_params);
+                l_bench->run();
+                Benchmark::benchmark_result l_result = l_bench->getResult();
+                l_result.roofline                    = Benchmark::compute_roofline(l_result,
+                                                                                   m_peak_gflops,
+                                                                                   m_peak_gibps);
+
+                Benchmark::benchmark_statistics const& l_stats = l_result.statistics;
+                l_text << "Total time (s):                       " << l_result.elapsedSeconds << std::endl;
+                l_text << "Total reps:                           " << l_result.numReps << std::endl;
+                l_text << "Total floating point operations:      " << l_result.totalOperations << std::endl;
+                l_text << "Estimated GFLOPS/sec:                 " << l_result.gflops << std::endl;
+                l_text << "Total amount of processed data (GiB): " << l_result.totalDataProcessed << std::endl;
+                l_text << "Bandwidth (GiB/s)                     " << l_result.gibps << std::endl;
+                l_text << "Median time per rep (s):              " << l_stats.median << std::endl;
+                l_text << "P5 / P95 time per rep (s):            " << l_stats.p5 << " / " << l_stats.p95 << std::endl;
+                l_text << "Stddev time per rep (s):              " << l_stats.stddev << std::endl;
+                l_text << "Samples x reps per sample:            " << l_stats.numSamples << " x " << l_stats.repsPerSample << std::endl;
+                l_text << "Threads, CPU frequency (MHz):         " << l_stats.numThreads << ", " << l_stats.cpuFrequencyMHz << std::endl;
+                l_text << "Arithmetic intensity (FLOP/byte):     " << l_result.roofline.arithmeticIntensity << std::endl;
+                if (l_result.roofline.peakGflops > 0.0)
+                {
+                    l_text << "Bound, attainable GFLOPS/sec:         " << (l_result.roofline.memoryBound ? "memory" : "compute")
+                           << ", " << l_result.roofline.attainableGflops << std::endl;
+                    l_text << "Fraction of peak:                     " << l_result.roofline.fractionOfPeak << std::endl;
+                }
+                if (l_counters)
+                {
+                    write_counters(l_text, l_stats.counters);
+                }
+                l_bench->write_details(l_text);
+
+                m_records.push_back({l_entry->name, l_params, l_result});
+            }
+            catch (std::exception const& l_error)
+            {
+                log << "Failed " << l_label << ": " << l_error.what() << std::endl;
+                l_text << "Failed: " << l_error.what() << std::endl;
+                l_num_failed++;
+            }
+            l_text << "--------------------------------------------------" << std::endl;
+        }
+    }
+
+    Benchmark::set_perf_counters(nullptr);
+
+    write_results();
+    log << "Results written to " << m_output_dir << "/" << m_run_name << ".{json,csv,txt}" << std::endl;
+
+    m_comparisons.clear();
+    if (m_update_baseline && !m_baseline.empty())
+    {
+        std::filesystem::path l_parent = std::filesystem::path(m_baseline).parent_path();
+        if (!l_parent.empty())
+        {
+            std::filesystem::create_directories(l_parent);
+        }
+        write_csv(m_baseline);
+        log << "Baseline written to " << m_baseline << std::endl;
+    }
+    else if (!m_baseline.empty())
+    {
+        std::ostringstream l_comparison;
+        l_num_failed += compare_to_baseline(m_baseline, l_comparison);
+        log << l_comparison.str();
+        l_text << l_comparison.str();
+    }
+
+    return l_num_failed;
+}
+
+bool mini_jit::benchmarks::BenchmarkRunner::is_regression(Benchmark::benchmark_statistics const& baseline,
+                                                          Benchmark::benchmark_statistics const& current,
+                                                          double                                 tolerance)
+{
+    // the slowdown has to exceed the tolerance and the spread of both measurements
+    bool l_slower    = current.median > baseline.median * (1.0 + tolerance);
+    bool l_separated = current.p5 > baseline.p95;
+    return l_slower && l_separated;
+}
+
+int64_t mini_jit::benchmarks::BenchmarkRunner::compare_to_baseline(std::string const& path,
+                                                                   std::ostream&      log)
+{
+    m_comparisons.clear();
+    std::ifstream l_file(path);
+    if (!l_file.is_open())
+    {
+        // machines without a recorded baseline should not report a failure
+        log << "Warning: Could not open baseline: " << path << ", the comparison is skipped. Create it with --update-baseline" << std::endl;
+        return 0;
+    }
+
+    // columns are identified by the header, parameter columns differ between runs
+    std::string              l_line;
+    std::vector<std::string> l_header;
+    std::getline(l_file, l_line);
+    std::stringstream l_header_stream(l_line);
+    for (std::string l_column; std::getline(l_header_stream, l_column, ',');)
+    {
+        l_header.push_back(trim(l_column));
+    }
+    auto l_column_index = [&](std::string const& name)
+    {
+        auto l_it = std::find(l_header.begin(), l_header.end(), name);
+        if (l_it == l_header.end())
+        {
+            throw std::runtime_error("Error: Baseline " + path + " has no column " + name);
+        }
+        return static_cast<size_t>(l_it - l_header.begin());
+    };
+    size_t l_name_index   = l_column_index("name");
+    size_t l_median_index = l_column_index("median");
+    size_t l_p5_index     = l_column_index("p5");
+    size_t l_p95_index    = l_column_index("p95");
+
+    std::map<std::string, Benchmark::benchmark_statistics> l_baseline;
+    while (std::getline(l_file, l_line))
+    {
+        std::vector<std::string> l_values;
+        std::stringstream        l_stream(l_line);
+        for (std::string l_value; std::getline(l_stream, l_value, ',');)
+        {
+            l_values.push_back(trim(l_value));
+        }
+        // trailing empty columns are not part of the values
+        if (l_values.size() <= std::max({l_name_index, l_median_index, l_p5_index, l_p95_index}))
+        {
+            continue;
+        }
+
+        Benchmark::benchmark_statistics l_stats;
+        l_stats.median                     = std::stod(l_values[l_median_index]);
+        l_stats.p5                         = std::stod(l_values[l_p5_index]);
+        l_stats.p95                        = std::stod(l_values[l_p95_index]);
+        l_baseline[l_values[l_name_index]] = l_stats;
+    }
+
+    int64_t l_num_regressions = 0;
+    log << "Comparison with baseline " << path << " (tolerance " << m_tolerance * 100.0 << "%):" << std::endl;
+    for (record_t const& l_record : m_records)
+    {
+        std::string l_label = l_record.name + " " + to_string(l_record.params);
+        auto        l_it    = l_baseline.find(l_label);
+        if (l_it == l_baseline.end())
+        {
+            log << "  no baseline   " << l_label << std::endl;
+            continue;
+        }
+
+        Benchmark::benchmark_statistics const& l_current = l_record.result.statistics;
+        comparison_t                           l_comparison;
+        l_comparison.label           = l_label;
+        l_comparison.baseline_median = l_it->second.median;
+        l_comparison.median          = l_current.median;
+        l_comparison.speedup         = l_current.median > 0.0 ? l_it->second.median / l_current.median : 0.0;
+        l_comparison.regression      = is_regression(l_it->second, l_current, m_tolerance);
+        m_comparisons.push_back(l_comparison);
+
+        l_num_regressions += l_comparison.regression ? 1 : 0;
+        log << (l_comparison.regression ? "  REGRESSION    " : "  ok            ")
+            << l_label << ": " << l_comparison.baseline_median << " s -> " << l_comparison.median
+            << " s (speedup " << l_comparison.speedup << ")" << std::endl;
+    }
+    log << l_num_regressions << " regression(s) in " << m_comparisons.size() << " comparison(s)" << std::endl;
+
+    return l_num_regressions;
+}
+
+void mini_jit::benchmarks::BenchmarkRunner::write_results() const
+{
+    std::string l_path = m_output_dir + "/" + m_run_name;
+
+    std::ofstream l_json(l_path + ".json");
+    if (!l_json.is_open())
+    {
+        throw std::runtime_error("Error: Could not open output file: " + l_path + ".json");
+    }
+
+    l_json << "{\"run\": \"" << m_run_name << "\", \"run_time\": " << m_run_time
+           << ", \"peak_gflops\": " << m_peak_gflops << ", \"peak_gibps\": " << m_peak_gibps << ", \"results\": [";
+    for (size_t i = 0; i < m_records.size(); i++)
+    {
+        record_t const& l_record = m_records[i];
+        l_json << (i > 0 ? ",\n " : "\n ") << "{\"benchmark\": \"" << l_record.name << "\", \"params\": {";
+        bool l_first = true;
+        for (auto const& [l_key, l_value] : l_record.params)
+        {
+            l_json << (l_first ? "" : ", ") << "\"" << l_key << "\": " << l_value;
+            l_first = false;
+        }
+        l_json << "}, \"result\": "
+               << Benchmark::to_json(l_record.name + " " + to_string(l_record.params), l_record.result)
+               << "}";
+    }
+    l_json << "\n]}\n";
+
+    write_csv(l_path + ".csv");
+}
+
+void mini_jit::benchmarks::BenchmarkRunner::write_csv(std::string const& path) const
+{
+    std::ofstream l_csv(path);
+    if (!l_csv.is_open())
+    {
+        throw std::runtime_error("Error: Could not open output file: " + path);
+    }
+
+    // one column per parameter, which allows CostModel::loadThroughputTable to read GEMM sweeps directly
+    std::set<std::string> l_keys;
+    for (record_t const& l_record : m_records)
+    {
+        for (auto const& l_param : l_record.params)
+        {
+            l_keys.insert(l_param.first);
+        }
+    }
+
+    l_csv << "benchmark,";
+    for (std::string const& l_key : l_keys)
+    {
+        l_csv << l_key << ",";
+    }
+    Benchmark::write_csv_header(l_csv);
+    for (record_t const& l_record : m_records)
+    {
+        l_csv << l_record.name << ",";
+        for (std::string const& l_key : l_keys)
+        {
+            auto l_it = l_record.params.find(l_key);
+            if (l_it != l_record.params.end())
+            {
+                l_csv << l_it->second;
+            }
+            l_csv << ",";
+        }
+        Benchmark::write_csv(l_csv, l_record.name + " " + to_string(l_record.params), l_record.result);
+    }
+}
+
+int mini_jit::benchmarks::BenchmarkRunner::main(int                argc,
+                                                char const* const* argv)
+{
+    std::string l_program = argc > 0 ? argv[0] : "benchmarks";
+    try
+    {
+        parse_arguments(argc, argv);
+        if (m_help || argc < 2)
+        {
+            print_usage(std::cout, l_program);
+            return 0;
+        }
+        if (m_list)
+        {
+            print_list(std::cout);
+            return 0;
+        }
+        return run(std::cout) == 0 ? 0 : 1;
+    }
+    catch (std::invalid_argument const& l_error)
+    {
+        std::cerr << l_error.what() << std::endl;
+        print_usage(std::cerr, l_program);
+    }
+    catch (std::exception const& l_error)
+    {
+        std::cerr << l_error.what() << std::endl;
+    }
+    return 1;
+}
+
+void mini_jit::benchmarks::BenchmarkRunner::print_usage(std::ostream&      stream,
+                                                        std::string const& program) const
+{
+    std::set<std::string> l_params;
+    for (entry_t const& l_entry : m_entries)
+    {
+        for (auto const& l_param : l_entry.defaults.front())
+        {
+            l_params.insert(l_param.first);
+        }
+    }
+
+    stream << "Usage: " << program << " [NAME...] [OPTIONS]" << std::endl;
+    stream << "  NAME                 run the benchmark or group with this name, e.g. matmul or matmul/gemm" << std::endl;
+    stream << "  --filter REGEX       run benchmarks whose name contains a match of REGEX" << std::endl;
+    stream << "  --list               list the selected benchmarks and their parameters" << std::endl;
+    stream << "  --config FILE        read options from FILE, one key = value per line" << std::endl;
+    stream << "  --run-time SECONDS   run time of every benchmark (default: 3)" << std::endl;
+    stream << "  --output-dir DIR     directory of the result files (default: benchmarks)" << std::endl;
+    stream << "  --name NAME          name of the run and its result files (default: timestamp)" << std::endl;
+    stream << "  --baseline FILE      compare the results with the CSV of an earlier run, fails on regressions" << std::endl;
+    stream << "  --update-baseline    write the results to the baseline instead of comparing them" << std::endl;
+    stream << "  --tolerance FRACTION tolerated slowdown of the median time (default: 0.05)" << std::endl;
+    stream << "  --roofline           measure the peaks with the probe benchmarks unless they are given" << std::endl;
+    stream << "  --peak-gflops GFLOPS peak floating point throughput of the roofline" << std::endl;
+    stream << "  --peak-gibps GIBPS   peak memory bandwidth of the roofline" << std::endl;
+    stream << "  --perf-counters      count cycles, instructions, cache and branch misses with perf_event_open" << std::endl;
+    stream << "  --PARAM VALUES       sweep a parameter, e.g. --m 64, --k 1,16,32 or --n 1:64 or --threads 1:64:*2" << std::endl;
+    stream << "Parameters:";
+    for (std::string const& l_param : l_params)
+    {
+        stream << " " << l_param;
+    }
+    stream << std::endl;
+    stream << "Benchmarks:" << std::endl;
+    for (entry_t const& l_entry : m_entries)
+    {
+        stream << "  " << l_entry.name << std::string(l_entry.name.size() < 32 ? 32 - l_entry.name.size() : 1, ' ')
+               << l_entry.description << std::endl;
+    }
+}
+
+void mini_jit::benchmarks::BenchmarkRunner::print_list(std::ostream& stream) const
+{
+    for (entry_t const* l_entry : select())
+    {
+        stream << l_entry->name << ": " << l_entry->description << std::endl;
+        for (params_t const& l_params : sweep(*l_entry))
+        {
+            stream << "  " << to_string(l_params) << std::endl;
+        }
+    }
+}
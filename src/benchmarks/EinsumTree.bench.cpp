@@ -1,18 +1,130 @@
-#include <chrono>
 #include <iostream>
 #include <mlc/benchmarks/Benchmark.h>
 #include <mlc/benchmarks/EinsumTree.bench.h>
 #include <random>
 #include <span>
 
-mini_jit::benchmarks::EinsumTreeBench::EinsumTreeBench(double                              run_time,
-                                                       std::string const&                  einsum_expression,
-                                                       std::vector<int64_t>&               dimension_sizes,
-                                                       mini_jit::dtype_t                   dtype,
-                                                       int64_t                             thread_target,
-                                                       int64_t                             max_kernel_size,
-                                                       int64_t                             min_kernel_size,
-                                                       std::map<std::string, void const*>& tensor_inputs) : Benchmark()
+/**
+ * Sums up the output sizes of all non-leaf nodes which do (not) need zeroing before execution.
+ *
+ * @param node The root of the (sub)tree.
+ * @param zero_output Count nodes which need zeroing if true, nodes which do not need zeroing otherwise.
+ * @return Number of bytes.
+ */
+static int64_t count_zero_fill_bytes(mini_jit::einsum::EinsumNode const* node,
+                                     bool                                zero_output)
+{
+    if (node == nullptr || node->get_number_of_children() == 0)
+    {
+        return 0;
+    }
+
+    int64_t l_bytes = count_zero_fill_bytes(node->m_left_child, zero_output) +
+                      count_zero_fill_bytes(node->m_right_child, zero_output);
+    if (node->m_zero_output == zero_output)
+    {
+        l_bytes += node->m_tensor_size * (node->m_dtype == mini_jit::dtype_t::fp32 ? 4 : 8);
+    }
+    return l_bytes;
+}
+
+/**
+ * Sums up the bytes moved by the tensor operations of all non-leaf nodes.
+ * Every operation reads both inputs and reads and writes its output.
+ *
+ * @param node The root of the (sub)tree.
+ * @return Number of bytes.
+ */
+static int64_t count_moved_bytes(mini_jit::einsum::EinsumNode const* node)
+{
+    if (node == nullptr || node->get_number_of_children() == 0)
+    {
+        return 0;
+    }
+
+    int64_t l_elements = 2 * node->m_tensor_size;
+    if (node->m_left_child != nullptr)
+    {
+        l_elements += node->m_left_child->m_tensor_size;
+    }
+    if (node->m_right_child != nullptr)
+    {
+        l_elements += node->m_right_child->m_tensor_size;
+    }
+
+    return l_elements * (node->m_dtype == mini_jit::dtype_t::fp32 ? 4 : 8) +
+           count_moved_bytes(node->m_left_child) +
+           count_moved_bytes(node->m_right_child);
+}
+
+/**
+ * Collects all non-leaf nodes of a (sub)tree which do not need zeroing before execution.
+ *
+ * @param node The root of the (sub)tree.
+ * @param nodes The nodes, appended in post order.
+ */
+static void collect_skipped_zero_fill_nodes(mini_jit::einsum::EinsumNode*               node,
+                                            std::vector<mini_jit::einsum::EinsumNode*>& nodes)
+{
+    if (node == nullptr || node->get_number_of_children() == 0)
+    {
+        return;
+    }
+    collect_skipped_zero_fill_nodes(node->m_left_child, nodes);
+    collect_skipped_zero_fill_nodes(node->m_right_child, nodes);
+    if (!node->m_zero_output)
+    {
+        nodes.push_back(node);
+    }
+}
+
+/**
+ * Checks whether a tensor operation of a (sub)tree runs shared loops on an OpenMP team.
+ *
+ * @param node The root of the (sub)tree.
+ * @return True if at least one operation is parallel.
+ */
+static bool is_parallel(mini_jit::einsum::EinsumNode const* node)
+{
+    if (node == nullptr || node->get_number_of_children() == 0)
+    {
+        return false;
+    }
+    return node->m_operation.is_parallel() ||
+           is_parallel(node->m_left_child) ||
+           is_parallel(node->m_right_child);
+}
+
+/**
+ * Collects all leaves of a (sub)tree.
+ *
+ * @param node The root of the (sub)tree.
+ * @param leaves The leaves, appended from left to right.
+ */
+static void collect_leaves(mini_jit::einsum::EinsumNode*               node,
+                           std::vector<mini_jit::einsum::EinsumNode*>& leaves)
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+    if (node->get_number_of_children() == 0)
+    {
+        leaves.push_back(node);
+        return;
+    }
+    collect_leaves(node->m_left_child, leaves);
+    collect_leaves(node->m_right_child, leaves);
+}
+
+mini_jit::benchmarks::EinsumTreeBench::EinsumTreeBench(double                                    run_time,
+                                                       std::string const&                        einsum_expression,
+                                                       std::vector<int64_t>&                     dimension_sizes,
+                                                       mini_jit::dtype_t                         dtype,
+                                                       int64_t                                   thread_target,
+                                                       int64_t                                   max_kernel_size,
+                                                       int64_t                                   min_kernel_size,
+                                                       std::map<std::string, void const*> const& tensor_inputs) : Benchmark()
 {
     m_run_time        = run_time;
     m_dimension_sizes = dimension_sizes;
@@ -30,32 +142,126 @@ mini_jit::benchmarks::EinsumTreeBench::EinsumTreeBench(double
                                                                           dtype);
 }
 
+mini_jit::benchmarks::EinsumTreeBench::EinsumTreeBench(double                run_time,
+                                                       std::string const&    einsum_expression,
+                                                       std::vector<int64_t>& dimension_sizes,
+                                                       mini_jit::dtype_t     dtype,
+                                                       int64_t               thread_target,
+                                                       int64_t               max_kernel_size,
+                                                       int64_t               min_kernel_size) : EinsumTreeBench(run_time,
+                                                                                                                einsum_expression,
+                                                                                                                dimension_sizes,
+                                                                                                                dtype,
+                                                                                                                thread_target,
+                                                                                                                max_kernel_size,
+                                                                                                                min_kernel_size,
+                                                                                                                {})
+{
+    std::vector<mini_jit::einsum::EinsumNode*> l_leaves;
+    collect_leaves(m_root_node, l_leaves);
+
+    for (mini_jit::einsum::EinsumNode* l_leaf : l_leaves)
+    {
+        if (dtype == mini_jit::dtype_t::fp32)
+        {
+            std::vector<float>& l_input = m_inputs_fp32.emplace_back(l_leaf->m_tensor_size);
+            for (int64_t i = 0; i < l_leaf->m_tensor_size; ++i)
+            {
+                l_input[i] = i % 100;
+            }
+            m_tensor_inputs[l_leaf->m_tensor_expression] = l_input.data();
+        }
+        else
+        {
+            std::vector<double>& l_input = m_inputs_fp64.emplace_back(l_leaf->m_tensor_size);
+            for (int64_t i = 0; i < l_leaf->m_tensor_size; ++i)
+            {
+                l_input[i] = i % 100;
+            }
+            m_tensor_inputs[l_leaf->m_tensor_expression] = l_input.data();
+        }
+    }
+}
+
 void mini_jit::benchmarks::EinsumTreeBench::run()
 {
     // RUN
-    long   l_num_reps    = 0;
-    auto   l_start_time  = std::chrono::high_resolution_clock::now();
-    double l_elapsed     = 0.0;
-    double l_run_time_ms = m_run_time * 1e6;
-    do
-    {
-        mini_jit::einsum::EinsumTree::execute(m_root_node,
-                                              m_dimension_sizes,
-                                              m_tensor_inputs);
-        ++l_num_reps;
-        auto l_now = std::chrono::high_resolution_clock::now();
-        l_elapsed  = std::chrono::duration_cast<std::chrono::microseconds>(l_now - l_start_time).count();
-    } while (l_elapsed < l_run_time_ms);
-    l_elapsed /= 1e6; // Convert to seconds
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure([&]()
+                                              { mini_jit::einsum::EinsumTree::execute(m_root_node,
+                                                                                      m_dimension_sizes,
+                                                                                      m_tensor_inputs); },
+                                              m_run_time,
+                                              l_num_reps,
+                                              l_elapsed,
+                                              is_parallel(m_root_node));
     // END RUN
 
     // Calculate metrics
-    double l_totalOperations = m_root_node->m_computational_operations * l_num_reps;
-    double l_gflops          = ((double)l_totalOperations) / (l_elapsed * 1e9);
+    double l_totalOperations    = m_root_node->m_computational_operations * l_num_reps;
+    double l_gflops             = ((double)l_totalOperations) / (l_num_reps * l_stats.median * 1e9);
+    double l_totalDataProcessed = ((double)count_moved_bytes(m_root_node) * l_num_reps) / (1024.0 * 1024.0 * 1024.0);
+    double l_gibps              = l_totalDataProcessed / (l_num_reps * l_stats.median);
 
     // Store the results
-    m_benchmarkResult.numReps         = l_num_reps;
-    m_benchmarkResult.elapsedSeconds  = l_elapsed;
-    m_benchmarkResult.totalOperations = l_totalOperations;
-    m_benchmarkResult.gflops          = l_gflops;
+    m_benchmarkResult.numReps            = l_num_reps;
+    m_benchmarkResult.elapsedSeconds     = l_elapsed;
+    m_benchmarkResult.statistics         = l_stats;
+    m_benchmarkResult.totalOperations    = l_totalOperations;
+    m_benchmarkResult.gflops             = l_gflops;
+    m_benchmarkResult.totalDataProcessed = l_totalDataProcessed;
+    m_benchmarkResult.gibps              = l_gibps;
+
+    // RUN with the output of every node zeroed upfront, as before the first-touch path
+    m_forced_zero_fill_median = 0.0;
+    std::vector<mini_jit::einsum::EinsumNode*> l_nodes;
+    collect_skipped_zero_fill_nodes(m_root_node, l_nodes);
+    if (!l_nodes.empty())
+    {
+        for (mini_jit::einsum::EinsumNode* l_node : l_nodes)
+        {
+            l_node->m_zero_output = true;
+        }
+        long                 l_forced_num_reps = 0;
+        double               l_forced_elapsed  = 0.0;
+        benchmark_statistics l_forced_stats    = measure([&]()
+                                                         { mini_jit::einsum::EinsumTree::execute(m_root_node,
+                                                                                                 m_dimension_sizes,
+                                                                                                 m_tensor_inputs); },
+                                                         m_run_time,
+                                                         l_forced_num_reps,
+                                                         l_forced_elapsed,
+                                                         is_parallel(m_root_node));
+        for (mini_jit::einsum::EinsumNode* l_node : l_nodes)
+        {
+            l_node->m_zero_output = false;
+        }
+        m_forced_zero_fill_median = l_forced_stats.median;
+    }
+    // END RUN
+}
+
+int64_t mini_jit::benchmarks::EinsumTreeBench::get_zero_fill_bytes() const
+{
+    return count_zero_fill_bytes(m_root_node, true);
+}
+
+int64_t mini_jit::benchmarks::EinsumTreeBench::get_skipped_zero_fill_bytes() const
+{
+    return count_zero_fill_bytes(m_root_node, false);
+}
+
+void mini_jit::benchmarks::EinsumTreeBench::write_details(std::ostream& stream) const
+{
+    // bytes which are not written by std::fill anymore, since the operations overwrite their outputs
+    stream << "Zero-fill per execution (GiB):         " << get_zero_fill_bytes() / (1024.0 * 1024.0 * 1024.0) << std::endl;
+    stream << "Zero-fill avoided per execution (GiB): " << get_skipped_zero_fill_bytes() / (1024.0 * 1024.0 * 1024.0) << std::endl;
+    if (m_forced_zero_fill_median > 0.0)
+    {
+        double l_median = m_benchmarkResult.statistics.median;
+        stream << "Median time without zero-fill (s):     " << l_median << std::endl;
+        stream << "Median time with zero-fill (s):        " << m_forced_zero_fill_median << std::endl;
+        stream << "Time saved per execution (s):          " << m_forced_zero_fill_median - l_median << std::endl;
+    }
 }
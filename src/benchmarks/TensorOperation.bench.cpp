@@ -1,4 +1,3 @@
-#include <chrono>
 #include <mlc/benchmarks/Benchmark.h>
 #include <mlc/benchmarks/TensorOperation.bench.h>
 #include <random>
@@ -82,30 +81,32 @@ void mini_jit::benchmarks::TensorOperationBench::run()
     }
 
     // RUN
-    long   l_num_reps    = 0;
-    auto   l_start_time  = std::chrono::high_resolution_clock::now();
-    double l_elapsed     = 0.0;
-    double l_run_time_ms = m_run_time * 1e6;
-    do
-    {
-        m_tensor_op.execute(A, B, C);
-        ++l_num_reps;
-        auto l_now = std::chrono::high_resolution_clock::now();
-        l_elapsed  = std::chrono::duration_cast<std::chrono::microseconds>(l_now - l_start_time).count();
-    } while (l_elapsed < l_run_time_ms);
-    l_elapsed /= 1e6; // Convert to seconds
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure([&]()
+                                              { m_tensor_op.execute(A, B, C); },
+                                              m_run_time,
+                                              l_num_reps,
+                                              l_elapsed,
+                                              m_tensor_op.is_parallel());
     // END RUN
 
     // Calculate metrics
-    long   l_totalOperations = 2.0 * l_num_reps * (l_size_M * l_size_N * l_size_K);
-    double l_gflops          = ((double)l_totalOperations) / (l_elapsed * 1e9);
+    long   l_totalOperations    = 2.0 * l_num_reps * (l_size_M * l_size_N * l_size_K);
+    double l_gflops             = ((double)l_totalOperations) / (l_num_reps * l_stats.median * 1e9);
+    // A and B are read, C is read and written
+    double l_totalDataProcessed = (sizeof(float) * l_num_reps * (SIZE_A + SIZE_B + 2 * SIZE_C)) / (1024.0 * 1024.0 * 1024.0);
+    double l_gibps              = l_totalDataProcessed / (l_num_reps * l_stats.median);
 
     // Store the results
     m_benchmarkResult.numReps             = l_num_reps;
     m_benchmarkResult.elapsedSeconds      = l_elapsed;
+    m_benchmarkResult.statistics          = l_stats;
     m_benchmarkResult.totalNumberElements = (l_size_M * l_size_N * l_size_K) * l_num_reps;
     m_benchmarkResult.totalOperations     = l_totalOperations;
     m_benchmarkResult.gflops              = l_gflops;
+    m_benchmarkResult.totalDataProcessed  = l_totalDataProcessed;
+    m_benchmarkResult.gibps               = l_gibps;
 
     delete[] A;
     delete[] B;
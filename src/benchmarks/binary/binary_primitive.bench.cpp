@@ -0,0 +1,73 @@
+#include <mlc/Binary.h>
+#include <mlc/benchmarks/Benchmark.h>
+#include <mlc/benchmarks/binary/binary_primitive.bench.h>
+#include <random>
+#include <stdexcept>
+
+mini_jit::benchmarks::BinaryPrimitiveBench::BinaryPrimitiveBench(double            runTime,
+                                                                 uint32_t          m,
+                                                                 uint32_t          n,
+                                                                 mini_jit::ptype_t ptype) : Benchmark()
+{
+    m_M       = m;
+    m_N       = n;
+    m_runTime = runTime;
+    m_ptype   = ptype;
+}
+
+void mini_jit::benchmarks::BinaryPrimitiveBench::run()
+{
+    // Generate and get the kernel function
+    mini_jit::Binary l_binary;
+    if (l_binary.generate(m_M, m_N, 0, mini_jit::dtype_t::fp32, m_ptype) != mini_jit::error_t::success)
+    {
+        throw std::invalid_argument("Could not generate binary primitive " + mini_jit::to_string(m_ptype));
+    }
+    mini_jit::Binary::kernel_t l_kernel_t = l_binary.get_kernel();
+
+    m_A = new float[m_M * m_N];
+    m_B = new float[m_M * m_N];
+    m_C = new float[m_M * m_N];
+
+    // Initialize matrices A and B with random values, B is nonzero for div
+    std::random_device                    rd;
+    std::mt19937                          gen(rd());
+    std::uniform_real_distribution<float> dist(1.0f, 10.0f);
+
+    for (uint32_t i = 0; i < m_M * m_N; i++)
+    {
+        m_A[i] = dist(gen);
+        m_B[i] = dist(gen);
+    }
+
+    // RUN
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure([&]()
+                                              { l_kernel_t(m_A, m_B, m_C, m_M, m_M, m_M); },
+                                              m_runTime,
+                                              l_num_reps,
+                                              l_elapsed);
+    // END RUN
+
+    // Calculate metrics, two elements are read and one is written
+    long   l_totalNumberElements = m_M * m_N * l_num_reps * 3;
+    double l_totalDataProcessed  = (sizeof(float) * l_totalNumberElements) / (1024.0 * 1024.0 * 1024.0);
+    double l_gibps               = l_totalDataProcessed / (l_num_reps * l_stats.median);
+    long   l_totalOperations     = l_num_reps * (m_M * m_N);
+    double l_gflops              = ((double)l_totalOperations) / (l_num_reps * l_stats.median * 1e9);
+
+    // Store the results
+    m_benchmarkResult.numReps             = l_num_reps;
+    m_benchmarkResult.elapsedSeconds      = l_elapsed;
+    m_benchmarkResult.statistics          = l_stats;
+    m_benchmarkResult.totalNumberElements = m_M * m_N * l_num_reps;
+    m_benchmarkResult.totalDataProcessed  = l_totalDataProcessed;
+    m_benchmarkResult.gibps               = l_gibps;
+    m_benchmarkResult.totalOperations     = l_totalOperations;
+    m_benchmarkResult.gflops              = l_gflops;
+
+    delete[] m_A;
+    delete[] m_B;
+    delete[] m_C;
+}
@@ -0,0 +1,46 @@
+#include <mlc/benchmarks/Benchmark.h>
+#include <mlc/benchmarks/jit/kernel_generation.bench.h>
+#include <stdexcept>
+#include <utility>
+
+mini_jit::benchmarks::KernelGenerationBench::KernelGenerationBench(double      runTime,
+                                                                   generator_t generator) : Benchmark()
+{
+    if (!generator)
+    {
+        throw std::invalid_argument("The generation benchmark needs a generator");
+    }
+    m_runTime   = runTime;
+    m_generator = std::move(generator);
+}
+
+void mini_jit::benchmarks::KernelGenerationBench::run()
+{
+    // fails early for unsupported configurations
+    m_codeSize = m_generator();
+
+    // RUN
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure([&]()
+                                              { m_generator(); },
+                                              m_runTime,
+                                              l_num_reps,
+                                              l_elapsed);
+    // END RUN
+
+    // Store the results, the processed elements are the generated instructions
+    m_benchmarkResult.numReps             = l_num_reps;
+    m_benchmarkResult.elapsedSeconds      = l_elapsed;
+    m_benchmarkResult.statistics          = l_stats;
+    m_benchmarkResult.totalNumberElements = static_cast<long>(m_codeSize / 4) * l_num_reps;
+}
+
+void mini_jit::benchmarks::KernelGenerationBench::write_details(std::ostream& stream) const
+{
+    stream << "Code size (bytes):                     " << m_codeSize << std::endl;
+    if (m_codeSize > 0)
+    {
+        stream << "Time per instruction (ns):             " << m_benchmarkResult.statistics.median * 1e9 / (m_codeSize / 4) << std::endl;
+    }
+}
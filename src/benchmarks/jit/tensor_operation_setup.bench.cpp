@@ -0,0 +1,96 @@
+#include <mlc/benchmarks/Benchmark.h>
+#include <mlc/benchmarks/jit/tensor_operation_setup.bench.h>
+#include <span>
+#include <stdexcept>
+
+mini_jit::benchmarks::TensorOperationSetupBench::TensorOperationSetupBench(double                   run_time,
+                                                                           dtype_t                  dtype,
+                                                                           ptype_t                  prim_first_touch,
+                                                                           ptype_t                  prim_main,
+                                                                           ptype_t                  prim_last_touch,
+                                                                           std::span<const dim_t>   dim_types,
+                                                                           std::span<const exec_t>  exec_types,
+                                                                           std::span<const int64_t> dim_sizes,
+                                                                           std::span<const int64_t> strides_in0,
+                                                                           std::span<const int64_t> strides_in1,
+                                                                           std::span<const int64_t> strides_out) : Benchmark()
+{
+    m_run_time         = run_time;
+    m_dtype            = dtype;
+    m_prim_first_touch = prim_first_touch;
+    m_prim_main        = prim_main;
+    m_prim_last_touch  = prim_last_touch;
+
+    m_dim_types.assign(dim_types.begin(), dim_types.end());
+    m_exec_types.assign(exec_types.begin(), exec_types.end());
+    m_dim_sizes.assign(dim_sizes.begin(), dim_sizes.end());
+    m_strides_in0.assign(strides_in0.begin(), strides_in0.end());
+    m_strides_in1.assign(strides_in1.begin(), strides_in1.end());
+    m_strides_out.assign(strides_out.begin(), strides_out.end());
+}
+
+void mini_jit::benchmarks::TensorOperationSetupBench::run()
+{
+    m_timings_sum = TensorOperation::setup_timings_t();
+    m_num_setups  = 0;
+
+    auto l_setup = [&]()
+    {
+        TensorOperation l_op;
+        error_t         l_err = l_op.setup(m_dtype,
+                                           m_prim_first_touch,
+                                           m_prim_main,
+                                           m_prim_last_touch,
+                                           m_dim_types,
+                                           m_exec_types,
+                                           m_dim_sizes,
+                                           m_strides_in0,
+                                           m_strides_in1,
+                                           m_strides_out);
+        if (l_err != error_t::success)
+        {
+            throw std::invalid_argument("Could not set up tensor operation: " + to_string(l_err));
+        }
+
+        TensorOperation::setup_timings_t const& l_timings = l_op.get_setup_timings();
+        m_timings_sum.analysis_ns   += l_timings.analysis_ns;
+        m_timings_sum.kernels_ns    += l_timings.kernels_ns;
+        m_timings_sum.packing_ns    += l_timings.packing_ns;
+        m_timings_sum.remainders_ns += l_timings.remainders_ns;
+        m_timings_sum.num_kernels    = l_timings.num_kernels;
+        m_code_size                  = l_op.get_code_size();
+        m_num_setups++;
+    };
+
+    // RUN
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure(l_setup,
+                                              m_run_time,
+                                              l_num_reps,
+                                              l_elapsed);
+    // END RUN
+
+    // Store the results, the processed elements are the generated instructions
+    m_benchmarkResult.numReps             = l_num_reps;
+    m_benchmarkResult.elapsedSeconds      = l_elapsed;
+    m_benchmarkResult.statistics          = l_stats;
+    m_benchmarkResult.totalNumberElements = static_cast<long>(m_code_size / 4) * l_num_reps;
+}
+
+void mini_jit::benchmarks::TensorOperationSetupBench::write_details(std::ostream& stream) const
+{
+    if (m_num_setups == 0)
+    {
+        return;
+    }
+
+    // the mean includes the warmup repetitions, which are setups as well
+    double l_scale = 1e-3 / m_num_setups;
+    stream << "Kernels per setup:                     " << m_timings_sum.num_kernels << std::endl;
+    stream << "Code size (bytes):                     " << m_code_size << std::endl;
+    stream << "Mean analysis time (us):               " << m_timings_sum.analysis_ns * l_scale << std::endl;
+    stream << "Mean kernel generation time (us):      " << m_timings_sum.kernels_ns * l_scale << std::endl;
+    stream << "Mean packing generation time (us):     " << m_timings_sum.packing_ns * l_scale << std::endl;
+    stream << "Mean remainder setup time (us):        " << m_timings_sum.remainders_ns * l_scale << std::endl;
+}
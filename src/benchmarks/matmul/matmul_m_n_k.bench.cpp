@@ -1,4 +1,3 @@
-#include <chrono>
 #include <mlc/Brgemm.h>
 #include <mlc/Kernel.h>
 #include <mlc/benchmarks/Benchmark.h>
@@ -48,30 +47,31 @@ void mini_jit::benchmarks::MatmulMNKBench::run()
     mini_jit::Brgemm::kernel_t l_kernel_t = reinterpret_cast<mini_jit::Brgemm::kernel_t>(const_cast<void*>(l_kernel.get_kernel()));
 
     // RUN
-    long   l_num_reps   = 0;
-    auto   l_start_time = std::chrono::high_resolution_clock::now();
-    double l_elapsed    = 0.0;
-    double l_runTimeMs  = m_run_time * 1e6;
-    do
-    {
-        l_kernel_t(m_A, m_B, m_C, m_M, m_K, m_M, 0, 0);
-        ++l_num_reps;
-        auto l_now = std::chrono::high_resolution_clock::now();
-        l_elapsed  = std::chrono::duration_cast<std::chrono::microseconds>(l_now - l_start_time).count();
-    } while (l_elapsed < l_runTimeMs);
-    l_elapsed /= 1e6; // Convert to seconds
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure([&]()
+                                              { l_kernel_t(m_A, m_B, m_C, m_M, m_K, m_M, 0, 0); },
+                                              m_run_time,
+                                              l_num_reps,
+                                              l_elapsed);
     // END RUN
 
     // Calculate metrics
-    long   l_totalOperations = 2.0 * m_M * m_N * m_K * l_num_reps;
-    double l_gflops          = ((double)l_totalOperations) / (l_elapsed * 1e9);
+    long   l_totalOperations    = 2.0 * m_M * m_N * m_K * l_num_reps;
+    double l_gflops             = ((double)l_totalOperations) / (l_num_reps * l_stats.median * 1e9);
+    // A and B are read, C is read and written
+    double l_totalDataProcessed = (sizeof(float) * l_num_reps * (m_M * m_K + m_K * m_N + 2 * m_M * m_N)) / (1024.0 * 1024.0 * 1024.0);
+    double l_gibps              = l_totalDataProcessed / (l_num_reps * l_stats.median);
 
     // Store the results
     m_benchmarkResult.numReps             = l_num_reps;
     m_benchmarkResult.elapsedSeconds      = l_elapsed;
+    m_benchmarkResult.statistics          = l_stats;
     m_benchmarkResult.totalNumberElements = m_M * m_N * m_K * l_num_reps;
     m_benchmarkResult.totalOperations     = l_totalOperations;
     m_benchmarkResult.gflops              = l_gflops;
+    m_benchmarkResult.totalDataProcessed  = l_totalDataProcessed;
+    m_benchmarkResult.gibps               = l_gibps;
 
     delete[] m_A;
     delete[] m_B;
@@ -0,0 +1,103 @@
+#include <mlc/Kernel.h>
+#include <mlc/benchmarks/Benchmark.h>
+#include <mlc/benchmarks/roofline/fmla_throughput.bench.h>
+#include <mlc/instructions/all_instructions.h>
+#include <mlc/registers/gp_registers.h>
+#include <mlc/registers/simd_fp_registers.h>
+#include <omp.h>
+#include <stdexcept>
+
+using enum gpr_t;
+using enum simd_fp_t;
+using enum arr_spec_t;
+
+using namespace mini_jit::instructions::base;
+using namespace mini_jit::instructions::simd_fp;
+
+mini_jit::benchmarks::FmlaThroughputBench::FmlaThroughputBench(double  runTime,
+                                                               int64_t iterations) : Benchmark()
+{
+    if (iterations <= 0)
+    {
+        throw std::invalid_argument("The FMLA kernel needs at least one iteration");
+    }
+    m_iterations = iterations;
+    m_runTime    = runTime;
+}
+
+void mini_jit::benchmarks::FmlaThroughputBench::generate(mini_jit::Kernel& kernel)
+{
+    // Inputs:
+    // x0: number of loop iterations
+
+    // Same setup as the FMLA (4S) throughput microbenchmark of the NEON submission, but restricted
+    // to caller-saved registers: v0-v7 and v16-v27 are accumulators, v28 and v29 are the sources.
+    simd_fp_t const l_accumulators[20] = {v0, v1, v2, v3, v4, v5, v6, v7,
+                                          v16, v17, v18, v19, v20, v21, v22, v23, v24, v25, v26, v27};
+
+    // PCS
+    kernel.add_instr(stpPre(x29, x30, sp, -16));
+    kernel.add_instr(movSP(x29, sp));
+
+    // zero the registers, avoids denormals in the accumulators
+    for (simd_fp_t l_reg : l_accumulators)
+    {
+        kernel.add_instr(zero(l_reg, b16));
+    }
+    kernel.add_instr(zero(v28, b16));
+    kernel.add_instr(zero(v29, b16));
+
+    mini_jit::Kernel::label_t l_loop = kernel.add_label();
+    for (int64_t l_rep = 0; l_rep < FMLAS_PER_ITERATION / 20; ++l_rep)
+    {
+        for (simd_fp_t l_reg : l_accumulators)
+        {
+            kernel.add_instr(fmlaVec(l_reg, v28, v29, s4));
+        }
+    }
+
+    // decrement loop counter
+    kernel.add_instr(sub(x0, x0, 1, 0));
+    // check if loop counter is zero
+    kernel.add_branch(cbnz(x0, 0), l_loop);
+
+    // Restore stack pointer
+    kernel.add_instr(ldpPost(x29, x30, sp, 16));
+
+    kernel.add_instr(ret());
+    kernel.set_kernel();
+}
+
+void mini_jit::benchmarks::FmlaThroughputBench::run()
+{
+    // Generate and get the kernel function
+    mini_jit::Kernel l_kernel;
+    l_kernel.set_name("fmla_throughput");
+    generate(l_kernel);
+    using kernel_t = void (*)(int64_t);
+    kernel_t l_kernel_t   = reinterpret_cast<kernel_t>(const_cast<void*>(l_kernel.get_kernel()));
+    int64_t  l_iterations = m_iterations;
+
+    // RUN
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure([&]()
+                                              {
+#pragma omp parallel
+                                                  l_kernel_t(l_iterations); },
+                                              m_runTime,
+                                              l_num_reps,
+                                              l_elapsed);
+    // END RUN
+
+    // Calculate metrics, every FMLA (4S) performs 4 multiplications and 4 additions
+    long   l_totalOperations = 8 * FMLAS_PER_ITERATION * m_iterations * l_stats.numThreads * l_num_reps;
+    double l_gflops          = ((double)l_totalOperations) / (l_num_reps * l_stats.median * 1e9);
+
+    // Store the results
+    m_benchmarkResult.numReps         = l_num_reps;
+    m_benchmarkResult.elapsedSeconds  = l_elapsed;
+    m_benchmarkResult.statistics      = l_stats;
+    m_benchmarkResult.totalOperations = l_totalOperations;
+    m_benchmarkResult.gflops          = l_gflops;
+}
@@ -0,0 +1,74 @@
+#include <mlc/benchmarks/Benchmark.h>
+#include <mlc/benchmarks/roofline/stream_triad.bench.h>
+#include <omp.h>
+#include <stdexcept>
+
+mini_jit::benchmarks::StreamTriadBench::StreamTriadBench(double  runTime,
+                                                         int64_t numElements) : Benchmark()
+{
+    if (numElements <= 0)
+    {
+        throw std::invalid_argument("The triad needs at least one element");
+    }
+    m_numElements = numElements;
+    m_runTime     = runTime;
+}
+
+void mini_jit::benchmarks::StreamTriadBench::run()
+{
+    m_A.resize(m_numElements);
+    m_B.resize(m_numElements);
+    m_C.resize(m_numElements);
+
+    float*        l_a      = m_A.data();
+    float*        l_b      = m_B.data();
+    float*        l_c      = m_C.data();
+    int64_t const l_size   = m_numElements;
+    float const   l_scalar = 3.0f;
+
+    // first touch by the threads which access the elements later
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < l_size; ++i)
+    {
+        l_a[i] = 0.0f;
+        l_b[i] = 1.0f;
+        l_c[i] = 2.0f;
+    }
+
+    // RUN
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure([&]()
+                                              {
+#pragma omp parallel for schedule(static)
+                                                  for (int64_t i = 0; i < l_size; ++i)
+                                                  {
+                                                      l_a[i] = l_b[i] + l_scalar * l_c[i];
+                                                  } },
+                                              m_runTime,
+                                              l_num_reps,
+                                              l_elapsed,
+                                              true);
+    // END RUN
+
+    // Calculate metrics, two elements are read and one is written
+    long   l_totalNumberElements = m_numElements * l_num_reps * 3;
+    double l_totalDataProcessed  = (sizeof(float) * l_totalNumberElements) / (1024.0 * 1024.0 * 1024.0);
+    double l_gibps               = l_totalDataProcessed / (l_num_reps * l_stats.median);
+    long   l_totalOperations     = 2 * m_numElements * l_num_reps;
+    double l_gflops              = ((double)l_totalOperations) / (l_num_reps * l_stats.median * 1e9);
+
+    // Store the results
+    m_benchmarkResult.numReps             = l_num_reps;
+    m_benchmarkResult.elapsedSeconds      = l_elapsed;
+    m_benchmarkResult.statistics          = l_stats;
+    m_benchmarkResult.totalNumberElements = m_numElements * l_num_reps;
+    m_benchmarkResult.totalDataProcessed  = l_totalDataProcessed;
+    m_benchmarkResult.gibps               = l_gibps;
+    m_benchmarkResult.totalOperations     = l_totalOperations;
+    m_benchmarkResult.gflops              = l_gflops;
+
+    m_A.clear();
+    m_B.clear();
+    m_C.clear();
+}
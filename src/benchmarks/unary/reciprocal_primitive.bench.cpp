@@ -1,4 +1,3 @@
-#include <chrono>
 #include <mlc/Kernel.h>
 #include <mlc/Unary.h>
 #include <mlc/benchmarks/Benchmark.h>
@@ -37,31 +36,31 @@ void mini_jit::benchmarks::ReciprocalPrimitiveBench::run()
     mini_jit::Unary::kernel_t l_kernel_t = reinterpret_cast<mini_jit::Unary::kernel_t>(const_cast<void*>(l_kernel.get_kernel()));
 
     // RUN
-    long   l_num_reps   = 0;
-    auto   l_start_time = std::chrono::high_resolution_clock::now();
-    double l_elapsed    = 0.0;
-    double l_runTimeMs  = m_runTime * 1e6;
-    do
-    {
-        l_kernel_t(m_A, m_B, m_M, m_M, nullptr);
-        ++l_num_reps;
-        auto l_now = std::chrono::high_resolution_clock::now();
-        l_elapsed  = std::chrono::duration_cast<std::chrono::microseconds>(l_now - l_start_time).count();
-    } while (l_elapsed < l_runTimeMs);
-    l_elapsed /= 1e6; // Convert to seconds
+    long                 l_num_reps = 0;
+    double               l_elapsed  = 0.0;
+    benchmark_statistics l_stats    = measure([&]()
+                                              { l_kernel_t(m_A, m_B, m_M, m_M, nullptr); },
+                                              m_runTime,
+                                              l_num_reps,
+                                              l_elapsed);
     // END RUN
 
     // Calculate metrics
     long   l_totalNumberElements = m_M * m_N * l_num_reps * 2;
     double l_totalDataProcessed  = (sizeof(float) * l_totalNumberElements) / (1024.0 * 1024.0 * 1024.0);
-    double l_gibps               = l_totalDataProcessed / l_elapsed;
+    double l_gibps               = l_totalDataProcessed / (l_num_reps * l_stats.median);
+    long   l_totalOperations     = l_num_reps * (m_M * m_N);
+    double l_gflops              = ((double)l_totalOperations) / (l_num_reps * l_stats.median * 1e9);
 
     // Store the results
     m_benchmarkResult.numReps             = l_num_reps;
     m_benchmarkResult.elapsedSeconds      = l_elapsed;
+    m_benchmarkResult.statistics          = l_stats;
     m_benchmarkResult.totalNumberElements = m_M * m_N * l_num_reps;
     m_benchmarkResult.totalDataProcessed  = l_totalDataProcessed;
     m_benchmarkResult.gibps               = l_gibps;
+    m_benchmarkResult.totalOperations     = l_totalOperations;
+    m_benchmarkResult.gflops              = l_gflops;
 
     delete[] m_A;
     delete[] m_B;
@@ -0,0 +1,382 @@
+#include <algorithm>
+#include <cstring>
+#include <mlc/Tracer.h>
+#include <mlc/einsum/EinsumPlan.h>
+#include <mlc/einsum/EinsumTree.h>
+#include <new>
+#include <omp.h>
+#include <stdexcept>
+
+mini_jit::einsum::EinsumPlan::scratch_t::scratch_t(int64_t size)
+    : m_data(::operator new(static_cast<std::size_t>(size), std::align_val_t{SCRATCH_ALIGNMENT}))
+{
+}
+
+mini_jit::einsum::EinsumPlan::scratch_t::~scratch_t() noexcept
+{
+    ::operator delete(m_data, std::align_val_t{SCRATCH_ALIGNMENT});
+}
+
+mini_jit::einsum::EinsumPlan::EinsumPlan(std::string const&             einsum_expression,
+                                         std::vector<int64_t> const&    dimension_sizes,
+                                         dtype_t                        dtype,
+                                         int64_t                        thread_target,
+                                         int64_t                        max_kernel_size,
+                                         int64_t                        min_kernel_size,
+                                         mini_jit::ir::CostModel const& cost_model)
+    : m_dimension_sizes(dimension_sizes), m_dtype(dtype)
+{
+    /////////////////////////////////////////////////////////////////////
+    // Find the input tensors in the order of the expression
+    /////////////////////////////////////////////////////////////////////
+    // inputs are the innermost brackets which are not preceded by an arrow
+    size_t l_open_pos = std::string::npos;
+    for (size_t i = 0; i < einsum_expression.size(); i++)
+    {
+        if (einsum_expression[i] == '[')
+        {
+            l_open_pos = i;
+        }
+        else if (einsum_expression[i] == ']' && l_open_pos != std::string::npos)
+        {
+            bool l_is_output = l_open_pos >= 2 && einsum_expression.compare(l_open_pos - 2, 2, "->") == 0;
+            if (!l_is_output)
+            {
+                std::string l_input = einsum_expression.substr(l_open_pos + 1, i - l_open_pos - 1);
+                if (std::find(m_input_expressions.begin(), m_input_expressions.end(), l_input) == m_input_expressions.end())
+                {
+                    m_input_expressions.push_back(l_input);
+                }
+            }
+            l_open_pos = std::string::npos;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////
+    // Parse, optimize and lower the einsum tree
+    /////////////////////////////////////////////////////////////////////
+    m_root.reset(EinsumTree::parse_einsum_expression(einsum_expression, m_dimension_sizes));
+    if (m_root->get_number_of_children() == 0)
+    {
+        // a single tensor without an arrow is its own input
+        m_input_expressions = {m_root->m_tensor_expression};
+    }
+
+    EinsumTree::optimize_einsum_nodes(m_root.get(),
+                                      thread_target,
+                                      max_kernel_size,
+                                      min_kernel_size,
+                                      cost_model);
+    mini_jit::error_t l_error = EinsumTree::lower_einsum_nodes_to_tensor_operations(m_root.get(),
+                                                                                    m_dimension_sizes,
+                                                                                    m_dtype);
+    if (l_error != mini_jit::error_t::success)
+    {
+        throw std::invalid_argument("EinsumPlan: Failed to set up a tensor operation: " + mini_jit::to_string(l_error));
+    }
+
+    const int64_t l_dtype_size = m_dtype == dtype_t::fp32 ? 4 : 8;
+    m_output_size              = m_root->m_tensor_size * l_dtype_size;
+
+    /////////////////////////////////////////////////////////////////////
+    // Create the schedule and the memory plan
+    /////////////////////////////////////////////////////////////////////
+    schedule(m_root.get(), true);
+    plan_memory();
+}
+
+mini_jit::einsum::EinsumPlan::~EinsumPlan() noexcept = default;
+
+mini_jit::einsum::EinsumPlan::buffer_t mini_jit::einsum::EinsumPlan::schedule(EinsumNode const* node,
+                                                                              bool              is_root)
+{
+    buffer_t l_buffer;
+
+    // leaf nodes are read directly from the input tensors
+    if (node->get_number_of_children() == 0)
+    {
+        auto l_it = std::find(m_input_expressions.begin(),
+                              m_input_expressions.end(),
+                              node->m_tensor_expression);
+        if (l_it == m_input_expressions.end())
+        {
+            throw std::invalid_argument("EinsumPlan: Unknown input tensor " + node->m_tensor_expression);
+        }
+        l_buffer.kind  = buffer_t::kind_t::input;
+        l_buffer.value = std::distance(m_input_expressions.begin(), l_it);
+        return l_buffer;
+    }
+
+    step_t l_step;
+    l_step.node = node;
+    l_step.in0  = schedule(node->m_left_child, false);
+    if (node->m_right_child != nullptr)
+    {
+        l_step.in1 = schedule(node->m_right_child, false);
+    }
+
+    const int64_t l_dtype_size = m_dtype == dtype_t::fp32 ? 4 : 8;
+    l_step.out_bytes           = node->m_tensor_size * l_dtype_size;
+
+    if (is_root)
+    {
+        l_buffer.kind = buffer_t::kind_t::output;
+    }
+    else
+    {
+        // the scratch offset is assigned by plan_memory, until then the value is the step id
+        l_buffer.kind  = buffer_t::kind_t::scratch;
+        l_buffer.value = static_cast<int64_t>(m_steps.size());
+    }
+    l_step.out = l_buffer;
+
+    m_steps.push_back(l_step);
+    m_code_size += static_cast<int64_t>(node->m_operation.get_code_size());
+
+    return l_buffer;
+}
+
+void mini_jit::einsum::EinsumPlan::plan_memory()
+{
+    // lifetime of every intermediate tensor: [producing step, last consuming step]
+    std::vector<int64_t> l_last_use(m_steps.size(), -1);
+    for (size_t l_step_id = 0; l_step_id < m_steps.size(); l_step_id++)
+    {
+        for (buffer_t const* l_in : {&m_steps[l_step_id].in0, &m_steps[l_step_id].in1})
+        {
+            if (l_in->kind == buffer_t::kind_t::scratch)
+            {
+                l_last_use[l_in->value] = static_cast<int64_t>(l_step_id);
+            }
+        }
+    }
+
+    // first fit: place every tensor at the lowest offset which does not
+    // collide with an already placed tensor of an overlapping lifetime
+    std::vector<int64_t> l_offsets(m_steps.size(), -1);
+    m_scratch_size = 0;
+    for (size_t l_step_id = 0; l_step_id < m_steps.size(); l_step_id++)
+    {
+        step_t const& l_step = m_steps[l_step_id];
+        if (l_step.out.kind != buffer_t::kind_t::scratch)
+        {
+            continue;
+        }
+
+        // collect the memory ranges of all placed tensors which are alive at the same time
+        std::vector<std::pair<int64_t, int64_t>> l_occupied;
+        for (size_t l_other_id = 0; l_other_id < l_step_id; l_other_id++)
+        {
+            if (l_offsets[l_other_id] != -1 &&
+                l_last_use[l_other_id] >= static_cast<int64_t>(l_step_id))
+            {
+                l_occupied.push_back({l_offsets[l_other_id],
+                                      l_offsets[l_other_id] + m_steps[l_other_id].out_bytes});
+            }
+        }
+        std::sort(l_occupied.begin(), l_occupied.end());
+
+        int64_t l_offset = 0;
+        for (auto const& [l_begin, l_end] : l_occupied)
+        {
+            if (l_offset + l_step.out_bytes <= l_begin)
+            {
+                break;
+            }
+            l_offset = std::max(l_offset,
+                                (l_end + SCRATCH_ALIGNMENT - 1) / SCRATCH_ALIGNMENT * SCRATCH_ALIGNMENT);
+        }
+
+        l_offsets[l_step_id] = l_offset;
+        m_scratch_size       = std::max(m_scratch_size, l_offset + l_step.out_bytes);
+    }
+
+    // replace the step ids by the scratch offsets
+    for (step_t& l_step : m_steps)
+    {
+        for (buffer_t* l_buffer : {&l_step.in0, &l_step.in1, &l_step.out})
+        {
+            if (l_buffer->kind == buffer_t::kind_t::scratch)
+            {
+                l_buffer->value = l_offsets[l_buffer->value];
+            }
+        }
+    }
+}
+
+void* mini_jit::einsum::EinsumPlan::resolve(buffer_t const&                 buffer,
+                                            std::vector<void const*> const& inputs,
+                                            void*                           output,
+                                            void*                           scratch)
+{
+    switch (buffer.kind)
+    {
+    case buffer_t::kind_t::input:
+        // inputs are only read by the tensor operations
+        return const_cast<void*>(inputs[buffer.value]);
+    case buffer_t::kind_t::scratch:
+        return static_cast<char*>(scratch) + buffer.value;
+    case buffer_t::kind_t::output:
+        return output;
+    default:
+        return nullptr;
+    }
+}
+
+void mini_jit::einsum::EinsumPlan::execute(std::vector<void const*> const& inputs,
+                                           void*                           output,
+                                           void*                           scratch) const
+{
+    if (inputs.size() != m_input_expressions.size())
+    {
+        throw std::invalid_argument("EinsumPlan: Expected " + std::to_string(m_input_expressions.size()) +
+                                    " input tensors, got " + std::to_string(inputs.size()));
+    }
+    if (m_scratch_size > 0 && scratch == nullptr)
+    {
+        throw std::invalid_argument("EinsumPlan: Missing scratch buffer");
+    }
+
+    execute_steps(inputs, output, scratch, true);
+}
+
+void mini_jit::einsum::EinsumPlan::execute_steps(std::vector<void const*> const& inputs,
+                                                 void*                           output,
+                                                 void*                           scratch,
+                                                 bool                            parallel) const
+{
+    // the expression is a single tensor
+    if (m_steps.empty())
+    {
+        MLC_TRACE_SCOPE("einsum", "copy_input");
+        std::memcpy(output, inputs[0], m_output_size);
+        return;
+    }
+
+    for (step_t const& l_step : m_steps)
+    {
+        MLC_TRACE_SCOPE("einsum", l_step.node->m_tensor_expression);
+
+        void* l_ptr_in0 = resolve(l_step.in0, inputs, output, scratch);
+        void* l_ptr_in1 = resolve(l_step.in1, inputs, output, scratch);
+        void* l_ptr_out = resolve(l_step.out, inputs, output, scratch);
+
+        // operations which accumulate into their output need a zeroed tensor
+        if (l_step.node->m_zero_output)
+        {
+            MLC_TRACE_SCOPE("einsum", "zero_fill");
+            std::memset(l_ptr_out, 0, l_step.out_bytes);
+        }
+
+        if (parallel)
+        {
+            l_step.node->m_operation.execute(l_ptr_in0,
+                                             l_ptr_in1,
+                                             l_ptr_out);
+        }
+        else
+        {
+            l_step.node->m_operation.execute_sequential(l_ptr_in0,
+                                                        l_ptr_in1,
+                                                        l_ptr_out);
+        }
+    }
+}
+
+void mini_jit::einsum::EinsumPlan::execute_batched(int64_t                         batch_size,
+                                                   std::vector<void const*> const& inputs,
+                                                   std::vector<int64_t> const&     input_batch_strides,
+                                                   void*                           output,
+                                                   int64_t                         output_batch_stride) const
+{
+    if (inputs.size() != m_input_expressions.size())
+    {
+        throw std::invalid_argument("EinsumPlan: Expected " + std::to_string(m_input_expressions.size()) +
+                                    " input tensors, got " + std::to_string(inputs.size()));
+    }
+    if (input_batch_strides.size() != inputs.size())
+    {
+        throw std::invalid_argument("EinsumPlan: Expected " + std::to_string(inputs.size()) +
+                                    " input batch strides, got " + std::to_string(input_batch_strides.size()));
+    }
+
+    const int64_t l_dtype_size = m_dtype == dtype_t::fp32 ? 4 : 8;
+
+    // pointers to the tensors of a single sample
+    auto l_get_sample = [&](int64_t                   sample,
+                            std::vector<void const*>& o_inputs) -> void*
+    {
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            o_inputs[i] = static_cast<char const*>(inputs[i]) + sample * input_batch_strides[i] * l_dtype_size;
+        }
+        return static_cast<char*>(output) + sample * output_batch_stride * l_dtype_size;
+    };
+
+    // small batches: parallelize inside the operations
+    if (batch_size < omp_get_max_threads())
+    {
+        scratch_t                l_scratch(m_scratch_size);
+        std::vector<void const*> l_inputs(inputs.size());
+        for (int64_t l_sample = 0; l_sample < batch_size; l_sample++)
+        {
+            void* l_output = l_get_sample(l_sample, l_inputs);
+            execute_steps(l_inputs, l_output, l_scratch.data(), true);
+        }
+        return;
+    }
+
+    // large batches: the batch is the outermost shared loop of the whole tree
+#pragma omp parallel
+    {
+        // allocated once per thread and reused for all of its samples
+        scratch_t                l_scratch(m_scratch_size);
+        std::vector<void const*> l_inputs(inputs.size());
+
+        // ends before the barrier, so the spans of the threads show the load imbalance
+        MLC_TRACE_SCOPE("einsum", "batch_worker");
+#pragma omp for schedule(static) nowait
+        for (int64_t l_sample = 0; l_sample < batch_size; l_sample++)
+        {
+            void* l_output = l_get_sample(l_sample, l_inputs);
+            execute_steps(l_inputs, l_output, l_scratch.data(), false);
+        }
+    }
+}
+
+void mini_jit::einsum::EinsumPlan::execute(std::map<std::string, void const*> const& inputs,
+                                           void*                                     output,
+                                           void*                                     scratch) const
+{
+    std::vector<void const*> l_inputs;
+    l_inputs.reserve(m_input_expressions.size());
+    for (std::string const& l_expression : m_input_expressions)
+    {
+        auto l_it = inputs.find(l_expression);
+        if (l_it == inputs.end())
+        {
+            throw std::invalid_argument("Error: No input tensor found for leaf node with expression: " +
+                                        l_expression);
+        }
+        l_inputs.push_back(l_it->second);
+    }
+
+    execute(l_inputs, output, scratch);
+}
+
+void mini_jit::einsum::EinsumPlan::execute(std::vector<void const*> const& inputs,
+                                           void*                           output) const
+{
+    scratch_t l_scratch(m_scratch_size);
+    execute(inputs, output, l_scratch.data());
+}
+
+std::string mini_jit::einsum::EinsumPlan::to_string() const
+{
+    return EinsumTree::to_string(m_root.get());
+}
+
+std::string mini_jit::einsum::EinsumPlan::to_json() const
+{
+    return EinsumTree::to_json(m_root.get());
+}
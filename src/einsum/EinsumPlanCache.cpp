@@ -0,0 +1,139 @@
+#include <functional>
+#include <mlc/einsum/EinsumPlanCache.h>
+
+std::size_t mini_jit::einsum::EinsumPlanCache::key_hash_t::operator()(key_t const& key) const
+{
+    // boost::hash_combine
+    std::size_t l_hash    = std::hash<std::string>{}(key.expression);
+    auto        l_combine = [&l_hash](int64_t value)
+    {
+        l_hash ^= std::hash<int64_t>{}(value) + 0x9e3779b97f4a7c15ULL + (l_hash << 6) + (l_hash >> 2);
+    };
+
+    for (int64_t l_size : key.dimension_sizes)
+    {
+        l_combine(l_size);
+    }
+    l_combine(static_cast<int64_t>(key.dtype));
+    l_combine(key.thread_target);
+    l_combine(key.max_kernel_size);
+    l_combine(key.min_kernel_size);
+
+    return l_hash;
+}
+
+mini_jit::einsum::EinsumPlanCache::EinsumPlanCache(int64_t max_size)
+    : m_max_size(max_size)
+{
+}
+
+std::shared_ptr<mini_jit::einsum::EinsumPlan const> mini_jit::einsum::EinsumPlanCache::get(std::string const&          einsum_expression,
+                                                                                           std::vector<int64_t> const& dimension_sizes,
+                                                                                           dtype_t                     dtype,
+                                                                                           int64_t                     thread_target,
+                                                                                           int64_t                     max_kernel_size,
+                                                                                           int64_t                     min_kernel_size)
+{
+    key_t l_key{einsum_expression,
+                dimension_sizes,
+                dtype,
+                thread_target,
+                max_kernel_size,
+                min_kernel_size};
+
+    {
+        std::lock_guard<std::mutex> l_lock(m_mutex);
+
+        auto l_it = m_index.find(l_key);
+        if (l_it != m_index.end())
+        {
+            // move to the front of the LRU list
+            m_entries.splice(m_entries.begin(), m_entries, l_it->second);
+            m_num_hits++;
+            return l_it->second->plan;
+        }
+        m_num_misses++;
+    }
+
+    // compile without holding the lock, so that other expressions can be served meanwhile
+    auto l_plan = std::make_shared<EinsumPlan const>(einsum_expression,
+                                                     dimension_sizes,
+                                                     dtype,
+                                                     thread_target,
+                                                     max_kernel_size,
+                                                     min_kernel_size);
+
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+
+    // another thread may have compiled the same plan in the meantime
+    auto l_it = m_index.find(l_key);
+    if (l_it != m_index.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, l_it->second);
+        return l_it->second->plan;
+    }
+
+    int64_t l_footprint = l_plan->get_code_size() + l_plan->get_scratch_size();
+    if (l_footprint > m_max_size)
+    {
+        // the plan alone exceeds the limit, hand it out without caching
+        return l_plan;
+    }
+
+    m_entries.push_front({l_key, l_plan, l_footprint});
+    m_index[l_key] = m_entries.begin();
+    m_size += l_footprint;
+    evict();
+
+    return l_plan;
+}
+
+void mini_jit::einsum::EinsumPlanCache::evict()
+{
+    while (m_size > m_max_size && !m_entries.empty())
+    {
+        entry_t const& l_entry = m_entries.back();
+        m_size -= l_entry.footprint;
+        m_index.erase(l_entry.key);
+        m_entries.pop_back();
+        m_num_evictions++;
+    }
+}
+
+void mini_jit::einsum::EinsumPlanCache::clear()
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    m_index.clear();
+    m_entries.clear();
+    m_size = 0;
+}
+
+int64_t mini_jit::einsum::EinsumPlanCache::get_size() const
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return m_size;
+}
+
+int64_t mini_jit::einsum::EinsumPlanCache::get_number_of_plans() const
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return static_cast<int64_t>(m_entries.size());
+}
+
+int64_t mini_jit::einsum::EinsumPlanCache::get_number_of_hits() const
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return m_num_hits;
+}
+
+int64_t mini_jit::einsum::EinsumPlanCache::get_number_of_misses() const
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return m_num_misses;
+}
+
+int64_t mini_jit::einsum::EinsumPlanCache::get_number_of_evictions() const
+{
+    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return m_num_evictions;
+}
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <mlc/Tracer.h>
 #include <mlc/einsum/EinsumNode.h>
 #include <mlc/einsum/EinsumTree.h>
 #include <mlc/ir/Optimizer.h>
@@ -22,6 +24,9 @@ mini_jit::einsum::EinsumNode* mini_jit::einsum::EinsumTree::parse_einsum_express
 
     mini_jit::einsum::EinsumNode* l_root_node = parse_einsum_expression_recursive(einsum_expression);
 
+    // explicit permutations of intermediate results are written by the producing contraction
+    l_root_node = fold_permutation_nodes(l_root_node);
+
     // plain swapping is not needed anymore,
     // since the reordering will do swapping as well
     // swap_nodes(l_root_node);
@@ -30,6 +35,9 @@ mini_jit::einsum::EinsumNode* mini_jit::einsum::EinsumTree::parse_einsum_express
     // it also needs to be done before initializing the nodes
     reorder_node_dimensions(l_root_node);
 
+    // the remaining freedom in the layouts of intermediate tensors is used to avoid strided loops
+    propagate_layouts(l_root_node);
+
     initialize_einsum_nodes(l_root_node, dimension_sizes);
 
     return l_root_node;
@@ -274,10 +282,11 @@ void mini_jit::einsum::EinsumTree::initialize_einsum_nodes(EinsumNode*
     }
 }
 
-void mini_jit::einsum::EinsumTree::optimize_einsum_nodes(EinsumNode* root_node,
-                                                         int64_t     thread_target,
-                                                         int64_t     max_kernel_size,
-                                                         int64_t     min_kernel_size)
+void mini_jit::einsum::EinsumTree::optimize_einsum_nodes(EinsumNode*                    root_node,
+                                                         int64_t                        thread_target,
+                                                         int64_t                        max_kernel_size,
+                                                         int64_t                        min_kernel_size,
+                                                         mini_jit::ir::CostModel const& cost_model)
 {
     if (root_node == nullptr)
     {
@@ -291,28 +300,33 @@ void mini_jit::einsum::EinsumTree::optimize_einsum_nodes(EinsumNode* root_node,
     }
 
     // optimize children
-    optimize_einsum_nodes(root_node->m_left_child, thread_target, max_kernel_size, min_kernel_size);
-    optimize_einsum_nodes(root_node->m_right_child, thread_target, max_kernel_size, min_kernel_size);
+    optimize_einsum_nodes(root_node->m_left_child, thread_target, max_kernel_size, min_kernel_size, cost_model);
+    optimize_einsum_nodes(root_node->m_right_child, thread_target, max_kernel_size, min_kernel_size, cost_model);
 
-    // optimize current node
+    // optimize current node, the report is kept with the operation for diagnostics
+    mini_jit::ir::OptimizationReport l_report;
     mini_jit::ir::Optimizer::optimize(root_node->m_dim_types,
                                       root_node->m_exec_types,
                                       root_node->m_dim_sizes,
                                       root_node->m_strides_in0,
                                       root_node->m_strides_in1,
                                       root_node->m_strides_out,
+                                      root_node->m_dim_remainders,
                                       thread_target,
                                       max_kernel_size,
-                                      min_kernel_size);
+                                      min_kernel_size,
+                                      cost_model,
+                                      &l_report);
+    root_node->m_operation.set_report(l_report);
 }
 
-void mini_jit::einsum::EinsumTree::lower_einsum_nodes_to_tensor_operations(EinsumNode*           root_node,
-                                                                           std::vector<int64_t>& dimension_sizes,
-                                                                           mini_jit::dtype_t     dtype)
+mini_jit::error_t mini_jit::einsum::EinsumTree::lower_einsum_nodes_to_tensor_operations(EinsumNode*           root_node,
+                                                                                        std::vector<int64_t>& dimension_sizes,
+                                                                                        mini_jit::dtype_t     dtype)
 {
     if (root_node == nullptr)
     {
-        return;
+        return error_t::success;
     }
 
     // operations for all nodes
@@ -322,54 +336,71 @@ void mini_jit::einsum::EinsumTree::lower_einsum_nodes_to_tensor_operations(Einsu
     // no further operations for input nodes
     if (root_node->get_number_of_children() == 0)
     {
-        return;
+        return error_t::success;
     }
 
     // lower children
-    lower_einsum_nodes_to_tensor_operations(root_node->m_left_child, dimension_sizes, dtype);
-    lower_einsum_nodes_to_tensor_operations(root_node->m_right_child, dimension_sizes, dtype);
+    error_t l_error = lower_einsum_nodes_to_tensor_operations(root_node->m_left_child, dimension_sizes, dtype);
+    if (l_error != error_t::success)
+    {
+        return l_error;
+    }
+    l_error = lower_einsum_nodes_to_tensor_operations(root_node->m_right_child, dimension_sizes, dtype);
+    if (l_error != error_t::success)
+    {
+        return l_error;
+    }
 
     // lower current node
-    int               l_prim_count = std::count(root_node->m_exec_types.begin(), root_node->m_exec_types.end(), exec_t::prim);
-    mini_jit::ptype_t l_main_ptype = mini_jit::ptype_t::none;
+    int               l_prim_count        = std::count(root_node->m_exec_types.begin(), root_node->m_exec_types.end(), exec_t::prim);
+    mini_jit::ptype_t l_first_touch_ptype = mini_jit::ptype_t::none;
+    mini_jit::ptype_t l_main_ptype        = mini_jit::ptype_t::none;
     if (l_prim_count == 2)
     {
-        l_main_ptype                          = mini_jit::ptype_t::identity;
-        root_node->m_computational_operations = 0.0; // no operations for identity
+        l_main_ptype = mini_jit::ptype_t::identity;
     }
     else if (l_prim_count == 3)
     {
-        l_main_ptype                          = mini_jit::ptype_t::gemm;
-        root_node->m_computational_operations = 2.0f;
-        for (int64_t size : root_node->m_dim_sizes)
-        {
-            root_node->m_computational_operations *= size;
-        }
+        l_main_ptype = mini_jit::ptype_t::gemm;
     }
     else if (l_prim_count == 4)
     {
-        l_main_ptype                          = mini_jit::ptype_t::brgemm;
-        root_node->m_computational_operations = 2.0f;
-        for (int64_t size : root_node->m_dim_sizes)
+        l_main_ptype = mini_jit::ptype_t::brgemm;
+    }
+
+    // identity operations have no floating point operations
+    if (l_main_ptype == mini_jit::ptype_t::gemm || l_main_ptype == mini_jit::ptype_t::brgemm)
+    {
+        // the optimized loops of peeled dimensions cover more than the original sizes
+        root_node->m_computational_operations = 2.0;
+        for (int64_t dim_id : root_node->m_dimension_ids)
         {
-            root_node->m_computational_operations *= size;
+            root_node->m_computational_operations *= dimension_sizes[dim_id];
         }
+
+        // contractions accumulate into the output, so the output tile is zeroed by a
+        // first touch kernel while it is in cache instead of zeroing the whole tensor upfront
+        l_first_touch_ptype = mini_jit::ptype_t::zero;
     }
+    // identity operations overwrite every output element
+    root_node->m_zero_output = l_main_ptype != mini_jit::ptype_t::identity &&
+                               l_first_touch_ptype != mini_jit::ptype_t::zero;
 
     // add child ops
     root_node->m_computational_operations += root_node->m_left_child ? root_node->m_left_child->m_computational_operations : 0.0;
     root_node->m_computational_operations += root_node->m_right_child ? root_node->m_right_child->m_computational_operations : 0.0;
 
-    root_node->m_operation.setup(root_node->m_dtype,
-                                 ptype_t::none,
-                                 l_main_ptype,
-                                 ptype_t::none,
-                                 root_node->m_dim_types,
-                                 root_node->m_exec_types,
-                                 root_node->m_dim_sizes,
-                                 root_node->m_strides_in0,
-                                 root_node->m_strides_in1,
-                                 root_node->m_strides_out);
+    return root_node->m_operation.setup(root_node->m_dtype,
+                                        l_first_touch_ptype,
+                                        l_main_ptype,
+                                        ptype_t::none,
+                                        root_node->m_dim_types,
+                                        root_node->m_exec_types,
+                                        root_node->m_dim_sizes,
+                                        root_node->m_strides_in0,
+                                        root_node->m_strides_in1,
+                                        root_node->m_strides_out,
+                                        root_node->m_dim_remainders);
 }
 
 void mini_jit::einsum::EinsumTree::execute(EinsumNode*                         root_node,
@@ -381,16 +412,23 @@ void mini_jit::einsum::EinsumTree::execute(EinsumNode*                         r
         return;
     }
 
+    // spans of the children are nested in the span of their parent
+    MLC_TRACE_SCOPE("einsum", root_node->m_tensor_expression);
+
     const int64_t l_tensor_size = root_node->m_tensor_size;
 
+    // leaves are overwritten by their input, other nodes only if the operation writes every element
+    const bool l_zero_output = root_node->get_number_of_children() > 0 && root_node->m_zero_output;
+
     if (root_node->m_dtype == mini_jit::dtype_t::fp32)
     {
         if (root_node->m_tensor_out == nullptr)
         {
             root_node->m_tensor_out = new float[l_tensor_size]{0.0f};
         }
-        else
+        else if (l_zero_output)
         {
+            MLC_TRACE_SCOPE("einsum", "zero_fill");
             std::fill(static_cast<float*>(root_node->m_tensor_out),
                       static_cast<float*>(root_node->m_tensor_out) + l_tensor_size,
                       0.0f);
@@ -402,8 +440,9 @@ void mini_jit::einsum::EinsumTree::execute(EinsumNode*                         r
         {
             root_node->m_tensor_out = new double[l_tensor_size]{0.0};
         }
-        else
+        else if (l_zero_output)
         {
+            MLC_TRACE_SCOPE("einsum", "zero_fill");
             std::fill(static_cast<double*>(root_node->m_tensor_out),
                       static_cast<double*>(root_node->m_tensor_out) + l_tensor_size,
                       0.0);
@@ -417,6 +456,7 @@ void mini_jit::einsum::EinsumTree::execute(EinsumNode*                         r
         auto it = tensor_inputs.find(root_node->m_tensor_expression);
         if (it != tensor_inputs.end())
         {
+            MLC_TRACE_SCOPE("einsum", "copy_input");
             if (root_node->m_dtype == mini_jit::dtype_t::fp32)
             {
                 std::copy(
@@ -504,7 +544,18 @@ void mini_jit::einsum::EinsumTree::reorder_node_dimensions(EinsumNode* root_node
                                     " and parent " +
                                     root_node->m_tensor_expression);
     }
-    // M is in output dims but not the right-most element
+    // M is in output dims but not the right-most element,
+    // the child computes its output in a layout with M as unit stride dimension
+    else if (l_dim_child_m_it < root_node->m_left_child->m_output_dimension_ids.end() - 1 &&
+             can_reorder_output(root_node->m_left_child, l_parent_dim_id))
+    {
+        std::rotate(l_dim_child_m_it,
+                    l_dim_child_m_it + 1,
+                    root_node->m_left_child->m_output_dimension_ids.end());
+        root_node->m_left_child->m_tensor_expression = to_expression(root_node->m_left_child->m_output_dimension_ids);
+        remove_redundant_permutation(root_node->m_left_child);
+    }
+    // M is in output dims but not the right-most element, the child is an input tensor
     else if (l_dim_child_m_it < root_node->m_left_child->m_output_dimension_ids.end() - 1)
     {
         EinsumNode* l_left_child_permute = new EinsumNode(root_node->m_left_child->m_output_dimension_ids,
@@ -519,16 +570,7 @@ void mini_jit::einsum::EinsumTree::reorder_node_dimensions(EinsumNode* root_node
         std::rotate(l_new_m_it, l_new_m_it + 1, l_left_child_permute->m_output_dimension_ids.end());
 
         // update expression of the new permute node
-        std::string l_new_expression = "";
-        for (size_t i = 0; i < l_left_child_permute->m_output_dimension_ids.size(); i++)
-        {
-            if (i > 0)
-            {
-                l_new_expression += ",";
-            }
-            l_new_expression += std::to_string(l_left_child_permute->m_output_dimension_ids[i]);
-        }
-        l_left_child_permute->m_tensor_expression = l_new_expression;
+        l_left_child_permute->m_tensor_expression = to_expression(l_left_child_permute->m_output_dimension_ids);
 
         // insert into the tree
         root_node->m_left_child = l_left_child_permute;
@@ -562,7 +604,18 @@ void mini_jit::einsum::EinsumTree::reorder_node_dimensions(EinsumNode* root_node
                                     " and parent " +
                                     root_node->m_tensor_expression);
     }
-    // K is in output dims but not the right-most element
+    // K is in output dims but not the right-most element,
+    // the child computes its output in a layout with K as unit stride dimension
+    else if (l_dim_child_k_it < root_node->m_right_child->m_output_dimension_ids.end() - 1 &&
+             can_reorder_output(root_node->m_right_child, l_k_dim_id))
+    {
+        std::rotate(l_dim_child_k_it,
+                    l_dim_child_k_it + 1,
+                    root_node->m_right_child->m_output_dimension_ids.end());
+        root_node->m_right_child->m_tensor_expression = to_expression(root_node->m_right_child->m_output_dimension_ids);
+        remove_redundant_permutation(root_node->m_right_child);
+    }
+    // K is in output dims but not the right-most element, the child is an input tensor
     else if (l_dim_child_k_it < root_node->m_right_child->m_output_dimension_ids.end() - 1)
     {
         EinsumNode* l_right_child_permute = new EinsumNode(root_node->m_right_child->m_output_dimension_ids,
@@ -577,16 +630,7 @@ void mini_jit::einsum::EinsumTree::reorder_node_dimensions(EinsumNode* root_node
         std::rotate(l_new_k_it, l_new_k_it + 1, l_right_child_permute->m_output_dimension_ids.end());
 
         // update expression of the new permute node
-        std::string l_new_expression = "";
-        for (size_t i = 0; i < l_right_child_permute->m_output_dimension_ids.size(); i++)
-        {
-            if (i > 0)
-            {
-                l_new_expression += ",";
-            }
-            l_new_expression += std::to_string(l_right_child_permute->m_output_dimension_ids[i]);
-        }
-        l_right_child_permute->m_tensor_expression = l_new_expression;
+        l_right_child_permute->m_tensor_expression = to_expression(l_right_child_permute->m_output_dimension_ids);
 
         // insert into the tree
         root_node->m_right_child = l_right_child_permute;
@@ -597,6 +641,250 @@ void mini_jit::einsum::EinsumTree::reorder_node_dimensions(EinsumNode* root_node
     reorder_node_dimensions(root_node->m_right_child);
 }
 
+void mini_jit::einsum::EinsumTree::propagate_layouts(EinsumNode* root_node)
+{
+    if (root_node == nullptr || root_node->get_number_of_children() == 0)
+    {
+        return;
+    }
+
+    // the layout of the parent is fixed before the layouts of its children are chosen
+    choose_layout(root_node, root_node->m_left_child);
+    if (root_node->m_right_child != nullptr)
+    {
+        choose_layout(root_node, root_node->m_right_child);
+    }
+
+    propagate_layouts(root_node->m_left_child);
+    propagate_layouts(root_node->m_right_child);
+}
+
+void mini_jit::einsum::EinsumTree::choose_layout(EinsumNode*  parent_node,
+                                                 EinsumNode*& child_node)
+{
+    // the layout of input tensors is given by the user
+    if (child_node->get_number_of_children() == 0)
+    {
+        return;
+    }
+
+    // all orders of the non-unit stride dimensions are tried, which is limited to small tensors
+    std::vector<int64_t>& l_ids = child_node->m_output_dimension_ids;
+    if (l_ids.size() < 3 || l_ids.size() > 7)
+    {
+        return;
+    }
+
+    // the parent uses the right-most dimension of its first input which is also part of the
+    // second input as unit stride K dimension, this choice must not change
+    auto l_right_most_k = [parent_node](std::vector<int64_t> const& i_ids_left) -> int64_t
+    {
+        for (auto l_it = i_ids_left.rbegin(); l_it != i_ids_left.rend(); ++l_it)
+        {
+            if (contains(parent_node->m_right_child->m_output_dimension_ids, *l_it))
+            {
+                return *l_it;
+            }
+        }
+        return -1;
+    };
+    bool    l_is_left_input = parent_node->get_number_of_children() == 2 && parent_node->m_left_child == child_node;
+    int64_t l_k_dim_id      = l_is_left_input ? l_right_most_k(l_ids) : -1;
+
+    std::vector<int64_t> l_best_ids  = l_ids;
+    int64_t              l_best_cost = count_loops(parent_node) + count_loops(child_node);
+
+    std::vector<int64_t> l_candidate = l_ids;
+    std::sort(l_candidate.begin(), l_candidate.end() - 1);
+    do
+    {
+        if (l_is_left_input && l_right_most_k(l_candidate) != l_k_dim_id)
+        {
+            continue;
+        }
+
+        l_ids          = l_candidate;
+        int64_t l_cost = count_loops(parent_node) + count_loops(child_node);
+        if (l_cost < l_best_cost)
+        {
+            l_best_ids  = l_candidate;
+            l_best_cost = l_cost;
+        }
+    } while (std::next_permutation(l_candidate.begin(), l_candidate.end() - 1));
+
+    l_ids                           = l_best_ids;
+    child_node->m_tensor_expression = to_expression(l_ids);
+    remove_redundant_permutation(child_node);
+}
+
+int64_t mini_jit::einsum::EinsumTree::count_loops(EinsumNode const* node)
+{
+    if (node->get_number_of_children() == 0)
+    {
+        return 0;
+    }
+
+    std::vector<std::vector<int64_t> const*> l_tensors{&node->m_output_dimension_ids,
+                                                       &node->m_left_child->m_output_dimension_ids};
+    if (node->m_right_child != nullptr)
+    {
+        l_tensors.push_back(&node->m_right_child->m_output_dimension_ids);
+    }
+    else if (*l_tensors[0] == *l_tensors[1])
+    {
+        // the permutation is removed
+        return 0;
+    }
+
+    // two dimensions are fused if the inner one directly follows the outer one in all tensors containing them
+    std::vector<int64_t>                     l_dim_ids;
+    std::vector<std::pair<int64_t, int64_t>> l_pairs;
+    for (std::vector<int64_t> const* l_tensor : l_tensors)
+    {
+        for (size_t i = 0; i < l_tensor->size(); i++)
+        {
+            if (!contains(l_dim_ids, (*l_tensor)[i]))
+            {
+                l_dim_ids.push_back((*l_tensor)[i]);
+            }
+            if (i + 1 < l_tensor->size() && !contains(l_pairs, std::make_pair((*l_tensor)[i], (*l_tensor)[i + 1])))
+            {
+                l_pairs.push_back({(*l_tensor)[i], (*l_tensor)[i + 1]});
+            }
+        }
+    }
+
+    int64_t l_num_loops = static_cast<int64_t>(l_dim_ids.size());
+    for (auto const& [l_outer, l_inner] : l_pairs)
+    {
+        bool l_fused = true;
+        for (std::vector<int64_t> const* l_tensor : l_tensors)
+        {
+            auto l_outer_it = std::find(l_tensor->begin(), l_tensor->end(), l_outer);
+            auto l_inner_it = std::find(l_tensor->begin(), l_tensor->end(), l_inner);
+            if ((l_outer_it == l_tensor->end()) != (l_inner_it == l_tensor->end()) ||
+                (l_outer_it != l_tensor->end() && l_outer_it + 1 != l_inner_it))
+            {
+                l_fused = false;
+                break;
+            }
+        }
+        l_num_loops -= l_fused ? 1 : 0;
+    }
+
+    return l_num_loops;
+}
+
+mini_jit::einsum::EinsumNode* mini_jit::einsum::EinsumTree::fold_permutation_nodes(EinsumNode* root_node)
+{
+    if (root_node == nullptr)
+    {
+        return nullptr;
+    }
+
+    root_node->m_left_child  = fold_permutation_nodes(root_node->m_left_child);
+    root_node->m_right_child = fold_permutation_nodes(root_node->m_right_child);
+
+    // only permutations of contractions are folded, inputs have a fixed layout
+    if (root_node->get_number_of_children() != 1 ||
+        root_node->m_left_child->get_number_of_children() != 2)
+    {
+        return root_node;
+    }
+
+    EinsumNode* l_contraction = root_node->m_left_child;
+    if (!can_reorder_output(l_contraction, root_node->m_output_dimension_ids.back()))
+    {
+        return root_node;
+    }
+
+    // the contraction writes the permuted layout directly
+    l_contraction->m_output_dimension_ids = root_node->m_output_dimension_ids;
+    l_contraction->m_tensor_expression    = root_node->m_tensor_expression;
+
+    root_node->m_left_child = nullptr;
+    delete root_node;
+
+    return l_contraction;
+}
+
+bool mini_jit::einsum::EinsumTree::can_reorder_output(EinsumNode const* node,
+                                                      int64_t           unit_stride_dim_id)
+{
+    // permutations can write any layout
+    if (node->get_number_of_children() == 1)
+    {
+        return true;
+    }
+    else if (node->get_number_of_children() == 2)
+    {
+        // contractions need the unit stride dimension as M dimension,
+        // i.e. it has to be part of exactly one of the inputs
+        bool l_in_left  = contains(node->m_left_child->m_output_dimension_ids, unit_stride_dim_id);
+        bool l_in_right = contains(node->m_right_child->m_output_dimension_ids, unit_stride_dim_id);
+        if (l_in_left == l_in_right)
+        {
+            return false;
+        }
+
+        // the new layout must not require additional permutations of the inputs:
+        // M has to be the unit stride dimension of the first input ...
+        EinsumNode const* l_input_m = l_in_left ? node->m_left_child : node->m_right_child;
+        EinsumNode const* l_input_k = l_in_left ? node->m_right_child : node->m_left_child;
+        if (l_input_m->m_output_dimension_ids.back() != unit_stride_dim_id &&
+            !can_reorder_output(l_input_m, unit_stride_dim_id))
+        {
+            return false;
+        }
+
+        // ... and the right-most K dimension of the first input the unit stride dimension of the second input
+        std::vector<int64_t> l_ids_m = l_input_m->m_output_dimension_ids;
+        auto                 l_m_it  = std::find(l_ids_m.begin(), l_ids_m.end(), unit_stride_dim_id);
+        std::rotate(l_m_it, l_m_it + 1, l_ids_m.end());
+        for (auto l_it = l_ids_m.rbegin(); l_it != l_ids_m.rend(); ++l_it)
+        {
+            if (contains(l_input_k->m_output_dimension_ids, *l_it))
+            {
+                return l_input_k->m_output_dimension_ids.back() == *l_it ||
+                       can_reorder_output(l_input_k, *l_it);
+            }
+        }
+        return false;
+    }
+
+    // input tensors have a fixed layout
+    return false;
+}
+
+void mini_jit::einsum::EinsumTree::remove_redundant_permutation(EinsumNode*& node)
+{
+    if (node->get_number_of_children() != 1 ||
+        node->m_output_dimension_ids != node->m_left_child->m_output_dimension_ids)
+    {
+        return;
+    }
+
+    // the permutation does not change the layout and would only copy its input
+    EinsumNode* l_child = node->m_left_child;
+    node->m_left_child  = nullptr;
+    delete node;
+    node = l_child;
+}
+
+std::string mini_jit::einsum::EinsumTree::to_expression(std::vector<int64_t> const& dimension_ids)
+{
+    std::string l_expression = "";
+    for (size_t i = 0; i < dimension_ids.size(); i++)
+    {
+        if (i > 0)
+        {
+            l_expression += ",";
+        }
+        l_expression += std::to_string(dimension_ids[i]);
+    }
+    return l_expression;
+}
+
 void mini_jit::einsum::EinsumTree::swap_nodes(EinsumNode* root_node)
 {
     if (root_node == nullptr || root_node->get_number_of_children() == 0)
@@ -650,3 +938,28 @@ std::string mini_jit::einsum::EinsumTree::to_string(EinsumNode* root_node)
         return "[" + to_string(root_node->m_left_child) + "],[" + to_string(root_node->m_right_child) + "]->[" + root_node->m_tensor_expression + "]";
     }
 }
+
+std::string mini_jit::einsum::EinsumTree::to_json(EinsumNode* root_node)
+{
+    if (root_node == nullptr)
+    {
+        return "null";
+    }
+
+    mini_jit::ir::OptimizationReport const& l_report = root_node->m_operation.get_report();
+
+    std::string l_json = "{\"expression\": \"" + root_node->m_tensor_expression + "\"";
+    l_json += ", \"report\": " + (l_report.is_empty() ? std::string("null") : l_report.to_json());
+    l_json += ", \"children\": [";
+    if (root_node->m_left_child != nullptr)
+    {
+        l_json += to_json(root_node->m_left_child);
+    }
+    if (root_node->m_right_child != nullptr)
+    {
+        l_json += ", " + to_json(root_node->m_right_child);
+    }
+    l_json += "]}";
+
+    return l_json;
+}
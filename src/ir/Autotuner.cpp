@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mlc/TensorOperation.h>
+#include <mlc/ir/Autotuner.h>
+#include <mlc/ir/IRConverter.h>
+#include <mlc/ir/Optimizer.h>
+#include <numeric>
+#include <omp.h>
+#include <stdexcept>
+
+std::vector<mini_jit::ir::Autotuner::config_t> mini_jit::ir::Autotuner::generateCandidates(std::vector<Dimension> const& dimensions,
+                                                                                           parameters_t const&           parameters)
+{
+    std::vector<int64_t> l_thread_targets = parameters.thread_targets;
+    if (l_thread_targets.empty())
+    {
+        int64_t l_num_threads = omp_get_max_threads();
+        l_thread_targets      = {1, l_num_threads, 4 * l_num_threads};
+    }
+
+    auto l_is_same = [](std::vector<Dimension> const& dims_0, std::vector<Dimension> const& dims_1)
+    {
+        return std::equal(dims_0.begin(), dims_0.end(), dims_1.begin(), dims_1.end(), [](Dimension const& dim_0, Dimension const& dim_1)
+                          { return dim_0.type == dim_1.type &&
+                                   dim_0.exec_type == dim_1.exec_type &&
+                                   dim_0.size == dim_1.size &&
+                                   dim_0.stride_in0 == dim_1.stride_in0 &&
+                                   dim_0.stride_in1 == dim_1.stride_in1 &&
+                                   dim_0.stride_out == dim_1.stride_out &&
+                                   dim_0.remainder == dim_1.remainder; });
+    };
+
+    std::vector<config_t> l_candidates;
+    auto                  l_add_candidate = [&](config_t const& config)
+    {
+        bool l_exists = std::any_of(l_candidates.begin(), l_candidates.end(), [&](config_t const& candidate)
+                                    { return l_is_same(candidate.dimensions, config.dimensions); });
+        if (!l_exists)
+        {
+            l_candidates.push_back(config);
+        }
+    };
+
+    for (int64_t l_thread_target : l_thread_targets)
+    {
+        for (int64_t l_max_kernel_size : parameters.max_kernel_sizes)
+        {
+            for (int64_t l_min_kernel_size : parameters.min_kernel_sizes)
+            {
+                if (l_min_kernel_size > l_max_kernel_size)
+                {
+                    continue;
+                }
+
+                config_t l_config;
+                l_config.thread_target   = l_thread_target;
+                l_config.max_kernel_size = l_max_kernel_size;
+                l_config.min_kernel_size = l_min_kernel_size;
+                l_config.dimensions      = dimensions;
+                try
+                {
+                    Optimizer::optimize(l_config.dimensions,
+                                        l_thread_target,
+                                        l_max_kernel_size,
+                                        l_min_kernel_size);
+                }
+                catch (std::invalid_argument const&)
+                {
+                    continue;
+                }
+                l_add_candidate(l_config);
+
+                /////////////////////////////////////////////////////////////////
+                // LOOP ORDERS
+                /////////////////////////////////////////////////////////////////
+                // shared loops stay in front and primitives in the back, only the sequential loops are permuted
+                std::vector<size_t> l_seq_ids;
+                for (size_t i = 0; i < l_config.dimensions.size(); i++)
+                {
+                    if (l_config.dimensions[i].exec_type == exec_t::seq)
+                    {
+                        l_seq_ids.push_back(i);
+                    }
+                }
+
+                std::vector<size_t> l_order(l_seq_ids.size());
+                std::iota(l_order.begin(), l_order.end(), 0);
+                for (int64_t l_num_orders = 1;
+                     l_num_orders < parameters.max_loop_orders && std::next_permutation(l_order.begin(), l_order.end());
+                     l_num_orders++)
+                {
+                    config_t l_permuted = l_config;
+                    for (size_t i = 0; i < l_seq_ids.size(); i++)
+                    {
+                        l_permuted.dimensions[l_seq_ids[i]] = l_config.dimensions[l_seq_ids[l_order[i]]];
+                    }
+                    l_add_candidate(l_permuted);
+                }
+            }
+        }
+    }
+
+    return l_candidates;
+}
+
+double mini_jit::ir::Autotuner::measure(dtype_t                       dtype,
+                                        ptype_t                       prim_first_touch,
+                                        ptype_t                       prim_main,
+                                        ptype_t                       prim_last_touch,
+                                        std::vector<Dimension> const& dimensions,
+                                        double                        min_time)
+{
+    std::vector<dim_t>   l_dim_types;
+    std::vector<exec_t>  l_exec_types;
+    std::vector<int64_t> l_dim_sizes;
+    std::vector<int64_t> l_strides_in0;
+    std::vector<int64_t> l_strides_in1;
+    std::vector<int64_t> l_strides_out;
+    std::vector<int64_t> l_dim_remainders;
+    IRConverter::convertDimensionsToConfig(dimensions,
+                                           l_dim_types,
+                                           l_exec_types,
+                                           l_dim_sizes,
+                                           l_strides_in0,
+                                           l_strides_in1,
+                                           l_strides_out,
+                                           l_dim_remainders);
+
+    // splitting K may turn a GEMM into a BRGEMM and vice versa
+    if (prim_main == ptype_t::gemm || prim_main == ptype_t::brgemm)
+    {
+        int64_t l_prim_count = std::count(l_exec_types.begin(), l_exec_types.end(), exec_t::prim);
+        prim_main            = l_prim_count == 4 ? ptype_t::brgemm : ptype_t::gemm;
+    }
+
+    TensorOperation l_op;
+    error_t         l_err = l_op.setup(dtype,
+                                       prim_first_touch,
+                                       prim_main,
+                                       prim_last_touch,
+                                       l_dim_types,
+                                       l_exec_types,
+                                       l_dim_sizes,
+                                       l_strides_in0,
+                                       l_strides_in1,
+                                       l_strides_out,
+                                       l_dim_remainders);
+    if (l_err != error_t::success)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    // number of elements spanned by the strides of a tensor
+    auto l_num_elements = [&l_dim_sizes](std::vector<int64_t> const& strides)
+    {
+        int64_t l_max_offset = 0;
+        for (size_t i = 0; i < strides.size(); i++)
+        {
+            l_max_offset += (l_dim_sizes[i] - 1) * std::abs(strides[i]);
+        }
+        return l_max_offset + 1;
+    };
+
+    // dummy data, the values are irrelevant for the runtime
+    std::vector<float> l_in0(l_num_elements(l_strides_in0) * l_op.dtype_size() / sizeof(float), 0.5f);
+    std::vector<float> l_in1(l_num_elements(l_strides_in1) * l_op.dtype_size() / sizeof(float), 0.5f);
+    std::vector<float> l_out(l_num_elements(l_strides_out) * l_op.dtype_size() / sizeof(float), 0.0f);
+    bool               l_is_unary = std::all_of(l_strides_in1.begin(), l_strides_in1.end(), [](int64_t stride)
+                                                { return stride == 0; });
+    void const*        l_ptr_in1  = l_is_unary ? nullptr : l_in1.data();
+
+    // warm up caches and the thread pool
+    l_op.execute(l_in0.data(), l_ptr_in1, l_out.data());
+
+    int64_t l_num_reps = 0;
+    double  l_elapsed  = 0.0;
+    auto    l_start    = std::chrono::high_resolution_clock::now();
+    do
+    {
+        l_op.execute(l_in0.data(), l_ptr_in1, l_out.data());
+        l_num_reps++;
+        l_elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - l_start).count();
+    } while (l_elapsed < min_time);
+
+    return l_elapsed / l_num_reps;
+}
+
+mini_jit::ir::Autotuner::config_t mini_jit::ir::Autotuner::tune(dtype_t                       dtype,
+                                                                ptype_t                       prim_first_touch,
+                                                                ptype_t                       prim_main,
+                                                                ptype_t                       prim_last_touch,
+                                                                std::vector<Dimension> const& dimensions)
+{
+    return tune(dtype,
+                prim_first_touch,
+                prim_main,
+                prim_last_touch,
+                dimensions,
+                parameters_t());
+}
+
+mini_jit::ir::Autotuner::config_t mini_jit::ir::Autotuner::tune(dtype_t                       dtype,
+                                                                ptype_t                       prim_first_touch,
+                                                                ptype_t                       prim_main,
+                                                                ptype_t                       prim_last_touch,
+                                                                std::vector<Dimension> const& dimensions,
+                                                                parameters_t const&           parameters)
+{
+    std::vector<config_t> l_candidates = generateCandidates(dimensions,
+                                                            parameters);
+
+    config_t l_best;
+    l_best.time = std::numeric_limits<double>::infinity();
+    for (config_t& l_candidate : l_candidates)
+    {
+        l_candidate.time = measure(dtype,
+                                   prim_first_touch,
+                                   prim_main,
+                                   prim_last_touch,
+                                   l_candidate.dimensions,
+                                   parameters.min_time);
+        if (l_candidate.time < l_best.time)
+        {
+            l_best = l_candidate;
+        }
+    }
+
+    if (l_best.dimensions.empty())
+    {
+        throw std::invalid_argument("Autotuner: No valid configuration found.");
+    }
+
+    return l_best;
+}
+
+void mini_jit::ir::Autotuner::save(config_t const&    config,
+                                   std::string const& path)
+{
+    std::ofstream l_file(path);
+    if (!l_file.is_open())
+    {
+        throw std::runtime_error("Autotuner: Failed to open file: " + path);
+    }
+
+    l_file << "thread_target " << config.thread_target << std::endl;
+    l_file << "max_kernel_size " << config.max_kernel_size << std::endl;
+    l_file << "min_kernel_size " << config.min_kernel_size << std::endl;
+    l_file << "time " << config.time << std::endl;
+    l_file << "dimensions " << config.dimensions.size() << std::endl;
+    for (Dimension const& l_dim : config.dimensions)
+    {
+        l_file << to_string(l_dim.type) << " "
+               << to_string(l_dim.exec_type) << " "
+               << l_dim.size << " "
+               << l_dim.stride_in0 << " "
+               << l_dim.stride_in1 << " "
+               << l_dim.stride_out << " "
+               << l_dim.remainder << std::endl;
+    }
+}
+
+mini_jit::ir::Autotuner::config_t mini_jit::ir::Autotuner::load(std::string const& path)
+{
+    std::ifstream l_file(path);
+    if (!l_file.is_open())
+    {
+        throw std::runtime_error("Autotuner: Failed to open file: " + path);
+    }
+
+    auto l_expect = [&l_file, &path](std::string const& key)
+    {
+        std::string l_key;
+        if (!(l_file >> l_key) || l_key != key)
+        {
+            throw std::invalid_argument("Autotuner: Expected \"" + key + "\" in " + path);
+        }
+    };
+
+    config_t l_config;
+    int64_t  l_num_dims = 0;
+    l_expect("thread_target");
+    l_file >> l_config.thread_target;
+    l_expect("max_kernel_size");
+    l_file >> l_config.max_kernel_size;
+    l_expect("min_kernel_size");
+    l_file >> l_config.min_kernel_size;
+    l_expect("time");
+    l_file >> l_config.time;
+    l_expect("dimensions");
+    l_file >> l_num_dims;
+
+    std::vector<dim_t>  l_dim_types  = {dim_t::c, dim_t::m, dim_t::n, dim_t::k};
+    std::vector<exec_t> l_exec_types = {exec_t::seq, exec_t::prim, exec_t::shared, exec_t::undefined};
+
+    for (int64_t i = 0; i < l_num_dims; i++)
+    {
+        std::string l_type;
+        std::string l_exec_type;
+        int64_t     l_size       = 0;
+        int64_t     l_stride_in0 = 0;
+        int64_t     l_stride_in1 = 0;
+        int64_t     l_stride_out = 0;
+        int64_t     l_remainder  = 0;
+        if (!(l_file >> l_type >> l_exec_type >> l_size >> l_stride_in0 >> l_stride_in1 >> l_stride_out >> l_remainder))
+        {
+            throw std::invalid_argument("Autotuner: Truncated dimension list in " + path);
+        }
+
+        auto l_dim_type = std::find_if(l_dim_types.begin(), l_dim_types.end(), [&l_type](dim_t type)
+                                       { return to_string(type) == l_type; });
+        auto l_exec     = std::find_if(l_exec_types.begin(), l_exec_types.end(), [&l_exec_type](exec_t type)
+                                       { return to_string(type) == l_exec_type; });
+        if (l_dim_type == l_dim_types.end() || l_exec == l_exec_types.end())
+        {
+            throw std::invalid_argument("Autotuner: Unknown dimension type \"" + l_type + " " + l_exec_type + "\" in " + path);
+        }
+
+        l_config.dimensions.emplace_back(*l_dim_type,
+                                         *l_exec,
+                                         l_size,
+                                         l_stride_in0,
+                                         l_stride_in1,
+                                         l_stride_out,
+                                         l_remainder);
+    }
+
+    return l_config;
+}
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <mlc/ir/CostModel.h>
+#include <sstream>
+#include <stdexcept>
+
+mini_jit::ir::CostModel::CostModel(hardware_t const& hardware)
+    : m_hardware(hardware)
+{
+}
+
+int64_t mini_jit::ir::CostModel::loadThroughputTable(std::string const& path)
+{
+    std::ifstream l_file(path);
+    if (!l_file.is_open())
+    {
+        throw std::runtime_error("CostModel: Failed to open file: " + path);
+    }
+
+    auto l_split = [](std::string const& line)
+    {
+        std::vector<std::string> l_fields;
+        std::stringstream        l_stream(line);
+        std::string              l_field;
+        while (std::getline(l_stream, l_field, ','))
+        {
+            l_fields.push_back(l_field);
+        }
+        return l_fields;
+    };
+
+    std::string l_line;
+    if (!std::getline(l_file, l_line))
+    {
+        throw std::invalid_argument("CostModel: Missing header in " + path);
+    }
+
+    // map the required columns to their positions
+    std::vector<std::string> l_header = l_split(l_line);
+    auto                     l_column = [&l_header](std::string const& name)
+    {
+        auto l_it = std::find(l_header.begin(), l_header.end(), name);
+        return l_it == l_header.end() ? -1 : static_cast<int64_t>(l_it - l_header.begin());
+    };
+    int64_t l_col_m      = l_column("m");
+    int64_t l_col_n      = l_column("n");
+    int64_t l_col_k      = l_column("k");
+    int64_t l_col_br     = l_column("br_size");
+    int64_t l_col_gflops = l_column("gflops");
+    if (l_col_m < 0 || l_col_n < 0 || l_col_k < 0 || l_col_gflops < 0)
+    {
+        throw std::invalid_argument("CostModel: Expected the columns m, n, k and gflops in " + path);
+    }
+
+    int64_t l_num_entries = 0;
+    while (std::getline(l_file, l_line))
+    {
+        std::vector<std::string> l_fields = l_split(l_line);
+        if (static_cast<int64_t>(l_fields.size()) != static_cast<int64_t>(l_header.size()))
+        {
+            continue; // skip empty or truncated lines
+        }
+
+        setThroughput(std::stoll(l_fields[l_col_m]),
+                      std::stoll(l_fields[l_col_n]),
+                      std::stoll(l_fields[l_col_k]),
+                      l_col_br < 0 ? 1 : std::stoll(l_fields[l_col_br]),
+                      std::stod(l_fields[l_col_gflops]));
+        l_num_entries++;
+    }
+
+    return l_num_entries;
+}
+
+void mini_jit::ir::CostModel::setThroughput(int64_t m,
+                                            int64_t n,
+                                            int64_t k,
+                                            int64_t br_size,
+                                            double  gflops)
+{
+    m_throughput_table[{m, n, k, br_size}] = gflops;
+}
+
+double mini_jit::ir::CostModel::lookupThroughput(int64_t m,
+                                                 int64_t n,
+                                                 int64_t k,
+                                                 int64_t br_size) const
+{
+    auto l_it = m_throughput_table.find({m, n, k, br_size});
+    if (l_it != m_throughput_table.end())
+    {
+        return l_it->second;
+    }
+
+    auto l_distance = [](int64_t a, int64_t b)
+    {
+        double l_diff = std::log2(static_cast<double>(a)) - std::log2(static_cast<double>(b));
+        return l_diff * l_diff;
+    };
+
+    double l_best_distance   = std::numeric_limits<double>::max();
+    double l_best_throughput = 0.0;
+    for (auto const& [l_key, l_gflops] : m_throughput_table)
+    {
+        auto [l_m, l_n, l_k, l_br] = l_key;
+        double l_current           = l_distance(l_m, m) + l_distance(l_n, n) + l_distance(l_k, k) + l_distance(l_br, br_size);
+        if (l_current < l_best_distance)
+        {
+            l_best_distance   = l_current;
+            l_best_throughput = l_gflops;
+        }
+    }
+
+    return l_best_throughput;
+}
+
+double mini_jit::ir::CostModel::getKernelThroughput(int64_t m,
+                                                    int64_t n,
+                                                    int64_t k,
+                                                    int64_t br_size) const
+{
+    if (!m_throughput_table.empty())
+    {
+        return lookupThroughput(m, n, k, br_size);
+    }
+
+    // the microkernels work on blocks of 16 rows and 4 columns,
+    // partially filled blocks waste the corresponding FMA lanes
+    double l_efficiency_m = static_cast<double>(m) / ((m + 15) / 16 * 16);
+    double l_efficiency_n = static_cast<double>(n) / ((n + 3) / 4 * 4);
+    // loading and storing the accumulators is amortized over the reduction
+    double l_reduction    = static_cast<double>(k * br_size);
+    double l_efficiency_k = l_reduction / (l_reduction + 2.0);
+
+    return m_hardware.peak_gflops * l_efficiency_m * l_efficiency_n * l_efficiency_k;
+}
+
+double mini_jit::ir::CostModel::estimateTraffic(std::vector<Dimension> const& dimensions) const
+{
+    auto l_stride = [](Dimension const& dim, int64_t tensor)
+    {
+        return tensor == 0 ? dim.stride_in0 : (tensor == 1 ? dim.stride_in1 : dim.stride_out);
+    };
+
+    // footprint of the tensors in a single kernel call
+    double l_footprints[3] = {1.0, 1.0, 1.0};
+    bool   l_is_used[3]    = {false, false, false};
+    for (auto const& l_dim : dimensions)
+    {
+        for (int64_t l_tensor = 0; l_tensor < 3; l_tensor++)
+        {
+            if (l_stride(l_dim, l_tensor) != 0)
+            {
+                l_is_used[l_tensor] = true;
+                if (l_dim.exec_type == exec_t::prim)
+                {
+                    l_footprints[l_tensor] *= l_dim.size;
+                }
+            }
+        }
+    }
+
+    double l_traffic[3] = {0.0, 0.0, 0.0};
+    for (int64_t l_tensor = 0; l_tensor < 3; l_tensor++)
+    {
+        l_footprints[l_tensor] *= m_hardware.element_size;
+        l_traffic[l_tensor] = l_footprints[l_tensor];
+    }
+
+    for (auto l_it = dimensions.rbegin(); l_it != dimensions.rend(); ++l_it)
+    {
+        if (l_it->exec_type == exec_t::prim)
+        {
+            continue;
+        }
+
+        // data touched by one iteration of the loop
+        double l_working_set = 0.0;
+        for (int64_t l_tensor = 0; l_tensor < 3; l_tensor++)
+        {
+            l_working_set += l_is_used[l_tensor] ? l_footprints[l_tensor] : 0.0;
+        }
+
+        for (int64_t l_tensor = 0; l_tensor < 3; l_tensor++)
+        {
+            if (l_stride(*l_it, l_tensor) != 0)
+            {
+                // new data in every iteration
+                l_traffic[l_tensor] *= l_it->size;
+                l_footprints[l_tensor] *= l_it->size;
+            }
+            else if (l_working_set > m_hardware.l2_size)
+            {
+                // the same data, but evicted in between
+                l_traffic[l_tensor] *= l_it->size;
+            }
+        }
+    }
+
+    double l_total = 0.0;
+    for (int64_t l_tensor = 0; l_tensor < 3; l_tensor++)
+    {
+        l_total += l_is_used[l_tensor] ? l_traffic[l_tensor] : 0.0;
+    }
+    return l_total;
+}
+
+double mini_jit::ir::CostModel::estimate(std::vector<Dimension> const& dimensions,
+                                         int64_t                       thread_target) const
+{
+    std::vector<Dimension const*> l_prims;
+    int64_t                       l_num_calls  = 1;
+    int64_t                       l_num_shared = 1;
+    bool                          l_has_k_dim  = false;
+    for (auto const& l_dim : dimensions)
+    {
+        if (l_dim.exec_type == exec_t::prim)
+        {
+            l_prims.push_back(&l_dim);
+        }
+        else
+        {
+            l_num_calls *= l_dim.size;
+        }
+        if (l_dim.exec_type == exec_t::shared)
+        {
+            l_num_shared *= l_dim.size;
+        }
+        l_has_k_dim |= l_dim.type == dim_t::k;
+    }
+
+    if (l_prims.empty())
+    {
+        throw std::invalid_argument("CostModel: No primitive dimensions found.");
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // KERNEL
+    /////////////////////////////////////////////////////////////////
+    int64_t l_m       = 1;
+    int64_t l_n       = 1;
+    int64_t l_k       = 1;
+    int64_t l_br_size = 1;
+    for (Dimension const* l_prim : l_prims)
+    {
+        if (l_prim->type == dim_t::n)
+        {
+            l_n = l_prim->size;
+        }
+        else if (l_prim->type == dim_t::k)
+        {
+            // the batch-reduce dimension precedes the K dimension
+            l_br_size = l_k;
+            l_k       = l_prim->size;
+        }
+        else if (l_prim->type == dim_t::m || l_prim == l_prims.front())
+        {
+            l_m = l_prim->size;
+        }
+        else
+        {
+            // second primitive c dimension of unary operations
+            l_n = l_prim->size;
+        }
+    }
+
+    double  l_kernel_ops        = 0.0;
+    double  l_kernel_throughput = 0.0;
+    int64_t l_working_set       = 0;
+    if (l_has_k_dim)
+    {
+        l_kernel_ops        = 2.0 * l_m * l_n * l_k * l_br_size;
+        l_kernel_throughput = getKernelThroughput(l_m, l_n, l_k, l_br_size);
+        l_working_set       = (l_m * l_k * l_br_size + l_k * l_n * l_br_size + l_m * l_n) * m_hardware.element_size;
+    }
+    else
+    {
+        // element-wise kernels process four elements per instruction
+        bool l_is_binary    = std::any_of(dimensions.begin(), dimensions.end(), [](Dimension const& dim)
+                                          { return dim.stride_in1 != 0; });
+        l_kernel_ops        = static_cast<double>(l_m * l_n);
+        l_kernel_throughput = m_hardware.peak_gflops / 2.0 * l_m / ((l_m + 3) / 4 * 4);
+        l_working_set       = (l_is_binary ? 3 : 2) * l_m * l_n * m_hardware.element_size;
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // PARALLELIZATION
+    /////////////////////////////////////////////////////////////////
+    int64_t l_num_threads        = std::max<int64_t>(1, thread_target);
+    int64_t l_num_active_threads = std::min(l_num_shared, l_num_threads);
+    // the slowest thread determines the runtime
+    int64_t l_calls_per_thread = (l_num_shared + l_num_threads - 1) / l_num_threads * (l_num_calls / l_num_shared);
+
+    /////////////////////////////////////////////////////////////////
+    // ROOFLINE
+    /////////////////////////////////////////////////////////////////
+    double l_compute_time = l_calls_per_thread * l_kernel_ops / (l_kernel_throughput * 1e9);
+
+    double l_bandwidth = m_hardware.memory_bandwidth / l_num_active_threads;
+    if (l_working_set <= m_hardware.l1_size)
+    {
+        l_bandwidth = m_hardware.l1_bandwidth;
+    }
+    else if (l_working_set * l_num_active_threads <= m_hardware.l2_size)
+    {
+        l_bandwidth = m_hardware.l2_bandwidth;
+    }
+    double l_cache_time = l_calls_per_thread * static_cast<double>(l_working_set) / l_bandwidth;
+
+    double l_memory_time = estimateTraffic(dimensions) / m_hardware.memory_bandwidth;
+
+    double l_overhead = l_calls_per_thread * m_hardware.call_overhead;
+
+    return std::max({l_compute_time, l_cache_time, l_memory_time}) + l_overhead;
+}
@@ -26,6 +26,38 @@ void mini_jit::ir::IRConverter::convertConfigToDimensions(
     }
 }
 
+void mini_jit::ir::IRConverter::convertConfigToDimensions(
+    std::span<const dim_t>   i_dim_types,
+    std::span<const exec_t>  i_exec_types,
+    std::span<const int64_t> i_dim_sizes,
+    std::span<const int64_t> i_strides_in0,
+    std::span<const int64_t> i_strides_in1,
+    std::span<const int64_t> i_strides_out,
+    std::span<const int64_t> i_dim_remainders,
+    std::vector<Dimension>&  o_dimensions)
+{
+    if (!i_dim_remainders.empty() && i_dim_remainders.size() != i_dim_types.size())
+    {
+        throw std::invalid_argument("All input spans must have the same size.");
+    }
+
+    convertConfigToDimensions(i_dim_types,
+                              i_exec_types,
+                              i_dim_sizes,
+                              i_strides_in0,
+                              i_strides_in1,
+                              i_strides_out,
+                              o_dimensions);
+    for (size_t i = 0; i < i_dim_remainders.size(); ++i)
+    {
+        if (i_dim_remainders[i] < 0)
+        {
+            throw std::invalid_argument("Dimension remainder needs to be greater than or equal to 0");
+        }
+        o_dimensions[i].remainder = i_dim_remainders[i];
+    }
+}
+
 void mini_jit::ir::IRConverter::convertDimensionsToConfig(
     const std::vector<Dimension>& i_dimensions,
     std::vector<dim_t>&           o_dim_types,
@@ -52,6 +84,10 @@ void mini_jit::ir::IRConverter::convertDimensionsToConfig(
 
     for (const auto& dim : i_dimensions)
     {
+        if (dim.remainder != 0)
+        {
+            throw std::invalid_argument("Dimensions with a remainder require the conversion including the remainders.");
+        }
         o_dim_types.push_back(dim.type);
         o_exec_types.push_back(dim.exec_type);
         o_dim_sizes.push_back(dim.size);
@@ -59,4 +95,31 @@ void mini_jit::ir::IRConverter::convertDimensionsToConfig(
         o_strides_in1.push_back(dim.stride_in1);
         o_strides_out.push_back(dim.stride_out);
     }
-}
\ No newline at end of file
+}
+void mini_jit::ir::IRConverter::convertDimensionsToConfig(
+    const std::vector<Dimension>& i_dimensions,
+    std::vector<dim_t>&           o_dim_types,
+    std::vector<exec_t>&          o_exec_types,
+    std::vector<int64_t>&         o_dim_sizes,
+    std::vector<int64_t>&         o_strides_in0,
+    std::vector<int64_t>&         o_strides_in1,
+    std::vector<int64_t>&         o_strides_out,
+    std::vector<int64_t>&         o_dim_remainders)
+{
+    std::vector<Dimension> l_dimensions = i_dimensions;
+    o_dim_remainders.clear();
+    o_dim_remainders.reserve(l_dimensions.size());
+    for (auto& dim : l_dimensions)
+    {
+        o_dim_remainders.push_back(dim.remainder);
+        dim.remainder = 0;
+    }
+
+    convertDimensionsToConfig(l_dimensions,
+                              o_dim_types,
+                              o_exec_types,
+                              o_dim_sizes,
+                              o_strides_in0,
+                              o_strides_in1,
+                              o_strides_out);
+}
@@ -0,0 +1,151 @@
+#include <mlc/ir/OptimizationReport.h>
+#include <mlc/json.h>
+#include <sstream>
+
+namespace
+{
+    /**
+     * Serialize dimensions to a JSON array.
+     */
+    void write_dimensions(std::ostringstream&                         stream,
+                          std::vector<mini_jit::ir::Dimension> const& dimensions)
+    {
+        stream << "[";
+        for (size_t i = 0; i < dimensions.size(); i++)
+        {
+            mini_jit::ir::Dimension const& l_dim = dimensions[i];
+            stream << (i > 0 ? ", " : "")
+                   << "{\"type\": \"" << to_string(l_dim.type) << "\""
+                   << ", \"exec_type\": \"" << to_string(l_dim.exec_type) << "\""
+                   << ", \"size\": " << l_dim.size
+                   << ", \"stride_in0\": " << l_dim.stride_in0
+                   << ", \"stride_in1\": " << l_dim.stride_in1
+                   << ", \"stride_out\": " << l_dim.stride_out
+                   << ", \"remainder\": " << l_dim.remainder << "}";
+        }
+        stream << "]";
+    }
+} // namespace
+
+void mini_jit::ir::OptimizationReport::clear()
+{
+    *this = OptimizationReport();
+}
+
+void mini_jit::ir::OptimizationReport::set_input(std::vector<Dimension> const& dimensions)
+{
+    m_input = dimensions;
+}
+
+void mini_jit::ir::OptimizationReport::add_decision(std::string const& stage,
+                                                    std::string const& description)
+{
+    m_decisions.push_back({stage, description});
+}
+
+void mini_jit::ir::OptimizationReport::set_result(std::vector<Dimension> const& dimensions,
+                                                  int64_t                       thread_target,
+                                                  CostModel const&              cost_model,
+                                                  double                        estimated_time)
+{
+    m_output         = dimensions;
+    m_thread_target  = thread_target;
+    m_estimated_time = estimated_time;
+
+    // the primitive dimensions are identified from the back, like in the TensorOperation
+    for (int64_t& l_size : m_prim_sizes)
+    {
+        l_size = 1;
+    }
+    bool l_has_k = false;
+    for (auto l_it = dimensions.rbegin(); l_it != dimensions.rend(); ++l_it)
+    {
+        if (l_it->exec_type != exec_t::prim)
+        {
+            continue;
+        }
+        if (l_it->type == dim_t::m || (l_it->type == dim_t::c && l_it->stride_in0 == 1))
+        {
+            m_prim_sizes[0] = l_it->size;
+        }
+        else if (l_it->type == dim_t::n || l_it->type == dim_t::c)
+        {
+            m_prim_sizes[1] = l_it->size;
+        }
+        else if (!l_has_k)
+        {
+            m_prim_sizes[2] = l_it->size;
+            l_has_k         = true;
+        }
+        else
+        {
+            m_prim_sizes[3] = l_it->size;
+        }
+    }
+
+    // the last iteration of a peeled loop only covers the remainder of a block
+    double l_num_iters   = 1.0;
+    bool   l_contraction = false;
+    m_num_tasks          = 1;
+    for (Dimension const& l_dim : dimensions)
+    {
+        l_num_iters *= l_dim.size;
+        l_contraction |= l_dim.type == dim_t::k;
+        if (l_dim.exec_type == exec_t::shared)
+        {
+            m_num_tasks *= l_dim.size;
+        }
+        if (l_dim.remainder != 0)
+        {
+            double l_block = l_dim.type == dim_t::m ? m_prim_sizes[0] : m_prim_sizes[1];
+            l_num_iters *= ((l_dim.size - 1) * l_block + l_dim.remainder) / (l_dim.size * l_block);
+        }
+    }
+    m_flops = l_contraction ? 2.0 * l_num_iters : l_num_iters;
+    m_bytes = cost_model.estimateTraffic(dimensions);
+}
+
+double mini_jit::ir::OptimizationReport::get_parallel_efficiency() const
+{
+    if (m_thread_target <= 0)
+    {
+        return 1.0;
+    }
+    int64_t l_num_rounds = (m_num_tasks + m_thread_target - 1) / m_thread_target;
+    return static_cast<double>(m_num_tasks) / static_cast<double>(l_num_rounds * m_thread_target);
+}
+
+std::string mini_jit::ir::OptimizationReport::to_json() const
+{
+    std::ostringstream l_json;
+    l_json.precision(9);
+
+    l_json << "{\"thread_target\": " << m_thread_target;
+    l_json << ", \"input\": ";
+    write_dimensions(l_json, m_input);
+    l_json << ", \"output\": ";
+    write_dimensions(l_json, m_output);
+
+    l_json << ", \"decisions\": [";
+    for (size_t i = 0; i < m_decisions.size(); i++)
+    {
+        l_json << (i > 0 ? ", " : "")
+               << "{\"stage\": \"" << escape_json(m_decisions[i].stage) << "\""
+               << ", \"description\": \"" << escape_json(m_decisions[i].description) << "\"}";
+    }
+    l_json << "]";
+
+    l_json << ", \"primitive\": {\"m\": " << m_prim_sizes[0]
+           << ", \"n\": " << m_prim_sizes[1]
+           << ", \"k\": " << m_prim_sizes[2]
+           << ", \"br\": " << m_prim_sizes[3] << "}";
+    l_json << ", \"flops\": " << m_flops;
+    l_json << ", \"bytes\": " << m_bytes;
+    l_json << ", \"arithmetic_intensity\": " << get_arithmetic_intensity();
+    l_json << ", \"num_tasks\": " << m_num_tasks;
+    l_json << ", \"parallel_efficiency\": " << get_parallel_efficiency();
+    l_json << ", \"estimated_time\": " << m_estimated_time;
+    l_json << "}";
+
+    return l_json.str();
+}
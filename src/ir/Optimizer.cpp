@@ -1,22 +1,241 @@
 #include <algorithm>
+#include <exception>
 #include <limits.h>
+#include <limits>
 #include <mlc/ir/IRConverter.h>
 #include <mlc/ir/Optimizer.h>
+#include <omp.h>
 
-void mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::ir::Dimension>& dimensions,
-                                       int64_t                               thread_target,
-                                       int64_t                               max_kernel_size,
-                                       int64_t                               min_kernel_size)
+double mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::ir::Dimension>& dimensions,
+                                         int64_t                               thread_target,
+                                         int64_t                               max_kernel_size,
+                                         int64_t                               min_kernel_size)
 {
+    return optimize(dimensions,
+                    thread_target,
+                    max_kernel_size,
+                    min_kernel_size,
+                    CostModel());
+}
+
+double mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::ir::Dimension>& dimensions,
+                                         int64_t                               thread_target,
+                                         int64_t                               max_kernel_size,
+                                         int64_t                               min_kernel_size,
+                                         CostModel const&                      cost_model,
+                                         OptimizationReport*                   report)
+{
+    return optimizeDimensions(dimensions,
+                              thread_target,
+                              max_kernel_size,
+                              min_kernel_size,
+                              cost_model,
+                              true,
+                              report);
+}
+
+double mini_jit::ir::Optimizer::optimizeDimensions(std::vector<mini_jit::ir::Dimension>& dimensions,
+                                                   int64_t                               thread_target,
+                                                   int64_t                               max_kernel_size,
+                                                   int64_t                               min_kernel_size,
+                                                   CostModel const&                      cost_model,
+                                                   bool                                  peel,
+                                                   OptimizationReport*                   report)
+{
+    if (thread_target <= 0)
+    {
+        thread_target = omp_get_max_threads();
+    }
+
+    std::vector<mini_jit::ir::Dimension> l_input = dimensions;
+
     fuseDimensions(dimensions,
                    min_kernel_size);
+    size_t l_num_dims_fused = dimensions.size();
 
-    splitDimensions(dimensions,
+    // the heuristic split comes first, so that it is kept if the cost model rates it equally
+    std::vector<std::vector<mini_jit::ir::Dimension>> l_configurations{dimensions};
+    splitDimensions(l_configurations[0],
                     max_kernel_size,
                     min_kernel_size);
+    enumerateSplits(dimensions,
+                    0,
+                    max_kernel_size,
+                    min_kernel_size,
+                    l_configurations);
+
+    // two configurations have the same loop order if their dimensions match one by one
+    auto l_same_order = [](std::vector<mini_jit::ir::Dimension> const& i_a,
+                           std::vector<mini_jit::ir::Dimension> const& i_b)
+    {
+        return std::equal(i_a.begin(), i_a.end(), i_b.begin(), i_b.end(), [](auto const& i_dim_a, auto const& i_dim_b)
+                          { return i_dim_a.type == i_dim_b.type &&
+                                   i_dim_a.exec_type == i_dim_b.exec_type &&
+                                   i_dim_a.size == i_dim_b.size &&
+                                   i_dim_a.stride_in0 == i_dim_b.stride_in0; });
+    };
+
+    double             l_best_score     = std::numeric_limits<double>::max();
+    double             l_best_untiled   = 0.0;
+    int64_t            l_best_id        = -1;
+    bool               l_best_reordered = false;
+    bool               l_best_tiled     = false;
+    std::exception_ptr l_error          = nullptr;
+    for (size_t i = 0; i < l_configurations.size(); i++)
+    {
+        try
+        {
+            assignExecutionTypes(l_configurations[i],
+                                 thread_target,
+                                 peel ? max_kernel_size : 0);
+        }
+        catch (std::invalid_argument const&)
+        {
+            if (i == 0)
+            {
+                l_error = std::current_exception();
+            }
+            continue;
+        }
+
+        // cache blocking only pays off if the tensors do not fit into the cache
+        std::vector<mini_jit::ir::Dimension> l_tiled = l_configurations[i];
+        tileDimensions(l_tiled,
+                       cost_model);
+
+        std::vector<mini_jit::ir::Dimension> l_unordered = l_configurations[i];
+        reorderDimensions(l_configurations[i],
+                          cost_model);
+        bool l_reordered = !l_same_order(l_unordered, l_configurations[i]);
+
+        double l_score = cost_model.estimate(l_configurations[i],
+                                             thread_target);
+        double l_score_tiled = cost_model.estimate(l_tiled,
+                                                   thread_target);
+        double l_score_untiled = l_score;
+        bool   l_tiled_chosen  = false;
+        if (l_score_tiled < l_score)
+        {
+            l_configurations[i] = std::move(l_tiled);
+            l_score             = l_score_tiled;
+            l_tiled_chosen      = true;
+        }
+        if (l_score < l_best_score)
+        {
+            l_best_score     = l_score;
+            l_best_untiled   = l_score_untiled;
+            l_best_id        = static_cast<int64_t>(i);
+            l_best_reordered = l_reordered && !l_tiled_chosen;
+            l_best_tiled     = l_tiled_chosen;
+        }
+    }
+
+    if (l_best_id == -1)
+    {
+        // none of the configurations is valid, report the error of the heuristic split
+        std::rethrow_exception(l_error);
+    }
+
+    dimensions = std::move(l_configurations[l_best_id]);
 
+    if (report != nullptr)
+    {
+        report->clear();
+        report->set_input(l_input);
+
+        if (l_num_dims_fused < l_input.size())
+        {
+            report->add_decision("fuse", "fused " + std::to_string(l_input.size()) + " dimensions into " + std::to_string(l_num_dims_fused));
+        }
+
+        std::string l_split = "evaluated " + std::to_string(l_configurations.size()) + " split configurations, chose ";
+        l_split += l_best_id == 0 ? std::string("the heuristic split") : "enumerated split " + std::to_string(l_best_id);
+        report->add_decision("split", l_split);
+        reportDecomposition(l_input,
+                            dimensions,
+                            *report);
+
+        for (mini_jit::ir::Dimension const& l_dim : dimensions)
+        {
+            if (l_dim.remainder != 0)
+            {
+                report->add_decision("peel", to_string(l_dim.type) + " loop of " + std::to_string(l_dim.size) + " iterations ends with a remainder of " + std::to_string(l_dim.remainder));
+            }
+        }
+
+        int64_t l_num_tasks = 1;
+        for (mini_jit::ir::Dimension const& l_dim : dimensions)
+        {
+            if (l_dim.exec_type == exec_t::shared)
+            {
+                l_num_tasks *= l_dim.size;
+            }
+        }
+        report->add_decision("shared", std::to_string(l_num_tasks) + " tasks on " + std::to_string(thread_target) + " threads, parallel efficiency " + std::to_string(getParallelEfficiency(l_num_tasks, thread_target)));
+
+        if (l_best_reordered)
+        {
+            report->add_decision("reorder", "reordered the sequential loops to reduce the memory traffic");
+        }
+        if (l_best_tiled)
+        {
+            report->add_decision("tile", "cache tiling reduces the estimated runtime from " + std::to_string(l_best_untiled) + " s to " + std::to_string(l_best_score) + " s");
+        }
+
+        report->set_result(dimensions,
+                           thread_target,
+                           cost_model,
+                           l_best_score);
+    }
+
+    return l_best_score;
+}
+
+void mini_jit::ir::Optimizer::reportDecomposition(std::vector<mini_jit::ir::Dimension> const& i_input,
+                                                  std::vector<mini_jit::ir::Dimension> const& i_output,
+                                                  OptimizationReport&                         o_report)
+{
+    for (dim_t l_type : {dim_t::c, dim_t::m, dim_t::n, dim_t::k})
+    {
+        int64_t l_size = 1;
+        bool    l_used = false;
+        for (mini_jit::ir::Dimension const& l_dim : i_input)
+        {
+            if (l_dim.type == l_type)
+            {
+                l_size *= l_dim.size;
+                l_used = true;
+            }
+        }
+        if (!l_used)
+        {
+            continue;
+        }
+
+        std::string l_loops;
+        for (mini_jit::ir::Dimension const& l_dim : i_output)
+        {
+            if (l_dim.type == l_type)
+            {
+                l_loops += (l_loops.empty() ? "" : " x ") + to_string(l_dim.exec_type) + " " + std::to_string(l_dim.size);
+            }
+        }
+        o_report.add_decision("split", to_string(l_type) + " " + std::to_string(l_size) + ": " + l_loops);
+    }
+}
+
+void mini_jit::ir::Optimizer::assignExecutionTypes(std::vector<mini_jit::ir::Dimension>& dimensions,
+                                                   int64_t                               thread_target,
+                                                   int64_t                               max_kernel_size)
+{
     identifyPrimitives(dimensions);
 
+    if (max_kernel_size > 0)
+    {
+        peelDimensions(dimensions,
+                       max_kernel_size);
+    }
+
     // Verify that there are 2, 3 or 4 primitive dimensions
     int prim_count = std::count_if(dimensions.begin(), dimensions.end(), [](const mini_jit::ir::Dimension& dim)
                                    { return dim.exec_type == exec_t::prim; });
@@ -27,19 +246,18 @@ void mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::ir::Dimension>& dim
 
     createSharedLoops(dimensions,
                       thread_target);
-
-    // TODO: Dimension Reordering?
 }
 
-void mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::dim_t>&  dim_types,
-                                       std::vector<mini_jit::exec_t>& exec_types,
-                                       std::vector<int64_t>&          dim_sizes,
-                                       std::vector<int64_t>&          strides_in0,
-                                       std::vector<int64_t>&          strides_in1,
-                                       std::vector<int64_t>&          strides_out,
-                                       int64_t                        thread_target,
-                                       int64_t                        max_kernel_size,
-                                       int64_t                        min_kernel_size)
+double mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::dim_t>&  dim_types,
+                                         std::vector<mini_jit::exec_t>& exec_types,
+                                         std::vector<int64_t>&          dim_sizes,
+                                         std::vector<int64_t>&          strides_in0,
+                                         std::vector<int64_t>&          strides_in1,
+                                         std::vector<int64_t>&          strides_out,
+                                         int64_t                        thread_target,
+                                         int64_t                        max_kernel_size,
+                                         int64_t                        min_kernel_size,
+                                         CostModel const&               cost_model)
 {
     // Convert input vectors to a vector of Dimensions
     std::vector<mini_jit::ir::Dimension> dimensions;
@@ -50,11 +268,14 @@ void mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::dim_t>&  dim_types,
                                            strides_in1,
                                            strides_out,
                                            dimensions);
-    // Optimize the dimensions
-    optimize(dimensions,
-             thread_target,
-             max_kernel_size,
-             min_kernel_size);
+    // Optimize the dimensions, the configuration cannot represent remainders
+    double l_score = optimizeDimensions(dimensions,
+                                        thread_target,
+                                        max_kernel_size,
+                                        min_kernel_size,
+                                        cost_model,
+                                        false,
+                                        nullptr);
     // Convert the optimized dimensions back to the original format
     IRConverter::convertDimensionsToConfig(dimensions,
                                            dim_types,
@@ -63,6 +284,46 @@ void mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::dim_t>&  dim_types,
                                            strides_in0,
                                            strides_in1,
                                            strides_out);
+    return l_score;
+}
+
+double mini_jit::ir::Optimizer::optimize(std::vector<mini_jit::dim_t>&  dim_types,
+                                         std::vector<mini_jit::exec_t>& exec_types,
+                                         std::vector<int64_t>&          dim_sizes,
+                                         std::vector<int64_t>&          strides_in0,
+                                         std::vector<int64_t>&          strides_in1,
+                                         std::vector<int64_t>&          strides_out,
+                                         std::vector<int64_t>&          dim_remainders,
+                                         int64_t                        thread_target,
+                                         int64_t                        max_kernel_size,
+                                         int64_t                        min_kernel_size,
+                                         CostModel const&               cost_model,
+                                         OptimizationReport*            report)
+{
+    std::vector<mini_jit::ir::Dimension> dimensions;
+    IRConverter::convertConfigToDimensions(dim_types,
+                                           exec_types,
+                                           dim_sizes,
+                                           strides_in0,
+                                           strides_in1,
+                                           strides_out,
+                                           dim_remainders,
+                                           dimensions);
+    double l_score = optimize(dimensions,
+                              thread_target,
+                              max_kernel_size,
+                              min_kernel_size,
+                              cost_model,
+                              report);
+    IRConverter::convertDimensionsToConfig(dimensions,
+                                           dim_types,
+                                           exec_types,
+                                           dim_sizes,
+                                           strides_in0,
+                                           strides_in1,
+                                           strides_out,
+                                           dim_remainders);
+    return l_score;
 }
 
 void mini_jit::ir::Optimizer::identifyPrimitives(std::vector<mini_jit::ir::Dimension>& dimensions)
@@ -379,6 +640,49 @@ void mini_jit::ir::Optimizer::identifyPrimitives(std::vector<mini_jit::ir::Dimen
     }
 }
 
+void mini_jit::ir::Optimizer::peelDimensions(std::vector<mini_jit::ir::Dimension>& dimensions,
+                                             int64_t                               max_kernel_size)
+{
+    for (size_t i = 0; i < dimensions.size(); i++)
+    {
+        mini_jit::ir::Dimension& l_dim = dimensions[i];
+        if (l_dim.exec_type != exec_t::prim ||
+            (l_dim.type != dim_t::m && l_dim.type != dim_t::n) ||
+            l_dim.size <= max_kernel_size)
+        {
+            continue;
+        }
+
+        // blocks of equal size, rounded up to the register blocking of the kernels
+        int64_t l_granule    = l_dim.type == dim_t::m ? 16 : 4;
+        l_granule            = max_kernel_size >= l_granule ? l_granule : 1;
+        int64_t l_num_blocks = (l_dim.size + max_kernel_size - 1) / max_kernel_size;
+        int64_t l_block_size = (l_dim.size + l_num_blocks - 1) / l_num_blocks;
+        l_block_size         = (l_block_size + l_granule - 1) / l_granule * l_granule;
+        if (l_block_size > max_kernel_size)
+        {
+            l_block_size = max_kernel_size / l_granule * l_granule;
+        }
+
+        int64_t                 l_num_iters = (l_dim.size + l_block_size - 1) / l_block_size;
+        int64_t                 l_remainder = l_dim.size - (l_num_iters - 1) * l_block_size;
+        mini_jit::ir::Dimension l_dim_loop(l_dim.type,
+                                           exec_t::seq,
+                                           l_num_iters,
+                                           l_dim.stride_in0 * l_block_size,
+                                           l_dim.stride_in1 * l_block_size,
+                                           l_dim.stride_out * l_block_size,
+                                           l_remainder != l_block_size ? l_remainder : 0);
+        l_dim.size = l_block_size;
+
+        // the loop is placed in front of the primitive dimensions
+        auto l_first_prim = std::find_if(dimensions.begin(), dimensions.end(), [](const mini_jit::ir::Dimension& dim)
+                                         { return dim.exec_type == exec_t::prim; });
+        dimensions.insert(l_first_prim, l_dim_loop);
+        i++;
+    }
+}
+
 void mini_jit::ir::Optimizer::splitDimensions(std::vector<mini_jit::ir::Dimension>& dimensions,
                                               int64_t                               max_kernel_size,
                                               int64_t                               min_kernel_size)
@@ -414,9 +718,249 @@ void mini_jit::ir::Optimizer::splitDimensions(std::vector<mini_jit::ir::Dimensio
     }
 }
 
+void mini_jit::ir::Optimizer::reorderDimensions(std::vector<mini_jit::ir::Dimension>& dimensions,
+                                                CostModel const&                      cost_model)
+{
+    std::vector<size_t> l_seq_ids;
+    for (size_t i = 0; i < dimensions.size(); i++)
+    {
+        if (dimensions[i].exec_type == exec_t::seq)
+        {
+            l_seq_ids.push_back(i);
+        }
+    }
+
+    if (l_seq_ids.size() < 2 || static_cast<int64_t>(l_seq_ids.size()) > MAX_REORDER_LOOPS)
+    {
+        return;
+    }
+
+    // the identity permutation comes first, so that the original order wins ties
+    std::vector<size_t> l_order(l_seq_ids.size());
+    for (size_t i = 0; i < l_order.size(); i++)
+    {
+        l_order[i] = i;
+    }
+
+    std::vector<mini_jit::ir::Dimension> l_original    = dimensions;
+    std::vector<mini_jit::ir::Dimension> l_permuted    = dimensions;
+    double                               l_min_traffic = cost_model.estimateTraffic(dimensions);
+    while (std::next_permutation(l_order.begin(), l_order.end()))
+    {
+        for (size_t i = 0; i < l_seq_ids.size(); i++)
+        {
+            l_permuted[l_seq_ids[i]] = l_original[l_seq_ids[l_order[i]]];
+        }
+
+        double l_traffic = cost_model.estimateTraffic(l_permuted);
+        if (l_traffic < l_min_traffic)
+        {
+            l_min_traffic = l_traffic;
+            dimensions    = l_permuted;
+        }
+    }
+}
+
+void mini_jit::ir::Optimizer::tileDimensions(std::vector<mini_jit::ir::Dimension>& dimensions,
+                                             CostModel const&                      cost_model)
+{
+    // innermost sequential loops and kernel extents per dimension type
+    int64_t l_seq_m_id = -1;
+    int64_t l_seq_n_id = -1;
+    int64_t l_seq_k_id = -1;
+    int64_t l_prim_m   = 1;
+    int64_t l_prim_n   = 1;
+    int64_t l_prim_k   = 1;
+    for (size_t i = 0; i < dimensions.size(); i++)
+    {
+        mini_jit::ir::Dimension const& l_dim = dimensions[i];
+        if (l_dim.exec_type == exec_t::prim)
+        {
+            l_prim_m *= l_dim.type == dim_t::m ? l_dim.size : 1;
+            l_prim_n *= l_dim.type == dim_t::n ? l_dim.size : 1;
+            l_prim_k *= l_dim.type == dim_t::k ? l_dim.size : 1;
+        }
+        else if (l_dim.exec_type == exec_t::seq)
+        {
+            l_seq_m_id = l_dim.type == dim_t::m ? static_cast<int64_t>(i) : l_seq_m_id;
+            l_seq_n_id = l_dim.type == dim_t::n ? static_cast<int64_t>(i) : l_seq_n_id;
+            l_seq_k_id = l_dim.type == dim_t::k ? static_cast<int64_t>(i) : l_seq_k_id;
+        }
+    }
+
+    // the last iteration of a peeled N loop has to stay the last iteration of a single loop
+    if (l_seq_n_id == -1 || l_seq_k_id == -1 || dimensions[l_seq_n_id].remainder != 0)
+    {
+        return;
+    }
+
+    int64_t l_element_size = cost_model.getHardware().element_size;
+    int64_t l_l1_size      = cost_model.getHardware().l1_size;
+    int64_t l_l2_size      = cost_model.getHardware().l2_size;
+
+    auto l_largest_divisor = [](int64_t size, auto fits)
+    {
+        for (int64_t l_divisor = size; l_divisor > 1; l_divisor--)
+        {
+            if (size % l_divisor == 0 && fits(l_divisor))
+            {
+                return l_divisor;
+            }
+        }
+        return int64_t(1);
+    };
+
+    // A panel: one kernel row of M times the inner K blocks
+    int64_t l_tile_k = l_largest_divisor(dimensions[l_seq_k_id].size, [&](int64_t tile)
+                                         { return l_prim_m * l_prim_k * tile * l_element_size <= l_l1_size / 2; });
+    // B panel: the inner K blocks times the inner N blocks
+    int64_t l_tile_n = l_largest_divisor(dimensions[l_seq_n_id].size, [&](int64_t tile)
+                                         { return l_prim_k * l_tile_k * l_prim_n * tile * l_element_size <= l_l2_size / 2; });
+
+    auto l_split = [](mini_jit::ir::Dimension const& dim, int64_t tile)
+    {
+        // outer part iterates over the tiles, inner part within a tile
+        return std::make_pair(mini_jit::ir::Dimension(dim.type,
+                                                      exec_t::seq,
+                                                      dim.size / tile,
+                                                      dim.stride_in0 * tile,
+                                                      dim.stride_in1 * tile,
+                                                      dim.stride_out * tile),
+                              mini_jit::ir::Dimension(dim.type,
+                                                      exec_t::seq,
+                                                      tile,
+                                                      dim.stride_in0,
+                                                      dim.stride_in1,
+                                                      dim.stride_out));
+    };
+    auto [l_n_outer, l_n_inner] = l_split(dimensions[l_seq_n_id], l_tile_n);
+    auto [l_k_outer, l_k_inner] = l_split(dimensions[l_seq_k_id], l_tile_k);
+
+    std::vector<mini_jit::ir::Dimension> l_tiled;
+    std::vector<mini_jit::ir::Dimension> l_prims;
+    for (size_t i = 0; i < dimensions.size(); i++)
+    {
+        int64_t l_id = static_cast<int64_t>(i);
+        if (dimensions[i].exec_type == exec_t::prim)
+        {
+            l_prims.push_back(dimensions[i]);
+        }
+        else if (l_id != l_seq_m_id && l_id != l_seq_n_id && l_id != l_seq_k_id)
+        {
+            // shared loops and further sequential loops keep their order in front of the tiles
+            l_tiled.push_back(dimensions[i]);
+        }
+    }
+
+    // loops of size one are dropped
+    for (mini_jit::ir::Dimension const* l_dim : {&l_n_outer, &l_k_outer})
+    {
+        if (l_dim->size > 1)
+        {
+            l_tiled.push_back(*l_dim);
+        }
+    }
+    if (l_seq_m_id != -1)
+    {
+        l_tiled.push_back(dimensions[l_seq_m_id]);
+    }
+    for (mini_jit::ir::Dimension const* l_dim : {&l_n_inner, &l_k_inner})
+    {
+        if (l_dim->size > 1)
+        {
+            l_tiled.push_back(*l_dim);
+        }
+    }
+    l_tiled.insert(l_tiled.end(), l_prims.begin(), l_prims.end());
+
+    dimensions = std::move(l_tiled);
+}
+
+std::vector<std::pair<int64_t, int64_t>> mini_jit::ir::Optimizer::findSplitCandidates(int64_t i_size,
+                                                                                      int64_t i_max_kernel_size,
+                                                                                      int64_t i_min_kernel_size)
+{
+    std::vector<std::pair<int64_t, int64_t>> l_candidates;
+
+    // the kernels only handle even split sizes efficiently
+    int64_t l_start = std::min(i_max_kernel_size, i_size) / 2 * 2;
+    for (int64_t l_size_1 = l_start; l_size_1 >= std::max<int64_t>(2, i_min_kernel_size); l_size_1 -= 2)
+    {
+        if (i_size % l_size_1 == 0 && i_size / l_size_1 >= i_min_kernel_size)
+        {
+            l_candidates.emplace_back(i_size / l_size_1, l_size_1);
+            if (static_cast<int64_t>(l_candidates.size()) == MAX_SPLIT_CANDIDATES)
+            {
+                break;
+            }
+        }
+    }
+
+    return l_candidates;
+}
+
+void mini_jit::ir::Optimizer::enumerateSplits(std::vector<mini_jit::ir::Dimension> const&        i_dimensions,
+                                              size_t                                             i_index,
+                                              int64_t                                            i_max_kernel_size,
+                                              int64_t                                            i_min_kernel_size,
+                                              std::vector<std::vector<mini_jit::ir::Dimension>>& o_configurations)
+{
+    for (size_t i = i_index; i < i_dimensions.size(); i++)
+    {
+        if (i_dimensions[i].size <= i_max_kernel_size)
+        {
+            continue;
+        }
+
+        auto l_candidates = findSplitCandidates(i_dimensions[i].size,
+                                                i_max_kernel_size,
+                                                i_min_kernel_size);
+        if (l_candidates.empty())
+        {
+            continue;
+        }
+
+        for (auto const& [l_size_dim_0, l_size_dim_1] : l_candidates)
+        {
+            if (static_cast<int64_t>(o_configurations.size()) >= MAX_CONFIGURATIONS)
+            {
+                return;
+            }
+
+            // same as in splitDimensions: the new seq dimension is checked for a split again
+            std::vector<mini_jit::ir::Dimension> l_dimensions = i_dimensions;
+            mini_jit::ir::Dimension              l_dim_new(l_dimensions[i].type,
+                                                           exec_t::seq,
+                                                           l_size_dim_0,
+                                                           l_dimensions[i].stride_in0 * l_size_dim_1,
+                                                           l_dimensions[i].stride_in1 * l_size_dim_1,
+                                                           l_dimensions[i].stride_out * l_size_dim_1);
+            l_dimensions[i].size = l_size_dim_1;
+            l_dimensions.push_back(l_dim_new);
+
+            enumerateSplits(l_dimensions,
+                            i + 1,
+                            i_max_kernel_size,
+                            i_min_kernel_size,
+                            o_configurations);
+        }
+        return;
+    }
+
+    if (static_cast<int64_t>(o_configurations.size()) < MAX_CONFIGURATIONS)
+    {
+        o_configurations.push_back(i_dimensions);
+    }
+}
+
 void mini_jit::ir::Optimizer::createSharedLoops(std::vector<mini_jit::ir::Dimension>& dimensions,
                                                 int64_t                               thread_target)
 {
+    if (thread_target <= 0)
+    {
+        thread_target = omp_get_max_threads();
+    }
+
     int64_t l_num_threads = 1;
 
     // Count the number of existing iterations for shared loops
@@ -438,19 +982,80 @@ void mini_jit::ir::Optimizer::createSharedLoops(std::vector<mini_jit::ir::Dimens
         return;
     }
 
-    // Creation of new shared loops:
+    // Candidates for new shared loops:
+    // dont parallelize the k dimension (see class slides)
+    std::vector<size_t>               l_candidate_ids;
+    std::vector<std::vector<int64_t>> l_options;
+    int64_t                           l_max_tasks = MAX_OVERSUBSCRIPTION * thread_target;
     for (size_t i = 0; i < dimensions.size(); i++)
     {
-        // if the dimension can be set to shared and we did not reach the target number of threads yet
-        // we set the dimension to shared
-        // also dont parallelize the k dimension (see class slides)
-        if ((dimensions[i].exec_type == exec_t::seq || dimensions[i].exec_type == exec_t::undefined) &&
-            dimensions[i].type != dim_t::k &&
-            l_num_threads * dimensions[i].size <= thread_target)
+        if ((dimensions[i].exec_type != exec_t::seq && dimensions[i].exec_type != exec_t::undefined) ||
+            dimensions[i].type == dim_t::k ||
+            dimensions[i].size <= 1)
+        {
+            continue;
+        }
+
+        // sharing the whole dimension comes before sharing the outer part of a split,
+        // keeping the dimension sequential comes last, so that outer loops are preferred
+        // a loop with a remainder is only shared as a whole, so that its last iteration stays unique
+        std::vector<int64_t> l_sizes;
+        for (int64_t l_size = std::min(dimensions[i].size, l_max_tasks / l_num_threads); l_size > 1; l_size--)
+        {
+            if (dimensions[i].size % l_size == 0 &&
+                (dimensions[i].remainder == 0 || l_size == dimensions[i].size))
+            {
+                l_sizes.push_back(l_size);
+            }
+        }
+        if (l_sizes.empty())
+        {
+            continue;
+        }
+        l_sizes.push_back(1);
+
+        l_candidate_ids.push_back(i);
+        l_options.push_back(std::move(l_sizes));
+    }
+
+    std::vector<int64_t> l_choice;
+    std::vector<int64_t> l_best_choice(l_options.size(), 1);
+    int64_t              l_best_tasks = l_num_threads;
+    searchSharedLoops(l_options,
+                      0,
+                      l_num_threads,
+                      thread_target,
+                      l_choice,
+                      l_best_choice,
+                      l_best_tasks);
+
+    // Creation of new shared loops, back to front so that the candidate ids stay valid
+    for (size_t l_id = l_candidate_ids.size(); l_id-- > 0;)
+    {
+        size_t  i             = l_candidate_ids[l_id];
+        int64_t l_shared_size = l_best_choice[l_id];
+        if (l_shared_size == 1)
+        {
+            continue;
+        }
+
+        if (l_shared_size == dimensions[i].size)
         {
             dimensions[i].exec_type = exec_t::shared;
-            l_num_threads *= dimensions[i].size;
+            continue;
         }
+
+        // the outer part of the split is shared, the inner part stays sequential
+        int64_t                 l_inner_size = dimensions[i].size / l_shared_size;
+        mini_jit::ir::Dimension l_dim_shared(dimensions[i].type,
+                                             exec_t::shared,
+                                             l_shared_size,
+                                             dimensions[i].stride_in0 * l_inner_size,
+                                             dimensions[i].stride_in1 * l_inner_size,
+                                             dimensions[i].stride_out * l_inner_size);
+        dimensions[i].size      = l_inner_size;
+        dimensions[i].exec_type = exec_t::seq;
+        dimensions.insert(dimensions.begin() + i, l_dim_shared);
     }
 
     // Move all shared loops to the front
@@ -458,6 +1063,54 @@ void mini_jit::ir::Optimizer::createSharedLoops(std::vector<mini_jit::ir::Dimens
                           { return dim.exec_type == exec_t::shared; });
 }
 
+double mini_jit::ir::Optimizer::getParallelEfficiency(int64_t num_tasks,
+                                                      int64_t num_threads)
+{
+    int64_t l_num_rounds = (num_tasks + num_threads - 1) / num_threads;
+    return static_cast<double>(num_tasks) / static_cast<double>(l_num_rounds * num_threads);
+}
+
+void mini_jit::ir::Optimizer::searchSharedLoops(std::vector<std::vector<int64_t>> const& i_options,
+                                                size_t                                   i_index,
+                                                int64_t                                  i_num_tasks,
+                                                int64_t                                  i_num_threads,
+                                                std::vector<int64_t>&                    io_choice,
+                                                std::vector<int64_t>&                    o_best_choice,
+                                                int64_t&                                 o_best_tasks)
+{
+    if (i_index == i_options.size())
+    {
+        double l_efficiency      = getParallelEfficiency(i_num_tasks, i_num_threads);
+        double l_best_efficiency = getParallelEfficiency(o_best_tasks, i_num_threads);
+        // fewer tasks have a lower scheduling overhead and keep more work in the sequential loops
+        if (l_efficiency > l_best_efficiency + 1e-12 ||
+            (l_efficiency > l_best_efficiency - 1e-12 && i_num_tasks < o_best_tasks))
+        {
+            o_best_choice = io_choice;
+            o_best_tasks  = i_num_tasks;
+        }
+        return;
+    }
+
+    for (int64_t l_size : i_options[i_index])
+    {
+        if (i_num_tasks * l_size > MAX_OVERSUBSCRIPTION * i_num_threads)
+        {
+            continue;
+        }
+
+        io_choice.push_back(l_size);
+        searchSharedLoops(i_options,
+                          i_index + 1,
+                          i_num_tasks * l_size,
+                          i_num_threads,
+                          io_choice,
+                          o_best_choice,
+                          o_best_tasks);
+        io_choice.pop_back();
+    }
+}
+
 void mini_jit::ir::Optimizer::findBestSplit(int64_t  i_size,
                                             int64_t  i_max_kernel_size,
                                             int64_t  i_min_kernel_size,
@@ -583,36 +1236,68 @@ void mini_jit::ir::Optimizer::findLargestMultipleOfDivisor(int64_t  i_divisor,
 void mini_jit::ir::Optimizer::fuseDimensions(std::vector<mini_jit::ir::Dimension>& dimensions,
                                              int64_t                               min_kernel_size)
 {
-    // Dimensions should be fused if they are small enough (< min_kernel_size)
-    // Config object: Two dimensions X and Y can be fused can be fused if for all tensors: stride(X) = |Y| ⨉ stride(Y).
-    // For both dimensions X and Y, the type has to be the same, and the execution type (exec.type) has to be the same or undefined.
-    for (size_t i = 0; i < dimensions.size(); i++)
+    // Dimensions should be fused if one of them is small enough (< min_kernel_size)
+    // Config object: Two dimensions X and Y can be fused if for all tensors: stride(X) = |Y| ⨉ stride(Y).
+    // This includes tensors which are not indexed by either dimension (stride 0 in both).
+    // For both dimensions X and Y, the type has to be the same. Undefined execution types adopt the other one,
+    // a SEQ loop is absorbed by a SHARED loop or by a PRIM dimension, which then covers both.
+    auto l_fused_exec_type = [](exec_t exec_0, exec_t exec_1, exec_t& fused)
+    {
+        if (exec_0 == exec_1 || exec_1 == exec_t::undefined)
+        {
+            fused = exec_0;
+        }
+        else if (exec_0 == exec_t::undefined)
+        {
+            fused = exec_1;
+        }
+        else if (exec_0 == exec_t::seq && (exec_1 == exec_t::shared || exec_1 == exec_t::prim))
+        {
+            fused = exec_1;
+        }
+        else if (exec_1 == exec_t::seq && (exec_0 == exec_t::shared || exec_0 == exec_t::prim))
+        {
+            fused = exec_0;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    };
+
+    // fusing two dimensions may allow further fusions, so repeat until nothing changes
+    bool l_fused = true;
+    while (l_fused)
     {
-        mini_jit::ir::Dimension& l_dim_0 = dimensions[i];
-        if (l_dim_0.size < min_kernel_size)
+        l_fused = false;
+        for (size_t i = 0; i < dimensions.size() && !l_fused; i++)
         {
-            // find a dimension that can be fused with the current one
-            for (size_t j = 0; j < dimensions.size(); j++)
+            for (size_t j = 0; j < dimensions.size() && !l_fused; j++)
             {
-                if (i == j)
-                    continue; // skip self
-
-                mini_jit::ir::Dimension& l_dim_1 = dimensions[j];
-                if (l_dim_0.type == l_dim_1.type &&
-                    (l_dim_0.exec_type == l_dim_1.exec_type ||
-                     l_dim_0.exec_type == exec_t::undefined ||
-                     l_dim_1.exec_type == exec_t::undefined) &&
-                    l_dim_1.stride_in0 == l_dim_0.size * l_dim_0.stride_in0 &&
-                    l_dim_1.stride_in1 == l_dim_0.size * l_dim_0.stride_in1 &&
-                    l_dim_1.stride_out == l_dim_0.size * l_dim_0.stride_out)
+                // dimension i is the inner and dimension j the outer one
+                mini_jit::ir::Dimension const& l_dim_inner = dimensions[i];
+                mini_jit::ir::Dimension const& l_dim_outer = dimensions[j];
+                exec_t                         l_exec_type = exec_t::undefined;
+                if (i == j ||
+                    (l_dim_inner.size >= min_kernel_size && l_dim_outer.size >= min_kernel_size) ||
+                    l_dim_inner.type != l_dim_outer.type ||
+                    l_dim_inner.remainder != 0 ||
+                    l_dim_outer.remainder != 0 ||
+                    !l_fused_exec_type(l_dim_inner.exec_type, l_dim_outer.exec_type, l_exec_type) ||
+                    l_dim_outer.stride_in0 != l_dim_inner.size * l_dim_inner.stride_in0 ||
+                    l_dim_outer.stride_in1 != l_dim_inner.size * l_dim_inner.stride_in1 ||
+                    l_dim_outer.stride_out != l_dim_inner.size * l_dim_inner.stride_out)
                 {
-                    // fuse the two dimensions
-                    l_dim_0.size *= l_dim_1.size;
-                    // remove the fused dimension
-                    dimensions.erase(dimensions.begin() + j);
-                    j--; // adjust index after erasing
+                    continue;
                 }
+
+                // the fused dimension keeps the strides and the position of the inner dimension
+                dimensions[i].size *= dimensions[j].size;
+                dimensions[i].exec_type = l_exec_type;
+                dimensions.erase(dimensions.begin() + j);
+                l_fused = true;
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -57,7 +57,7 @@ void mini_jit::kernels::binary::mul(mini_jit::Kernel& kernel,
                       mov(x9, n)});
 
     // Start n loop (1 column)
-    kernel.add_label("n_loop");
+    mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
     kernel.add_instr({
         // Set m loop counter
@@ -71,7 +71,7 @@ void mini_jit::kernels::binary::mul(mini_jit::Kernel& kernel,
 
     if (mLoopIterations > 0)
     {
-        kernel.add_label("m_16_loop");
+        mini_jit::Kernel::label_t l_m_16_loop = kernel.add_label();
         kernel.add_instr({
             // load 16 elements from A
             ldp(v0, v1, x11, 0, q),
@@ -100,7 +100,7 @@ void mini_jit::kernels::binary::mul(mini_jit::Kernel& kernel,
             sub(x10, x10, 1, 0),
         });
         // check if loop counter is zero
-        kernel.add_instr(cbnz(x10, -kernel.getInstrCountFromLabel("m_16_loop") * 4));
+        kernel.add_branch(cbnz(x10, 0), l_m_16_loop);
     }
 
     if (mLoopRemainder > 0)
@@ -335,8 +335,7 @@ void mini_jit::kernels::binary::mul(mini_jit::Kernel& kernel,
                       // decrement n loop counter
                       sub(x9, x9, 1, 0)});
     // check if n loop counter is zero
-    int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-    kernel.add_instr(cbnz(x9, -l_nLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x9, 0), l_n_loop);
 
     kernel.add_instr({// Restore callee-saved registers
                       ldpPost(v14, v15, sp, 16, d),
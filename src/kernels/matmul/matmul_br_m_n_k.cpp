@@ -62,7 +62,7 @@ void mini_jit::kernels::matmul::matmul_br_m_n_k(mini_jit::Kernel& kernel,
     // x24 is not free!
     kernel.add_instr(base::mov(gpr_t::x25, br_size));
 
-    kernel.add_label("batch_loop");
+    mini_jit::Kernel::label_t l_batch_loop = kernel.add_label();
 
     // N loop counter
     kernel.add_instr(base::mov(gpr_t::x19, nLoopIterations));
@@ -70,7 +70,7 @@ void mini_jit::kernels::matmul::matmul_br_m_n_k(mini_jit::Kernel& kernel,
     if (nLoopIterations > 0)
     {
         // n_loop:
-        kernel.add_label("n_loop");
+        mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
         // Save base matrix pointers
         kernel.add_instr(base::mov(gpr_t::x8, gpr_t::x0));   // A
@@ -151,8 +151,7 @@ void mini_jit::kernels::matmul::matmul_br_m_n_k(mini_jit::Kernel& kernel,
         kernel.add_instr(base::sub(gpr_t::x19, gpr_t::x19, 1, 0));
 
         // check if loop counter is zero
-        int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-        kernel.add_instr(base::cbnz(gpr_t::x19, -l_nLoopInstrCount * 4));
+        kernel.add_branch(base::cbnz(gpr_t::x19, 0), l_n_loop);
         // END N LOOP
     }
 
@@ -193,8 +192,7 @@ void mini_jit::kernels::matmul::matmul_br_m_n_k(mini_jit::Kernel& kernel,
     // decrement batch loop counter
     kernel.add_instr(base::sub(gpr_t::x25, gpr_t::x25, 1, 0));
     // check if loop counter is zero
-    int l_batchLoopInstrCount = kernel.getInstrCountFromLabel("batch_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x25, -l_batchLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x25, 0), l_batch_loop);
     // END BATCH LOOP
 
     // Restore callee-saved registers
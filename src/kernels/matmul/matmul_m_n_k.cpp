@@ -60,7 +60,7 @@ void mini_jit::kernels::matmul::matmul_m_n_k(mini_jit::Kernel& kernel,
     if (nLoopIterations > 0)
     {
         // n_loop:
-        kernel.add_label("n_loop");
+        mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
         // Save base matrix pointers
         kernel.add_instr(base::mov(gpr_t::x8, gpr_t::x0));   // A
@@ -141,8 +141,7 @@ void mini_jit::kernels::matmul::matmul_m_n_k(mini_jit::Kernel& kernel,
         kernel.add_instr(base::sub(gpr_t::x19, gpr_t::x19, 1, 0));
 
         // check if loop counter is zero
-        int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-        kernel.add_instr(base::cbnz(gpr_t::x19, -l_nLoopInstrCount * 4));
+        kernel.add_branch(base::cbnz(gpr_t::x19, 0), l_n_loop);
         // END N LOOP
     }
 
@@ -142,7 +142,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N1Loop(mini_jit
     kernel.add_instr(base::mov(gpr_t::x11, mLoopIterations));
 
     // START M_LOOP
-    kernel.add_label("m16n1_loop");
+    mini_jit::Kernel::label_t l_m16n1_loop = kernel.add_label();
     // Load Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
     // first column
@@ -156,7 +156,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N1Loop(mini_jit
     kernel.add_instr(base::mov(gpr_t::x17, 0));         // Row index for Matrix B
 
     // START K_LOOP
-    kernel.add_label("k_m16n1_loop");
+    mini_jit::Kernel::label_t l_k_m16n1_loop = kernel.add_label();
     //  Load column of A (8 values)
     kernel.add_instr(base::mov(gpr_t::x13, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x13, 0, neon_size_spec_t::q));
@@ -181,8 +181,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N1Loop(mini_jit
 
     // END K_LOOP
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m16n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m16n1_loop);
 
     // Store Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -197,8 +196,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N1Loop(mini_jit
     // decrement M loop counter
     kernel.add_instr(base::sub(gpr_t::x11, gpr_t::x11, 1, 0));
 
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m16n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x11, -l_mLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x11, 0), l_m16n1_loop);
     // END M_LOOP
 }
 
@@ -210,7 +208,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM1N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v0, gpr_t::x12, 0, neon_size_spec_t::s));
 
     // case_1_k_loop:
-    kernel.add_label("k_m1n1_loop");
+    mini_jit::Kernel::label_t l_k_m1n1_loop = kernel.add_label();
     // load column of A (1 value)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::s));
 
@@ -228,8 +226,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM1N1Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m1n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m1n1_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -245,7 +242,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM2N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v0, gpr_t::x12, 0, neon_size_spec_t::d));
 
     // case_2_km1n1_loop:
-    kernel.add_label("k_m2n1_loop");
+    mini_jit::Kernel::label_t l_k_m2n1_loop = kernel.add_label();
     // load column of A (2 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::d));
 
@@ -263,8 +260,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM2N1Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m2n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m2n1_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -282,7 +278,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM3N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v1, gpr_t::x24, 0, neon_size_spec_t::s));
 
     // case_3_km1n1_loop:
-    kernel.add_label("k_m3n1_loop");
+    mini_jit::Kernel::label_t l_k_m3n1_loop = kernel.add_label();
     // load column of A (3 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v24, gpr_t::x24, 8, neon_size_spec_t::d));
@@ -303,8 +299,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM3N1Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m3n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m3n1_loop);
 
     // STORE MATRIX C (3 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -322,7 +317,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM4N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v0, gpr_t::x12, 0, neon_size_spec_t::q));
 
     // case_4_km1n1_loop:
-    kernel.add_label("k_m4n1_loop");
+    mini_jit::Kernel::label_t l_k_m4n1_loop = kernel.add_label();
     // load column of A (4 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     // B: COLUMN 0
@@ -339,8 +334,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM4N1Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m4n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m4n1_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -357,7 +351,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM5N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v1, gpr_t::x12, 16, neon_size_spec_t::s));
 
     // case_5_km1n1_loop:
-    kernel.add_label("k_m5n1_loop");
+    mini_jit::Kernel::label_t l_k_m5n1_loop = kernel.add_label();
     // load column of A (5 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v25, gpr_t::x15, 16, neon_size_spec_t::s));
@@ -377,8 +371,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM5N1Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m5n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m5n1_loop);
 
     // STORE MATRIX C (5 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -396,7 +389,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM6N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v1, gpr_t::x12, 16, neon_size_spec_t::d));
 
     // case_6_km1n1_loop:
-    kernel.add_label("k_m6n1_loop");
+    mini_jit::Kernel::label_t l_k_m6n1_loop = kernel.add_label();
     // load column of A (6 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v25, gpr_t::x15, 16, neon_size_spec_t::d));
@@ -416,8 +409,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM6N1Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m6n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m6n1_loop);
 
     // STORE MATRIX C (6 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -437,7 +429,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM7N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v2, gpr_t::x20, 0, neon_size_spec_t::s));
 
     // case_7_km1n1_loop:
-    kernel.add_label("k_m7n1_loop");
+    mini_jit::Kernel::label_t l_k_m7n1_loop = kernel.add_label();
     // load column of A (7 values)
     kernel.add_instr(base::mov(gpr_t::x20, gpr_t::x15));
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v24, gpr_t::x20, 16, neon_size_spec_t::q));
@@ -458,8 +450,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM7N1Loop(mini_jit:
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m7n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m7n1_loop);
 
     // STORE MATRIX C (7 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -478,7 +469,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM8N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v0, simd_fp_t::v1, gpr_t::x12, 0, neon_size_spec_t::q));
 
     // START K_LOOP
-    kernel.add_label("k_m8n1_loop");
+    mini_jit::Kernel::label_t l_k_m8n1_loop = kernel.add_label();
     //  Load column of A (8 values)
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x15, 0, neon_size_spec_t::q));
 
@@ -499,8 +490,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM8N1Loop(mini_jit:
 
     // END K_LOOP
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m8n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m8n1_loop);
 
     // Store Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -517,7 +507,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM9N1Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v2, gpr_t::x12, 32, neon_size_spec_t::s));
 
     // case_9_k_loop:
-    kernel.add_label("k_m9n1_loop");
+    mini_jit::Kernel::label_t l_k_m9n1_loop = kernel.add_label();
     // load column of A (9 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -537,8 +527,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM9N1Loop(mini_jit:
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m9n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m9n1_loop);
 
     // STORE MATRIX C (9 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -556,7 +545,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM10N1Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v2, gpr_t::x12, 32, neon_size_spec_t::d));
 
     // case_10_k_loop:
-    kernel.add_label("k_m10n1_loop");
+    mini_jit::Kernel::label_t l_k_m10n1_loop = kernel.add_label();
     // load column of A (10 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -576,8 +565,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM10N1Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m10n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m10n1_loop);
 
     // STORE MATRIX C (10 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -596,7 +584,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM11N1Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x12, 40, neon_size_spec_t::s));
 
     // case_11_k_loop:
-    kernel.add_label("k_m11n1_loop");
+    mini_jit::Kernel::label_t l_k_m11n1_loop = kernel.add_label();
     // load column of A (11 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -618,8 +606,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM11N1Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m11n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m11n1_loop);
 
     // STORE MATRIX C (11 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -638,7 +625,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM12N1Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v2, gpr_t::x12, 32, neon_size_spec_t::q));
 
     // case_12_k_loop:
-    kernel.add_label("k_m12n1_loop");
+    mini_jit::Kernel::label_t l_k_m12n1_loop = kernel.add_label();
     // load column of A (12 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -658,8 +645,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM12N1Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m12n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m12n1_loop);
 
     // STORE MATRIX C (12 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -678,7 +664,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM13N1Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x12, 48, neon_size_spec_t::s));
 
     // case_13_k_loop:
-    kernel.add_label("k_m13n1_loop");
+    mini_jit::Kernel::label_t l_k_m13n1_loop = kernel.add_label();
     // load column of A (13 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -700,8 +686,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM13N1Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m13n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m13n1_loop);
 
     // STORE MATRIX C (13 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -721,7 +706,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM14N1Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x12, 48, neon_size_spec_t::d));
 
     // case_14_k_loop:
-    kernel.add_label("k_m14n1_loop");
+    mini_jit::Kernel::label_t l_k_m14n1_loop = kernel.add_label();
     // load column of A (14 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -743,8 +728,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM14N1Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m14n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m14n1_loop);
 
     // STORE MATRIX C (14 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -765,7 +749,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM15N1Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v4, gpr_t::x12, 56, neon_size_spec_t::s));
 
     // case_15_k_loop:
-    kernel.add_label("k_m15n1_loop");
+    mini_jit::Kernel::label_t l_k_m15n1_loop = kernel.add_label();
     // load column of A (15 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -789,8 +773,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM15N1Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m15n1_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m15n1_loop);
 
     // STORE MATRIX C (15 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -142,7 +142,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N2Loop(mini_jit
     kernel.add_instr(base::mov(gpr_t::x11, mLoopIterations));
 
     // START M_LOOP
-    kernel.add_label("m16n2_loop");
+    mini_jit::Kernel::label_t l_m16n2_loop = kernel.add_label();
     // Load Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
     // first column
@@ -160,7 +160,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N2Loop(mini_jit
     kernel.add_instr(base::mov(gpr_t::x17, 0));         // Row index for Matrix B
 
     // START K_LOOP
-    kernel.add_label("k_m16n2_loop");
+    mini_jit::Kernel::label_t l_k_m16n2_loop = kernel.add_label();
     //  Load column of A (8 values)
     kernel.add_instr(base::mov(gpr_t::x13, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x13, 0, neon_size_spec_t::q));
@@ -195,8 +195,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N2Loop(mini_jit
 
     // END K_LOOP
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m16n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m16n2_loop);
 
     // Store Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -215,8 +214,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N2Loop(mini_jit
     // decrement M loop counter
     kernel.add_instr(base::sub(gpr_t::x11, gpr_t::x11, 1, 0));
 
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m16n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x11, -l_mLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x11, 0), l_m16n2_loop);
     // END M_LOOP
 }
 
@@ -231,7 +229,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM1N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v1, gpr_t::x12, 0, neon_size_spec_t::s));
 
     // case_1_k_loop:
-    kernel.add_label("k_m1n2_loop");
+    mini_jit::Kernel::label_t l_k_m1n2_loop = kernel.add_label();
     // load column of A (1 value)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::s));
 
@@ -253,8 +251,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM1N2Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m1n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m1n2_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -276,7 +273,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM2N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v1, gpr_t::x12, 0, neon_size_spec_t::d));
 
     // case_2_km1n2_loop:
-    kernel.add_label("k_m2n2_loop");
+    mini_jit::Kernel::label_t l_k_m2n2_loop = kernel.add_label();
     // load column of A (2 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::d));
 
@@ -298,8 +295,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM2N2Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m2n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m2n2_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -325,7 +321,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM3N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x24, 0, neon_size_spec_t::s));
 
     // case_3_km1n2_loop:
-    kernel.add_label("k_m3n2_loop");
+    mini_jit::Kernel::label_t l_k_m3n2_loop = kernel.add_label();
     // load column of A (3 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v24, gpr_t::x24, 8, neon_size_spec_t::d));
@@ -351,8 +347,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM3N2Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m3n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m3n2_loop);
 
     // STORE MATRIX C (3 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -378,7 +373,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM4N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v1, gpr_t::x12, 0, neon_size_spec_t::q));
 
     // case_4_km1n2_loop:
-    kernel.add_label("k_m4n2_loop");
+    mini_jit::Kernel::label_t l_k_m4n2_loop = kernel.add_label();
     // load column of A (4 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     // B: COLUMN 0
@@ -399,8 +394,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM4N2Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m4n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m4n2_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -424,7 +418,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM5N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x12, 16, neon_size_spec_t::s));
 
     // case_5_km1n2_loop:
-    kernel.add_label("k_m5n2_loop");
+    mini_jit::Kernel::label_t l_k_m5n2_loop = kernel.add_label();
     // load column of A (5 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v25, gpr_t::x15, 16, neon_size_spec_t::s));
@@ -449,8 +443,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM5N2Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m5n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m5n2_loop);
 
     // STORE MATRIX C (5 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -476,7 +469,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM6N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x12, 16, neon_size_spec_t::d));
 
     // case_6_km1n2_loop:
-    kernel.add_label("k_m6n2_loop");
+    mini_jit::Kernel::label_t l_k_m6n2_loop = kernel.add_label();
     // load column of A (6 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v25, gpr_t::x15, 16, neon_size_spec_t::d));
@@ -501,8 +494,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM6N2Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m6n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m6n2_loop);
 
     // STORE MATRIX C (6 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -532,7 +524,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM7N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v5, gpr_t::x20, 0, neon_size_spec_t::s));
 
     // case_7_km1n2_loop:
-    kernel.add_label("k_m7n2_loop");
+    mini_jit::Kernel::label_t l_k_m7n2_loop = kernel.add_label();
     // load column of A (7 values)
     kernel.add_instr(base::mov(gpr_t::x20, gpr_t::x15));
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v24, gpr_t::x20, 16, neon_size_spec_t::q));
@@ -559,8 +551,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM7N2Loop(mini_jit:
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m7n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m7n2_loop);
 
     // STORE MATRIX C (7 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -588,7 +579,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM8N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v2, simd_fp_t::v3, gpr_t::x12, 0, neon_size_spec_t::q));
 
     // START K_LOOP
-    kernel.add_label("k_m8n2_loop");
+    mini_jit::Kernel::label_t l_k_m8n2_loop = kernel.add_label();
     //  Load column of A (8 values)
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x15, 0, neon_size_spec_t::q));
 
@@ -617,8 +608,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM8N2Loop(mini_jit:
 
     // END K_LOOP
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m8n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m8n2_loop);
 
     // Store Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -642,7 +632,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM9N2Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v7, gpr_t::x12, 32, neon_size_spec_t::s));
 
     // case_9_k_loop:
-    kernel.add_label("k_m9n2_loop");
+    mini_jit::Kernel::label_t l_k_m9n2_loop = kernel.add_label();
     // load column of A (9 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -668,8 +658,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM9N2Loop(mini_jit:
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m9n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m9n2_loop);
 
     // STORE MATRIX C (9 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -695,7 +684,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM10N2Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v7, gpr_t::x12, 32, neon_size_spec_t::d));
 
     // case_10_k_loop:
-    kernel.add_label("k_m10n2_loop");
+    mini_jit::Kernel::label_t l_k_m10n2_loop = kernel.add_label();
     // load column of A (10 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -721,8 +710,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM10N2Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m10n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m10n2_loop);
 
     // STORE MATRIX C (10 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -750,7 +738,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM11N2Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v8, gpr_t::x12, 40, neon_size_spec_t::s));
 
     // case_11_k_loop:
-    kernel.add_label("k_m11n2_loop");
+    mini_jit::Kernel::label_t l_k_m11n2_loop = kernel.add_label();
     // load column of A (11 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -779,8 +767,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM11N2Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m11n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m11n2_loop);
 
     // STORE MATRIX C (11 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -808,7 +795,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM12N2Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v7, gpr_t::x12, 32, neon_size_spec_t::q));
 
     // case_12_k_loop:
-    kernel.add_label("k_m12n2_loop");
+    mini_jit::Kernel::label_t l_k_m12n2_loop = kernel.add_label();
     // load column of A (12 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -834,8 +821,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM12N2Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m12n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m12n2_loop);
 
     // STORE MATRIX C (12 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -863,7 +849,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM13N2Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v8, gpr_t::x12, 48, neon_size_spec_t::s));
 
     // case_13_k_loop:
-    kernel.add_label("k_m13n2_loop");
+    mini_jit::Kernel::label_t l_k_m13n2_loop = kernel.add_label();
     // load column of A (13 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -892,8 +878,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM13N2Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m13n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m13n2_loop);
 
     // STORE MATRIX C (13 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -923,7 +908,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM14N2Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v8, gpr_t::x12, 48, neon_size_spec_t::d));
 
     // case_14_k_loop:
-    kernel.add_label("k_m14n2_loop");
+    mini_jit::Kernel::label_t l_k_m14n2_loop = kernel.add_label();
     // load column of A (14 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -952,8 +937,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM14N2Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m14n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m14n2_loop);
 
     // STORE MATRIX C (14 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -985,7 +969,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM15N2Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v9, gpr_t::x12, 56, neon_size_spec_t::s));
 
     // case_15_k_loop:
-    kernel.add_label("k_m15n2_loop");
+    mini_jit::Kernel::label_t l_k_m15n2_loop = kernel.add_label();
     // load column of A (15 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1017,8 +1001,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM15N2Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m15n2_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m15n2_loop);
 
     // STORE MATRIX C (15 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -142,7 +142,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N3Loop(mini_jit
     kernel.add_instr(base::mov(gpr_t::x11, mLoopIterations));
 
     // START M_LOOP
-    kernel.add_label("m16n3_loop");
+    mini_jit::Kernel::label_t l_m16n3_loop = kernel.add_label();
     // Load Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
     // first column
@@ -164,7 +164,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N3Loop(mini_jit
     kernel.add_instr(base::mov(gpr_t::x17, 0));         // Row index for Matrix B
 
     // START K_LOOP
-    kernel.add_label("k_m16n3_loop");
+    mini_jit::Kernel::label_t l_k_m16n3_loop = kernel.add_label();
     //  Load column of A (8 values)
     kernel.add_instr(base::mov(gpr_t::x13, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x13, 0, neon_size_spec_t::q));
@@ -209,8 +209,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N3Loop(mini_jit
 
     // END K_LOOP
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m16n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m16n3_loop);
 
     // Store Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -233,8 +232,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N3Loop(mini_jit
     // decrement M loop counter
     kernel.add_instr(base::sub(gpr_t::x11, gpr_t::x11, 1, 0));
 
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m16n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x11, -l_mLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x11, 0), l_m16n3_loop);
     // END M_LOOP
 }
 
@@ -252,7 +250,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM1N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v2, gpr_t::x12, 0, neon_size_spec_t::s));
 
     // case_1_k_loop:
-    kernel.add_label("k_m1n3_loop");
+    mini_jit::Kernel::label_t l_k_m1n3_loop = kernel.add_label();
     // load column of A (1 value)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::s));
 
@@ -278,8 +276,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM1N3Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m1n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m1n3_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -307,7 +304,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM2N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v2, gpr_t::x12, 0, neon_size_spec_t::d));
 
     // case_2_km1n3_loop:
-    kernel.add_label("k_m2n3_loop");
+    mini_jit::Kernel::label_t l_k_m2n3_loop = kernel.add_label();
     // load column of A (2 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::d));
 
@@ -333,8 +330,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM2N3Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m2n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m2n3_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -368,7 +364,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM3N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v5, gpr_t::x24, 0, neon_size_spec_t::s));
 
     // case_3_km1n3_loop:
-    kernel.add_label("k_m3n3_loop");
+    mini_jit::Kernel::label_t l_k_m3n3_loop = kernel.add_label();
     // load column of A (3 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v24, gpr_t::x24, 8, neon_size_spec_t::d));
@@ -399,8 +395,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM3N3Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m3n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m3n3_loop);
 
     // STORE MATRIX C (3 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -434,7 +429,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM4N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v2, gpr_t::x12, 0, neon_size_spec_t::q));
 
     // case_4_km1n3_loop:
-    kernel.add_label("k_m4n3_loop");
+    mini_jit::Kernel::label_t l_k_m4n3_loop = kernel.add_label();
     // load column of A (4 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     // B: COLUMN 0
@@ -459,8 +454,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM4N3Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m4n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m4n3_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -491,7 +485,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM5N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v5, gpr_t::x12, 16, neon_size_spec_t::s));
 
     // case_5_km1n3_loop:
-    kernel.add_label("k_m5n3_loop");
+    mini_jit::Kernel::label_t l_k_m5n3_loop = kernel.add_label();
     // load column of A (5 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v25, gpr_t::x15, 16, neon_size_spec_t::s));
@@ -521,8 +515,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM5N3Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m5n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m5n3_loop);
 
     // STORE MATRIX C (5 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -556,7 +549,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM6N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v5, gpr_t::x12, 16, neon_size_spec_t::d));
 
     // case_6_km1n3_loop:
-    kernel.add_label("k_m6n3_loop");
+    mini_jit::Kernel::label_t l_k_m6n3_loop = kernel.add_label();
     // load column of A (6 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v25, gpr_t::x15, 16, neon_size_spec_t::d));
@@ -586,8 +579,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM6N3Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m6n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m6n3_loop);
 
     // STORE MATRIX C (6 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -627,7 +619,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM7N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v8, gpr_t::x20, 0, neon_size_spec_t::s));
 
     // case_7_km1n3_loop:
-    kernel.add_label("k_m7n3_loop");
+    mini_jit::Kernel::label_t l_k_m7n3_loop = kernel.add_label();
     // load column of A (7 values)
     kernel.add_instr(base::mov(gpr_t::x20, gpr_t::x15));
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v24, gpr_t::x20, 16, neon_size_spec_t::q));
@@ -660,8 +652,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM7N3Loop(mini_jit:
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m7n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m7n3_loop);
 
     // STORE MATRIX C (7 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -698,7 +689,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM8N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v4, simd_fp_t::v5, gpr_t::x12, 0, neon_size_spec_t::q));
 
     // START K_LOOP
-    kernel.add_label("k_m8n3_loop");
+    mini_jit::Kernel::label_t l_k_m8n3_loop = kernel.add_label();
     //  Load column of A (8 values)
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x15, 0, neon_size_spec_t::q));
 
@@ -735,8 +726,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM8N3Loop(mini_jit:
 
     // END K_LOOP
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m8n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m8n3_loop);
 
     // Store Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -767,7 +757,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM9N3Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v12, gpr_t::x12, 32, neon_size_spec_t::s));
 
     // case_9_k_loop:
-    kernel.add_label("k_m9n3_loop");
+    mini_jit::Kernel::label_t l_k_m9n3_loop = kernel.add_label();
     // load column of A (9 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -799,8 +789,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM9N3Loop(mini_jit:
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m9n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m9n3_loop);
 
     // STORE MATRIX C (9 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -834,7 +823,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM10N3Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v12, gpr_t::x12, 32, neon_size_spec_t::d));
 
     // case_10_k_loop:
-    kernel.add_label("k_m10n3_loop");
+    mini_jit::Kernel::label_t l_k_m10n3_loop = kernel.add_label();
     // load column of A (10 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -866,8 +855,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM10N3Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m10n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m10n3_loop);
 
     // STORE MATRIX C (10 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -904,7 +892,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM11N3Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v13, gpr_t::x12, 40, neon_size_spec_t::s));
 
     // case_11_k_loop:
-    kernel.add_label("k_m11n3_loop");
+    mini_jit::Kernel::label_t l_k_m11n3_loop = kernel.add_label();
     // load column of A (11 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -940,8 +928,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM11N3Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m11n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m11n3_loop);
 
     // STORE MATRIX C (11 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -978,7 +965,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM12N3Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v12, gpr_t::x12, 32, neon_size_spec_t::q));
 
     // case_12_k_loop:
-    kernel.add_label("k_m12n3_loop");
+    mini_jit::Kernel::label_t l_k_m12n3_loop = kernel.add_label();
     // load column of A (12 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1010,8 +997,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM12N3Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m12n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m12n3_loop);
 
     // STORE MATRIX C (12 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -1048,7 +1034,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM13N3Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v13, gpr_t::x12, 48, neon_size_spec_t::s));
 
     // case_13_k_loop:
-    kernel.add_label("k_m13n3_loop");
+    mini_jit::Kernel::label_t l_k_m13n3_loop = kernel.add_label();
     // load column of A (13 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1084,8 +1070,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM13N3Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m13n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m13n3_loop);
 
     // STORE MATRIX C (13 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -1125,7 +1110,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM14N3Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v13, gpr_t::x12, 48, neon_size_spec_t::d));
 
     // case_14_k_loop:
-    kernel.add_label("k_m14n3_loop");
+    mini_jit::Kernel::label_t l_k_m14n3_loop = kernel.add_label();
     // load column of A (14 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1161,8 +1146,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM14N3Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m14n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m14n3_loop);
 
     // STORE MATRIX C (14 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -1205,7 +1189,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM15N3Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v14, gpr_t::x12, 56, neon_size_spec_t::s));
 
     // case_15_k_loop:
-    kernel.add_label("k_m15n3_loop");
+    mini_jit::Kernel::label_t l_k_m15n3_loop = kernel.add_label();
     // load column of A (15 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1245,8 +1229,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM15N3Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m15n3_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m15n3_loop);
 
     // STORE MATRIX C (15 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
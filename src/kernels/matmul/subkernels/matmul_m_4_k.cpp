@@ -144,7 +144,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N4Loop(mini_jit
     kernel.add_instr(base::mov(gpr_t::x11, mLoopIterations));
 
     // START M_LOOP
-    kernel.add_label("m16n4_loop");
+    mini_jit::Kernel::label_t l_m16n4_loop = kernel.add_label();
     // Load Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
     // first column
@@ -170,7 +170,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N4Loop(mini_jit
     kernel.add_instr(base::mov(gpr_t::x17, 0));         // Row index for Matrix B
 
     // START K_LOOP
-    kernel.add_label("k_m16n4_loop");
+    mini_jit::Kernel::label_t l_k_m16n4_loop = kernel.add_label();
     //  Load column of A (8 values)
     kernel.add_instr(base::mov(gpr_t::x13, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x13, 0, neon_size_spec_t::q));
@@ -225,8 +225,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N4Loop(mini_jit
 
     // END K_LOOP
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m16n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m16n4_loop);
 
     // Store Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -253,8 +252,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM16N4Loop(mini_jit
     // decrement M loop counter
     kernel.add_instr(base::sub(gpr_t::x11, gpr_t::x11, 1, 0));
 
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m16n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x11, -l_mLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x11, 0), l_m16n4_loop);
     // END M_LOOP
 }
 
@@ -275,7 +273,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM1N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x12, 0, neon_size_spec_t::s));
 
     // case_1_k_loop:
-    kernel.add_label("k_m1n4_loop");
+    mini_jit::Kernel::label_t l_k_m1n4_loop = kernel.add_label();
     // load column of A (1 value)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::s));
 
@@ -305,8 +303,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM1N4Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m1n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m1n4_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -340,7 +337,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM2N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x12, 0, neon_size_spec_t::d));
 
     // case_2_k_loop:
-    kernel.add_label("k_m2n4_loop");
+    mini_jit::Kernel::label_t l_k_m2n4_loop = kernel.add_label();
     // load column of A (2 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::d));
 
@@ -370,8 +367,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM2N4Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m2n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m2n4_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -413,7 +409,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM3N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v7, gpr_t::x24, 0, neon_size_spec_t::s));
 
     // case_3_k_loop:
-    kernel.add_label("k_m3n4_loop");
+    mini_jit::Kernel::label_t l_k_m3n4_loop = kernel.add_label();
     // load column of A (3 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldrPost(simd_fp_t::v24, gpr_t::x24, 8, neon_size_spec_t::d));
@@ -449,8 +445,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM3N4Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     //     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m3n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m3n4_loop);
 
     // STORE MATRIX C (3 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -492,7 +487,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM4N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v3, gpr_t::x12, 0, neon_size_spec_t::q));
 
     // case_4_k_loop:
-    kernel.add_label("k_m4n4_loop");
+    mini_jit::Kernel::label_t l_k_m4n4_loop = kernel.add_label();
     // load column of A (4 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     // B: COLUMN 0
@@ -521,8 +516,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM4N4Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m4n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m4n4_loop);
 
     // STORE MATRIX C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -560,7 +554,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM5N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v7, gpr_t::x12, 16, neon_size_spec_t::s));
 
     // case_5_k_loop:
-    kernel.add_label("k_m5n4_loop");
+    mini_jit::Kernel::label_t l_k_m5n4_loop = kernel.add_label();
     // load column of A (5 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v25, gpr_t::x15, 16, neon_size_spec_t::s));
@@ -595,8 +589,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM5N4Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m5n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m5n4_loop);
 
     // STORE MATRIX C (5 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -638,7 +631,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM6N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v7, gpr_t::x12, 16, neon_size_spec_t::d));
 
     // case_6_k_loop:
-    kernel.add_label("k_m6n4_loop");
+    mini_jit::Kernel::label_t l_k_m6n4_loop = kernel.add_label();
     // load column of A (6 values)
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x15, 0, neon_size_spec_t::q));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v25, gpr_t::x15, 16, neon_size_spec_t::d));
@@ -673,8 +666,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM6N4Loop(mini_jit:
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
     // check if loop counter is zero
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m6n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m6n4_loop);
 
     // STORE MATRIX C (6 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -724,7 +716,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM7N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v11, gpr_t::x24, 24, neon_size_spec_t::s));
 
     // case_7_k_loop:
-    kernel.add_label("k_m7n4_loop");
+    mini_jit::Kernel::label_t l_k_m7n4_loop = kernel.add_label();
     // load column of A (7 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v24, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -763,8 +755,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM7N4Loop(mini_jit:
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m7n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m7n4_loop);
 
     // STORE MATRIX C (7 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -810,7 +801,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM8N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v6, simd_fp_t::v7, gpr_t::x12, 0, neon_size_spec_t::q));
 
     // START K_LOOP
-    kernel.add_label("k_m8n4_loop");
+    mini_jit::Kernel::label_t l_k_m8n4_loop = kernel.add_label();
     //  Load column of A (8 values)
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x15, 0, neon_size_spec_t::q));
 
@@ -855,8 +846,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM8N4Loop(mini_jit:
 
     // END K_LOOP
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m8n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m8n4_loop);
 
     // Store Matrix C
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -894,7 +884,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM9N4Loop(mini_jit:
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v17, gpr_t::x12, 32, neon_size_spec_t::s));
 
     // case_9_k_loop:
-    kernel.add_label("k_m9n4_loop");
+    mini_jit::Kernel::label_t l_k_m9n4_loop = kernel.add_label();
     // load column of A (9 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -932,8 +922,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM9N4Loop(mini_jit:
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m9n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m9n4_loop);
 
     // STORE MATRIX C (9 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -975,7 +964,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM10N4Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v17, gpr_t::x12, 32, neon_size_spec_t::d));
 
     // case_10_k_loop:
-    kernel.add_label("k_m10n4_loop");
+    mini_jit::Kernel::label_t l_k_m10n4_loop = kernel.add_label();
     // load column of A (10 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1013,8 +1002,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM10N4Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m10n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m10n4_loop);
 
     // STORE MATRIX C (10 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -1060,7 +1048,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM11N4Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v18, gpr_t::x12, 40, neon_size_spec_t::s));
 
     // case_11_k_loop:
-    kernel.add_label("k_m11n4_loop");
+    mini_jit::Kernel::label_t l_k_m11n4_loop = kernel.add_label();
     // load column of A (11 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1103,8 +1091,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM11N4Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m11n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m11n4_loop);
 
     // STORE MATRIX C (11 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -1150,7 +1137,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM12N4Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v17, gpr_t::x12, 32, neon_size_spec_t::q));
 
     // case_12_k_loop:
-    kernel.add_label("k_m12n4_loop");
+    mini_jit::Kernel::label_t l_k_m12n4_loop = kernel.add_label();
     // load column of A (12 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1188,8 +1175,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM12N4Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m12n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m12n4_loop);
 
     // STORE MATRIX C (12 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -1235,7 +1221,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM13N4Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v18, gpr_t::x12, 48, neon_size_spec_t::s));
 
     // case_13_k_loop:
-    kernel.add_label("k_m13n4_loop");
+    mini_jit::Kernel::label_t l_k_m13n4_loop = kernel.add_label();
     // load column of A (13 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1278,8 +1264,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM13N4Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m13n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m13n4_loop);
 
     // STORE MATRIX C (13 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -1329,7 +1314,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM14N4Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v18, gpr_t::x12, 48, neon_size_spec_t::d));
 
     // case_14_k_loop:
-    kernel.add_label("k_m14n4_loop");
+    mini_jit::Kernel::label_t l_k_m14n4_loop = kernel.add_label();
     // load column of A (14 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1372,8 +1357,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM14N4Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m14n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m14n4_loop);
 
     // STORE MATRIX C (14 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
@@ -1427,7 +1411,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM15N4Loop(mini_jit
     kernel.add_instr(simd_fp::ldr(simd_fp_t::v19, gpr_t::x12, 56, neon_size_spec_t::s));
 
     // case_15_k_loop:
-    kernel.add_label("k_m15n4_loop");
+    mini_jit::Kernel::label_t l_k_m15n4_loop = kernel.add_label();
     // load column of A (15 values)
     kernel.add_instr(base::mov(gpr_t::x24, gpr_t::x15));
     kernel.add_instr(simd_fp::ldp(simd_fp_t::v24, simd_fp_t::v25, gpr_t::x24, 0, neon_size_spec_t::q));
@@ -1475,8 +1459,7 @@ void mini_jit::kernels::matmul::subkernels::internal::generateM15N4Loop(mini_jit
 
     // decrement loop counter
     kernel.add_instr(base::sub(gpr_t::x14, gpr_t::x14, 1, 0));
-    int l_kLoopInstrCount = kernel.getInstrCountFromLabel("k_m15n4_loop");
-    kernel.add_instr(base::cbnz(gpr_t::x14, -l_kLoopInstrCount * 4));
+    kernel.add_branch(base::cbnz(gpr_t::x14, 0), l_k_m15n4_loop);
 
     // STORE MATRIX C (15 values)
     kernel.add_instr(base::mov(gpr_t::x12, gpr_t::x10));
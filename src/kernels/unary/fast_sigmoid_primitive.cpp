@@ -51,7 +51,7 @@ void mini_jit::kernels::unary::fast_sigmoid(mini_jit::Kernel& kernel,
                       mov(x6, n)});
 
     // Start n loop (1 column)
-    kernel.add_label("n_loop");
+    mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
     // Set m loop counter
     kernel.add_instr({
@@ -64,7 +64,7 @@ void mini_jit::kernels::unary::fast_sigmoid(mini_jit::Kernel& kernel,
 
     if (mLoopIterations > 0)
     {
-        kernel.add_label("m_16_loop");
+        mini_jit::Kernel::label_t l_m_16_loop = kernel.add_label();
         kernel.add_instr({
             // load 16 elements from A
             ldp(v0, v1, x8, 0, q),
@@ -116,7 +116,7 @@ void mini_jit::kernels::unary::fast_sigmoid(mini_jit::Kernel& kernel,
             sub(x7, x7, 1, 0),
         });
         // check if loop counter is zero
-        kernel.add_instr(cbnz(x7, -kernel.getInstrCountFromLabel("m_16_loop") * 4));
+        kernel.add_branch(cbnz(x7, 0), l_m_16_loop);
     }
 
     if (mLoopRemainder > 0)
@@ -542,8 +542,7 @@ void mini_jit::kernels::unary::fast_sigmoid(mini_jit::Kernel& kernel,
                       // decrement n loop counter
                       sub(x6, x6, 1, 0)});
     // check if loop counter is zero
-    int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-    kernel.add_instr(cbnz(x6, -l_nLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_n_loop);
 
     kernel.add_instr({// Restore callee-saved registers
                       ldpPost(v10, v11, sp, 16, d),
@@ -45,7 +45,7 @@ void mini_jit::kernels::unary::relu(mini_jit::Kernel& kernel,
     kernel.add_instr(zero(v31, b16));
 
     // Start n loop (1 column)
-    kernel.add_label("n_loop");
+    mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
     // Set m loop counter
     kernel.add_instr(mov(x7, mLoopIterations));
@@ -56,7 +56,7 @@ void mini_jit::kernels::unary::relu(mini_jit::Kernel& kernel,
 
     if (mLoopIterations > 0)
     {
-        kernel.add_label("m_8_loop");
+        mini_jit::Kernel::label_t l_m_8_loop = kernel.add_label();
         kernel.add_instr({
             // load 8 elements from A
             ldp(v0, v1, x8, 0, q),
@@ -72,7 +72,7 @@ void mini_jit::kernels::unary::relu(mini_jit::Kernel& kernel,
             sub(x7, x7, 1, 0),
         });
         // check if loop counter is zero
-        kernel.add_instr(cbnz(x7, -kernel.getInstrCountFromLabel("m_8_loop") * 4));
+        kernel.add_branch(cbnz(x7, 0), l_m_8_loop);
     }
 
     if (mLoopRemainder > 0)
@@ -149,8 +149,7 @@ void mini_jit::kernels::unary::relu(mini_jit::Kernel& kernel,
     // decrement n loop counter
     kernel.add_instr(sub(x6, x6, 1, 0));
     // check if loop counter is zero
-    int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-    kernel.add_instr(cbnz(x6, -l_nLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_n_loop);
 
     // Restore stack pointer
     kernel.add_instr(ldpPost(x29, x30, sp, 16));
@@ -68,7 +68,7 @@ void mini_jit::kernels::unary::relu_trans(mini_jit::Kernel& kernel,
     if (nLoopIterations > 0)
     {
         // Start n loop (1 column)
-        kernel.add_label("n_loop");
+        mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
         if (mLoopIterations > 0)
         {
@@ -110,8 +110,7 @@ void mini_jit::kernels::unary::relu_trans(mini_jit::Kernel& kernel,
         // decrement n loop counter
         kernel.add_instr(sub(x9, x9, 1, 0));
         // check if loop counter is zero
-        int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-        kernel.add_instr(cbnz(x9, -l_nLoopInstrCount * 4));
+        kernel.add_branch(cbnz(x9, 0), l_n_loop);
     }
 
     // All iterations in the n dimension have been performed, only possibilities are now:
@@ -210,7 +209,7 @@ void mini_jit::kernels::unary::internal::reluM4N4(mini_jit::Kernel& kernel,
 {
     kernel.add_instr(mov(x6, mLoopIterations));
 
-    kernel.add_label("m_4_n_4_loop");
+    mini_jit::Kernel::label_t l_m_4_n_4_loop = kernel.add_label();
 
     // working pointer for A and B
     kernel.add_instr(mov(x7, x4));
@@ -263,8 +262,7 @@ void mini_jit::kernels::unary::internal::reluM4N4(mini_jit::Kernel& kernel,
     // decrement m loop counter
     kernel.add_instr(sub(x6, x6, 1, 0));
     // check if loop counter is zero
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_4_n_4_loop");
-    kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_m_4_n_4_loop);
 }
 
 void mini_jit::kernels::unary::internal::reluM3N4(mini_jit::Kernel& kernel)
@@ -419,7 +417,7 @@ void mini_jit::kernels::unary::internal::reluM4N3(mini_jit::Kernel& kernel,
                                                   int               mLoopIterations)
 {
     kernel.add_instr(mov(x6, mLoopIterations));
-    kernel.add_label("m_4_n_3_loop");
+    mini_jit::Kernel::label_t l_m_4_n_3_loop = kernel.add_label();
 
     // working pointer for A and B
     kernel.add_instr(mov(x7, x4));
@@ -492,15 +490,14 @@ void mini_jit::kernels::unary::internal::reluM4N3(mini_jit::Kernel& kernel,
     // decrement m loop counter
     kernel.add_instr(sub(x6, x6, 1, 0));
     // check if loop counter is zero
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_4_n_3_loop");
-    kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_m_4_n_3_loop);
 }
 
 void mini_jit::kernels::unary::internal::reluM4N2(mini_jit::Kernel& kernel,
                                                   int               mLoopIterations)
 {
     kernel.add_instr(mov(x6, mLoopIterations));
-    kernel.add_label("m_4_n_2_loop");
+    mini_jit::Kernel::label_t l_m_4_n_2_loop = kernel.add_label();
 
     // working pointer for A and B
     kernel.add_instr(mov(x7, x4));
@@ -551,15 +548,14 @@ void mini_jit::kernels::unary::internal::reluM4N2(mini_jit::Kernel& kernel,
     // decrement m loop counter
     kernel.add_instr(sub(x6, x6, 1, 0));
     // check if loop counter is zero
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_4_n_2_loop");
-    kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_m_4_n_2_loop);
 }
 
 void mini_jit::kernels::unary::internal::reluM4N1(mini_jit::Kernel& kernel,
                                                   int               mLoopIterations)
 {
     kernel.add_instr(mov(x6, mLoopIterations));
-    kernel.add_label("m_4_n_1_loop");
+    mini_jit::Kernel::label_t l_m_4_n_1_loop = kernel.add_label();
 
     // working pointer for A and B
     kernel.add_instr(mov(x7, x4));
@@ -599,8 +595,7 @@ void mini_jit::kernels::unary::internal::reluM4N1(mini_jit::Kernel& kernel,
     // decrement m loop counter
     kernel.add_instr(sub(x6, x6, 1, 0));
     // check if loop counter is zero
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_4_n_1_loop");
-    kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_m_4_n_1_loop);
 }
 
 void mini_jit::kernels::unary::internal::reluM3N3(mini_jit::Kernel& kernel)
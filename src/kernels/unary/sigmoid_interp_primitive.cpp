@@ -52,7 +52,7 @@ void mini_jit::kernels::unary::sigmoid_interpolation(mini_jit::Kernel& kernel,
     });
 
     // Start n loop (1 column)
-    kernel.add_label("n_loop");
+    mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
     // Set m loop counter
     kernel.add_instr({
@@ -65,7 +65,7 @@ void mini_jit::kernels::unary::sigmoid_interpolation(mini_jit::Kernel& kernel,
 
     if (mLoopIterations > 0)
     {
-        kernel.add_label("m_16_loop");
+        mini_jit::Kernel::label_t l_m_16_loop = kernel.add_label();
         kernel.add_instr({
             // Load 4 elements
             ldr(v0, x16, 0, q),
@@ -146,7 +146,7 @@ void mini_jit::kernels::unary::sigmoid_interpolation(mini_jit::Kernel& kernel,
         });
 
         // Check if loop counter is zero
-        kernel.add_instr(cbnz(x8, -kernel.getInstrCountFromLabel("m_16_loop") * 4));
+        kernel.add_branch(cbnz(x8, 0), l_m_16_loop);
     }
 
     // Handle remainder elements if needed
@@ -354,8 +354,7 @@ void mini_jit::kernels::unary::sigmoid_interpolation(mini_jit::Kernel& kernel,
                       sub(x7, x7, 1, 0)});
 
     // Check if loop counter is zero
-    int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-    kernel.add_instr(cbnz(x7, -l_nLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x7, 0), l_n_loop);
 
     kernel.add_instr({// Restore stack pointer
                       ldpPost(x29, x30, sp, 16),
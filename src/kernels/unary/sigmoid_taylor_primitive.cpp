@@ -55,7 +55,7 @@ void mini_jit::kernels::unary::sigmoid_taylor(mini_jit::Kernel& kernel,
     });
 
     // Start n loop (1 column)
-    kernel.add_label("n_loop");
+    mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
     // Set m loop counter
     kernel.add_instr({
@@ -68,7 +68,7 @@ void mini_jit::kernels::unary::sigmoid_taylor(mini_jit::Kernel& kernel,
 
     if (mLoopIterations > 0)
     {
-        kernel.add_label("m_16_loop");
+        mini_jit::Kernel::label_t l_m_16_loop = kernel.add_label();
         kernel.add_instr({
             // Load 16 elements from A
             ldp(v0, v1, x9, 0, q),
@@ -142,7 +142,7 @@ void mini_jit::kernels::unary::sigmoid_taylor(mini_jit::Kernel& kernel,
         });
 
         // Check if loop counter is zero
-        kernel.add_instr(cbnz(x8, -kernel.getInstrCountFromLabel("m_16_loop") * 4));
+        kernel.add_branch(cbnz(x8, 0), l_m_16_loop);
     }
 
     if (mLoopRemainder > 0)
@@ -1129,8 +1129,7 @@ void mini_jit::kernels::unary::sigmoid_taylor(mini_jit::Kernel& kernel,
                       sub(x7, x7, 1, 0)});
 
     // Check if loop counter is zero
-    int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-    kernel.add_instr(cbnz(x7, -l_nLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x7, 0), l_n_loop);
 
     kernel.add_instr({// Restore callee-saved registers
                       ldpPost(v14, v15, sp, 16, d),
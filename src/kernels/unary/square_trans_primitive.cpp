@@ -67,7 +67,7 @@ void mini_jit::kernels::unary::square_trans(mini_jit::Kernel& kernel,
     if (nLoopIterations > 0)
     {
         // Start n loop (1 column)
-        kernel.add_label("n_loop");
+        mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
         if (mLoopIterations > 0)
         {
@@ -110,8 +110,7 @@ void mini_jit::kernels::unary::square_trans(mini_jit::Kernel& kernel,
                           sub(x9, x9, 1, 0)});
 
         // check if loop counter is zero
-        int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-        kernel.add_instr(cbnz(x9, -l_nLoopInstrCount * 4));
+        kernel.add_branch(cbnz(x9, 0), l_n_loop);
     }
 
     // All iterations in the n dimension have been performed, only possibilities are now:
@@ -211,7 +210,7 @@ void mini_jit::kernels::unary::internal::squareM4N4(mini_jit::Kernel& kernel,
 {
     kernel.add_instr(mov(x6, mLoopIterations));
 
-    kernel.add_label("m_4_n_4_loop");
+    mini_jit::Kernel::label_t l_m_4_n_4_loop = kernel.add_label();
 
     kernel.add_instr({// working pointer for A and B
                       mov(x7, x4),
@@ -265,8 +264,7 @@ void mini_jit::kernels::unary::internal::squareM4N4(mini_jit::Kernel& kernel,
                       sub(x6, x6, 1, 0)});
 
     // check if loop counter is zero
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_4_n_4_loop");
-    kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_m_4_n_4_loop);
 }
 
 void mini_jit::kernels::unary::internal::squareM3N4(mini_jit::Kernel& kernel)
@@ -418,7 +416,7 @@ void mini_jit::kernels::unary::internal::squareM4N3(mini_jit::Kernel& kernel,
                                                     int               mLoopIterations)
 {
     kernel.add_instr(mov(x6, mLoopIterations));
-    kernel.add_label("m_4_n_3_loop");
+    mini_jit::Kernel::label_t l_m_4_n_3_loop = kernel.add_label();
 
     kernel.add_instr({// working pointer for A and B
                       mov(x7, x4),
@@ -490,15 +488,14 @@ void mini_jit::kernels::unary::internal::squareM4N3(mini_jit::Kernel& kernel,
                       sub(x6, x6, 1, 0)});
 
     // check if loop counter is zero
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_4_n_3_loop");
-    kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_m_4_n_3_loop);
 }
 
 void mini_jit::kernels::unary::internal::squareM4N2(mini_jit::Kernel& kernel,
                                                     int               mLoopIterations)
 {
     kernel.add_instr(mov(x6, mLoopIterations));
-    kernel.add_label("m_4_n_2_loop");
+    mini_jit::Kernel::label_t l_m_4_n_2_loop = kernel.add_label();
 
     kernel.add_instr({// working pointer for A and B
                       mov(x7, x4),
@@ -550,15 +547,14 @@ void mini_jit::kernels::unary::internal::squareM4N2(mini_jit::Kernel& kernel,
                       sub(x6, x6, 1, 0)});
 
     // check if loop counter is zero
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_4_n_2_loop");
-    kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_m_4_n_2_loop);
 }
 
 void mini_jit::kernels::unary::internal::squareM4N1(mini_jit::Kernel& kernel,
                                                     int               mLoopIterations)
 {
     kernel.add_instr(mov(x6, mLoopIterations));
-    kernel.add_label("m_4_n_1_loop");
+    mini_jit::Kernel::label_t l_m_4_n_1_loop = kernel.add_label();
 
     kernel.add_instr({// working pointer for A and B
                       mov(x7, x4),
@@ -599,8 +595,7 @@ void mini_jit::kernels::unary::internal::squareM4N1(mini_jit::Kernel& kernel,
                       sub(x6, x6, 1, 0)});
 
     // check if loop counter is zero
-    int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_4_n_1_loop");
-    kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x6, 0), l_m_4_n_1_loop);
 }
 
 void mini_jit::kernels::unary::internal::squareM3N3(mini_jit::Kernel& kernel)
@@ -43,7 +43,7 @@ void mini_jit::kernels::unary::zero_xzr(mini_jit::Kernel& kernel,
     kernel.add_instr(mov(x5, n));
 
     // Start n loop (1 column)
-    kernel.add_label("n_loop");
+    mini_jit::Kernel::label_t l_n_loop = kernel.add_label();
 
     kernel.add_instr(mov(x6, mLoopIterations));
     // working pointer for B (rows)
@@ -51,7 +51,7 @@ void mini_jit::kernels::unary::zero_xzr(mini_jit::Kernel& kernel,
 
     if (mLoopIterations > 0)
     {
-        kernel.add_label("m_8_loop");
+        mini_jit::Kernel::label_t l_m_8_loop = kernel.add_label();
         // store 8 zeros
         kernel.add_instr(mov(x8, x7));
         kernel.add_instr(strPost(xzr, x8, 8));
@@ -64,8 +64,7 @@ void mini_jit::kernels::unary::zero_xzr(mini_jit::Kernel& kernel,
         // decrement m loop counter
         kernel.add_instr(sub(x6, x6, 1, 0));
         // check if loop counter is zero
-        int l_mLoopInstrCount = kernel.getInstrCountFromLabel("m_8_loop");
-        kernel.add_instr(cbnz(x6, -l_mLoopInstrCount * 4));
+        kernel.add_branch(cbnz(x6, 0), l_m_8_loop);
     }
 
     if (mLoopRemainder > 0)
@@ -112,8 +111,7 @@ void mini_jit::kernels::unary::zero_xzr(mini_jit::Kernel& kernel,
     // decrement n loop counter
     kernel.add_instr(sub(x5, x5, 1, 0));
     // check if loop counter is zero
-    int l_nLoopInstrCount = kernel.getInstrCountFromLabel("n_loop");
-    kernel.add_instr(cbnz(x5, -l_nLoopInstrCount * 4));
+    kernel.add_branch(cbnz(x5, 0), l_n_loop);
 
     // Restore stack pointer
     kernel.add_instr(ldpPost(x29, x30, sp, 16));
@@ -0,0 +1,65 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstring>
+#include <mlc/Kernel.h>
+#include <mlc/instructions/base/cbnz.h>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Test Kernel labels", "[kernel]")
+{
+    mini_jit::Kernel kernel;
+    kernel.add_instr(0xd503201f); // nop
+    kernel.add_label("loop");
+    REQUIRE(kernel.getInstrCountFromLabel("loop") == 0);
+
+    kernel.add_instr(0xd503201f);
+    kernel.add_label("inner");
+
+    std::vector<uint32_t> l_instrs = {0xd503201f, 0xd503201f, 0xd503201f};
+    kernel.add_instr(l_instrs);
+    REQUIRE(kernel.getInstrCountFromLabel("loop") == 4);
+    REQUIRE(kernel.getInstrCountFromLabel("inner") == 3);
+    REQUIRE(kernel.get_size() == 5 * 4);
+
+    REQUIRE_THROWS_AS(kernel.add_label("loop"), std::runtime_error);
+    REQUIRE_THROWS_AS(kernel.getInstrCountFromLabel("missing"), std::runtime_error);
+}
+
+TEST_CASE("Test Kernel label handles", "[kernel]")
+{
+    mini_jit::Kernel kernel;
+
+    // backward branch of a loop
+    mini_jit::Kernel::label_t l_loop = kernel.add_label();
+    kernel.add_instr(0xd503201f); // nop
+    kernel.add_instr(0xd503201f);
+    kernel.add_branch(mini_jit::instructions::base::cbnz(gpr_t::x9, 0), l_loop);
+
+    // forward branches are patched when the label is bound
+    mini_jit::Kernel::label_t l_end = kernel.new_label();
+    kernel.add_branch(0x14000000, l_end);                   // b
+    kernel.add_branch(0x54000000, l_end);                   // b.eq
+    kernel.add_branch(0x36000000 | (3 << 19) | 2, l_end);   // tbz w2, #3
+    REQUIRE_THROWS_AS(kernel.set_kernel(), std::runtime_error);
+    kernel.add_instr(0xd503201f);
+    kernel.bind(l_end);
+    kernel.add_instr(0xd65f03c0); // ret
+
+    std::vector<uint32_t> l_code(kernel.get_size() / 4);
+    kernel.set_kernel();
+    std::memcpy(l_code.data(), kernel.get_kernel(), kernel.get_size());
+
+    // cbnz x9, #-8
+    REQUIRE(l_code[2] == mini_jit::instructions::base::cbnz(gpr_t::x9, -8));
+    REQUIRE(l_code[2] == 0xb5ffffc9);
+    // b #16, b.eq #12, tbz w2, #3, #8
+    REQUIRE(l_code[3] == 0x14000004);
+    REQUIRE(l_code[4] == 0x54000060);
+    REQUIRE(l_code[5] == 0x36180042);
+
+    REQUIRE_THROWS_AS(kernel.bind(l_end), std::invalid_argument);
+    REQUIRE_THROWS_AS(kernel.bind(42), std::invalid_argument);
+    REQUIRE_THROWS_AS(kernel.add_branch(0xd503201f, l_loop), std::invalid_argument);
+    REQUIRE(kernel.get_size() == 8 * 4);
+}
@@ -0,0 +1,267 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstring>
+#include <mlc/Brgemm.h>
+#include <mlc/Binary.h>
+#include <mlc/Kernel.h>
+#include <mlc/Peephole.h>
+#include <mlc/Unary.h>
+#include <mlc/instructions/base/cbnz.h>
+#include <mlc/types.h>
+#include <stdexcept>
+#include <vector>
+
+using Peephole = mini_jit::Peephole;
+
+namespace
+{
+    std::vector<uint32_t> get_code(void const* kernel,
+                                   std::size_t size)
+    {
+        std::vector<uint32_t> l_code(size / 4);
+        std::memcpy(l_code.data(), kernel, size);
+        return l_code;
+    }
+
+    void require_decoded(std::vector<uint32_t> const& code)
+    {
+        for (uint32_t l_ins : code)
+        {
+            INFO("instruction 0x" << std::hex << l_ins);
+            REQUIRE(Peephole::decode(l_ins).kind != Peephole::instr_kind_t::unknown);
+        }
+    }
+} // namespace
+
+TEST_CASE("Test Peephole decode", "[peephole]")
+{
+    uint64_t l_x0  = uint64_t(1) << Peephole::reg_id(Peephole::reg_class_t::gpr, 0);
+    uint64_t l_x1  = uint64_t(1) << Peephole::reg_id(Peephole::reg_class_t::gpr, 1);
+    uint64_t l_x19 = uint64_t(1) << Peephole::reg_id(Peephole::reg_class_t::gpr, 19);
+    uint64_t l_x20 = uint64_t(1) << Peephole::reg_id(Peephole::reg_class_t::gpr, 20);
+    uint64_t l_sp  = uint64_t(1) << 31;
+    uint64_t l_v0  = uint64_t(1) << Peephole::reg_id(Peephole::reg_class_t::simd, 0);
+    uint64_t l_v1  = uint64_t(1) << Peephole::reg_id(Peephole::reg_class_t::simd, 1);
+
+    // mov x20, x1
+    Peephole::instr_t l_instr = Peephole::decode(0xaa0103f4);
+    REQUIRE(l_instr.kind == Peephole::instr_kind_t::alu);
+    REQUIRE(l_instr.reads() == l_x1);
+    REQUIRE(l_instr.writes() == l_x20);
+
+    // ldr q1, [x0, #16]
+    l_instr = Peephole::decode(0x3dc00401);
+    REQUIRE(l_instr.kind == Peephole::instr_kind_t::load);
+    REQUIRE(l_instr.reads() == l_x0);
+    REQUIRE(l_instr.writes() == l_v1);
+
+    // fadd v0.4s, v0.4s, v1.4s
+    l_instr = Peephole::decode(0x4e21d400);
+    REQUIRE(l_instr.kind == Peephole::instr_kind_t::alu);
+    REQUIRE(l_instr.reads() == (l_v0 | l_v1));
+    REQUIRE(l_instr.writes() == l_v0);
+
+    // stp x19, x20, [sp, #-16]!
+    l_instr = Peephole::decode(0xa9bf53f3);
+    REQUIRE(l_instr.kind == Peephole::instr_kind_t::store);
+    REQUIRE(l_instr.reads() == (l_x19 | l_x20 | l_sp));
+    REQUIRE(l_instr.writes() == l_sp);
+
+    // cbnz x19, #-16 and ret
+    REQUIRE(Peephole::decode(0xb5ffff93).kind == Peephole::instr_kind_t::branch);
+    REQUIRE(Peephole::decode(0xd65f03c0).kind == Peephole::instr_kind_t::ret);
+
+    // indirect branches are not emitted by the generators
+    REQUIRE(Peephole::decode(0xd61f0100).kind == Peephole::instr_kind_t::unknown);
+
+    int64_t l_offset = 0;
+    REQUIRE(Peephole::get_branch_offset(0xb5ffff93, l_offset));
+    REQUIRE(l_offset == -4);
+    REQUIRE(Peephole::set_branch_offset(0xb5ffff93, 3) == 0xb5000073);
+    REQUIRE_FALSE(Peephole::get_branch_offset(0xd65f03c0, l_offset));
+    REQUIRE_THROWS_AS(Peephole::set_branch_offset(0xd65f03c0, 3), std::invalid_argument);
+    REQUIRE_THROWS_AS(Peephole::set_branch_offset(0x54000000, int64_t(1) << 20), std::invalid_argument);
+}
+
+TEST_CASE("Test Peephole decodes generated kernels", "[peephole]")
+{
+    mini_jit::Brgemm l_brgemm;
+    REQUIRE(l_brgemm.generate(16, 6, 4, 2, 0, 0, 0, mini_jit::dtype_t::fp32) == mini_jit::error_t::success);
+    require_decoded(get_code(reinterpret_cast<void const*>(l_brgemm.get_kernel()), l_brgemm.get_code_size()));
+
+    for (mini_jit::ptype_t l_ptype : {mini_jit::ptype_t::zero,
+                                      mini_jit::ptype_t::identity,
+                                      mini_jit::ptype_t::relu,
+                                      mini_jit::ptype_t::reciprocal,
+                                      mini_jit::ptype_t::fast_sigmoid,
+                                      mini_jit::ptype_t::sigmoid_interp,
+                                      mini_jit::ptype_t::sigmoid_taylor})
+    {
+        mini_jit::Unary l_unary;
+        REQUIRE(l_unary.generate(13, 5, 0, mini_jit::dtype_t::fp32, l_ptype) == mini_jit::error_t::success);
+        require_decoded(get_code(reinterpret_cast<void const*>(l_unary.get_kernel()), l_unary.get_code_size()));
+    }
+
+    mini_jit::Unary l_trans;
+    REQUIRE(l_trans.generate(7, 5, 1, mini_jit::dtype_t::fp32, mini_jit::ptype_t::identity) == mini_jit::error_t::success);
+    require_decoded(get_code(reinterpret_cast<void const*>(l_trans.get_kernel()), l_trans.get_code_size()));
+
+    mini_jit::Binary l_binary;
+    REQUIRE(l_binary.generate(13, 5, 0, mini_jit::dtype_t::fp32, mini_jit::ptype_t::add) == mini_jit::error_t::success);
+    require_decoded(get_code(reinterpret_cast<void const*>(l_binary.get_kernel()), l_binary.get_code_size()));
+}
+
+TEST_CASE("Test Peephole spills and moves", "[peephole]")
+{
+    std::vector<uint32_t> l_code = {
+        0xa9bf7bfd,                                               //  0: stp x29, x30, [sp, #-16]!
+        0x910003fd,                                               //  1: mov x29, sp
+        0xa9bf53f3,                                               //  2: stp x19, x20, [sp, #-16]!
+        0x6dbf27e8,                                               //  3: stp d8, d9, [sp, #-16]!
+        0xaa0103f4,                                               //  4: mov x20, x1
+        0xd2800093,                                               //  5: mov x19, #4
+        0x3dc00280,                                               //  6: ldr q0, [x20]
+        0x3dc00401,                                               //  7: ldr q1, [x0, #16]
+        0x4e21d400,                                               //  8: fadd v0.4s, v0.4s, v1.4s
+        0x3d800040,                                               //  9: str q0, [x2]
+        0xd1000673,                                               // 10: sub x19, x19, #1
+        mini_jit::instructions::base::cbnz(gpr_t::x19, -5 * 4),   // 11: cbnz x19, 6
+        0x6cc127e8,                                               // 12: ldp d8, d9, [sp], #16
+        0xa8c153f3,                                               // 13: ldp x19, x20, [sp], #16
+        0xa8c17bfd,                                               // 14: ldp x29, x30, [sp], #16
+        0xd65f03c0                                                // 15: ret
+    };
+
+    std::vector<std::size_t> l_positions;
+    Peephole::stats_t        l_stats = Peephole::optimize(l_code, &l_positions);
+    REQUIRE(l_stats.analyzed);
+    REQUIRE(l_stats.removed_moves == 1);
+    REQUIRE(l_stats.removed_spills == 2);
+    REQUIRE(l_stats.hoisted_loads == 0);
+
+    // the copy of x1 is propagated, the save and restore of d8 and d9 is dropped
+    std::vector<uint32_t> l_expected = {
+        0xa9bf7bfd,
+        0x910003fd,
+        0xa9bf53f3,
+        0xd2800093,
+        0x3dc00020, // ldr q0, [x1]
+        0x3dc00401,
+        0x4e21d400,
+        0x3d800040,
+        0xd1000673,
+        mini_jit::instructions::base::cbnz(gpr_t::x19, -5 * 4),
+        0xa8c153f3,
+        0xa8c17bfd,
+        0xd65f03c0
+    };
+    REQUIRE(l_code == l_expected);
+
+    REQUIRE(l_positions.size() == 17);
+    REQUIRE(l_positions[3] == 3);
+    REQUIRE(l_positions[4] == 3);
+    REQUIRE(l_positions[6] == 4);
+    REQUIRE(l_positions[11] == 9);
+    REQUIRE(l_positions[12] == 10);
+    REQUIRE(l_positions[16] == 13);
+}
+
+TEST_CASE("Test Peephole self and dead moves", "[peephole]")
+{
+    std::vector<uint32_t> l_code = {
+        0xaa0303e3, // mov x3, x3
+        0xaa0403e9, // mov x9, x4
+        0x3dc00060, // ldr q0, [x3]
+        0x3d800040, // str q0, [x2]
+        0xd65f03c0  // ret
+    };
+
+    Peephole::stats_t l_stats = Peephole::optimize(l_code);
+    REQUIRE(l_stats.removed_moves == 2);
+    REQUIRE(l_code == std::vector<uint32_t>{0x3dc00060, 0x3d800040, 0xd65f03c0});
+}
+
+TEST_CASE("Test Peephole load scheduling", "[peephole]")
+{
+    SECTION("independent loads are hoisted")
+    {
+        std::vector<uint32_t> l_code = {
+            0x3dc00401, // ldr q1, [x0, #16]
+            0x6e24dc62, // fmul v2.4s, v3.4s, v4.4s
+            0x910020a5, // add x5, x5, #8
+            0x3dc000c6, // ldr q6, [x6]
+            0x4e22cc20, // fmla v0.4s, v1.4s, v2.4s
+            0x3d800040, // str q0, [x2]
+            0xd65f03c0  // ret
+        };
+
+        Peephole::stats_t l_stats = Peephole::optimize(l_code);
+        REQUIRE(l_stats.hoisted_loads == 1);
+        REQUIRE(l_code == std::vector<uint32_t>{0x3dc00401, 0x3dc000c6, 0x6e24dc62, 0x910020a5, 0x4e22cc20, 0x3d800040, 0xd65f03c0});
+    }
+
+    SECTION("loads stay behind dependencies, stores and branch targets")
+    {
+        std::vector<uint32_t> l_code = {
+            0x910020a5, // add x5, x5, #8
+            0x3dc000a5, // ldr q5, [x5]
+            0x3d800040, // str q0, [x2]
+            0x6e24dc62, // fmul v2.4s, v3.4s, v4.4s
+            0x3dc000c3, // ldr q3, [x6]
+            0x3d800042, // str q2, [x2]
+            0xd1000673, // sub x19, x19, #1
+            0x3dc000c6, // ldr q6, [x6]
+            0xd1000673, // sub x19, x19, #1
+            mini_jit::instructions::base::cbnz(gpr_t::x19, -2 * 4),
+            0xd65f03c0  // ret
+        };
+        std::vector<uint32_t> l_original = l_code;
+
+        Peephole::stats_t l_stats = Peephole::optimize(l_code);
+        REQUIRE(l_stats.analyzed);
+        REQUIRE(l_stats.hoisted_loads == 0);
+        REQUIRE(l_code == l_original);
+    }
+}
+
+TEST_CASE("Test Peephole unknown instructions", "[peephole]")
+{
+    std::vector<uint32_t> l_code = {
+        0xaa0303e3, // mov x3, x3
+        0xd61f0100, // br x8
+        0xd65f03c0  // ret
+    };
+    std::vector<uint32_t> l_original = l_code;
+
+    Peephole::stats_t l_stats = Peephole::optimize(l_code);
+    REQUIRE_FALSE(l_stats.analyzed);
+    REQUIRE(l_stats.removed_moves == 0);
+    REQUIRE(l_code == l_original);
+}
+
+TEST_CASE("Test Kernel peephole optimization", "[peephole]")
+{
+    std::vector<uint32_t> l_instrs = {
+        0xaa0403e9, // mov x9, x4
+        0x3d800040, // str q0, [x2]
+        0xd65f03c0  // ret
+    };
+
+    mini_jit::Kernel l_kernel;
+    l_kernel.add_instr(l_instrs);
+    l_kernel.add_label("end");
+    l_kernel.set_optimize(false);
+    l_kernel.set_kernel();
+    REQUIRE(l_kernel.get_size() == 3 * 4);
+    REQUIRE_FALSE(l_kernel.get_peephole_stats().removed_moves);
+
+    mini_jit::Kernel l_optimized;
+    l_optimized.add_instr(l_instrs);
+    l_optimized.add_label("end");
+    l_optimized.set_optimize(true);
+    l_optimized.set_kernel();
+    REQUIRE(l_optimized.get_size() == 2 * 4);
+    REQUIRE(l_optimized.get_peephole_stats().removed_moves == 1);
+    REQUIRE(l_optimized.getInstrCountFromLabel("end") == 0);
+    REQUIRE(get_code(reinterpret_cast<void const*>(l_optimized.get_kernel()), l_optimized.get_size()) == std::vector<uint32_t>{0x3d800040, 0xd65f03c0});
+}
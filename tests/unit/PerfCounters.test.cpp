@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+#include <mlc/PerfCounters.h>
+#include <mlc/benchmarks/Benchmark.h>
+#include <omp.h>
+#include <string>
+
+TEST_CASE("Test PerfCounters", "[perf]")
+{
+    using event_t = mini_jit::PerfCounters::event_t;
+
+    REQUIRE(std::string(mini_jit::PerfCounters::name(event_t::l1d_misses)) == "l1d_misses");
+
+    mini_jit::PerfCounters::values_t values;
+    values.counts[static_cast<std::size_t>(event_t::cycles)]        = 200.0;
+    values.counts[static_cast<std::size_t>(event_t::instructions)]  = 300.0;
+    values.counted[static_cast<std::size_t>(event_t::cycles)]       = true;
+    values.counted[static_cast<std::size_t>(event_t::instructions)] = true;
+    REQUIRE(values.ipc() == Approx(1.5));
+    REQUIRE(values.per(100.0).get(event_t::cycles) == Approx(2.0));
+    REQUIRE(values.per(100.0).has(event_t::instructions));
+    REQUIRE(values.per(100.0).ipc() == Approx(1.5));
+    REQUIRE_FALSE(values.incomplete);
+    values.incomplete = true;
+    REQUIRE(values.per(100.0).incomplete);
+
+    // counting works without permissions or support, the events are simply not counted
+    mini_jit::PerfCounters counters;
+    REQUIRE(counters.available() == (counters.num_threads() > 0));
+    REQUIRE(counters.num_threads() <= omp_get_max_threads());
+    counters.start();
+    volatile double l_sum = 0.0;
+    for (int i = 0; i < 100000; i++)
+    {
+        l_sum = l_sum + i;
+    }
+    counters.stop();
+
+    mini_jit::PerfCounters::values_t counts = counters.read();
+    if (counts.has(event_t::instructions))
+    {
+        REQUIRE(counts.get(event_t::instructions) > 100000.0);
+    }
+    else
+    {
+        REQUIRE(counts.get(event_t::instructions) == 0.0);
+    }
+
+    // measurements with counters report the events per repetition
+    long   num_reps = 0;
+    double elapsed  = 0.0;
+    mini_jit::Benchmark::set_perf_counters(&counters);
+    mini_jit::Benchmark::benchmark_statistics stats = mini_jit::Benchmark::measure([&]()
+                                                                                   { l_sum = l_sum + 1.0; },
+                                                                                   0.01,
+                                                                                   num_reps,
+                                                                                   elapsed);
+    REQUIRE(stats.counters.has(event_t::cycles) == counts.has(event_t::cycles));
+    REQUIRE_FALSE(stats.counters.incomplete);
+
+    // counts of parallel functions are complete if all threads of the team are counted
+    stats = mini_jit::Benchmark::measure([&]()
+                                         { l_sum = l_sum + 1.0; },
+                                         0.01,
+                                         num_reps,
+                                         elapsed,
+                                         true);
+    mini_jit::Benchmark::set_perf_counters(nullptr);
+    REQUIRE(stats.counters.incomplete == (counters.available() && stats.numThreads > counters.num_threads()));
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mlc/Kernel.h>
+#include <mlc/PerfMap.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Test PerfMap", "[perf]")
+{
+    std::filesystem::path l_dir = std::filesystem::temp_directory_path() / "mlc_perf_map_test";
+    std::filesystem::remove_all(l_dir);
+    std::filesystem::create_directories(l_dir);
+    std::string l_map_path = (l_dir / "perf.map").string();
+
+    mini_jit::PerfMap& perf_map = mini_jit::PerfMap::instance();
+    perf_map.enable_perf_map(l_map_path);
+    perf_map.enable_jitdump(l_dir.string());
+    REQUIRE(perf_map.enabled());
+    REQUIRE(perf_map.get_perf_map_path() == l_map_path);
+
+    // the kernel is only generated, not executed
+    mini_jit::Kernel kernel;
+    kernel.set_name("brgemm_m64_n48_k64_br16");
+    kernel.add_instr(0xd503201f); // nop
+    kernel.add_instr(0xd65f03c0); // ret
+    kernel.set_kernel();
+
+    std::string l_jitdump_path = perf_map.get_jitdump_path();
+    perf_map.disable();
+    REQUIRE_FALSE(perf_map.enabled());
+
+    std::ifstream l_map(l_map_path);
+    std::string   l_line;
+    std::getline(l_map, l_line);
+    std::ostringstream l_expected;
+    l_expected << std::hex << reinterpret_cast<uintptr_t>(kernel.get_kernel()) << " 8 brgemm_m64_n48_k64_br16";
+    REQUIRE(l_line == l_expected.str());
+
+    // header of 40 bytes and one code load record with the name and the code
+    std::ifstream     l_jitdump(l_jitdump_path, std::ios::binary);
+    std::vector<char> l_bytes((std::istreambuf_iterator<char>(l_jitdump)), std::istreambuf_iterator<char>());
+    REQUIRE(l_bytes.size() == 40 + 56 + std::strlen("brgemm_m64_n48_k64_br16") + 1 + 8);
+
+    uint32_t l_magic = 0;
+    std::memcpy(&l_magic, l_bytes.data(), sizeof(l_magic));
+    REQUIRE(l_magic == 0x4A695444);
+    REQUIRE(std::string(l_bytes.data() + 40 + 56) == "brgemm_m64_n48_k64_br16");
+
+    uint32_t l_code = 0;
+    std::memcpy(&l_code, l_bytes.data() + l_bytes.size() - 4, sizeof(l_code));
+    REQUIRE(l_code == 0xd65f03c0);
+
+    std::filesystem::remove_all(l_dir);
+}
@@ -14,7 +14,8 @@
 void runTensorOperationTest(mini_jit::ptype_t                 first_touch_type,
                             mini_jit::ptype_t                 main_type,
                             mini_jit::ptype_t                 last_touch_type,
-                            std::span<const mini_jit::exec_t> exec_types)
+                            std::span<const mini_jit::exec_t> exec_types,
+                            bool                              packing = false)
 {
     const int R = 3;
     const int P = GENERATE(3, 7);
@@ -138,6 +139,7 @@ void runTensorOperationTest(mini_jit::ptype_t                 first_touch_type,
                                         0};
 
     mini_jit::TensorOperation l_top;
+    l_top.set_packing(packing);
     l_top.setup(mini_jit::dtype_t::fp32,
                 first_touch_type,
                 main_type,
@@ -148,6 +150,8 @@ void runTensorOperationTest(mini_jit::ptype_t                 first_touch_type,
                 strides_in0,
                 strides_in1,
                 strides_out);
+    // the blocks of B have a leading dimension of T * U instead of U, so they are packed if requested
+    REQUIRE(l_top.uses_packing() == packing);
 
     l_top.execute(A_raw, B, C);
 
@@ -296,6 +300,124 @@ TEST_CASE("Reference test for ZERO + BRGEMM + RELU tensor operation kernel with
                            exec_types);
 }
 
+TEST_CASE("Reference test for ZERO + GEMM + RELU tensor operation kernel with packed inputs", "[tensor_operation][parameterized][zero][gemm][relu][packing]")
+{
+    const mini_jit::ptype_t first_touch_type = mini_jit::ptype_t::zero;
+    const mini_jit::ptype_t main_type        = mini_jit::ptype_t::gemm;
+    const mini_jit::ptype_t last_touch_type  = mini_jit::ptype_t::relu;
+
+    std::vector<mini_jit::exec_t> exec_types = {
+        mini_jit::exec_t::seq,
+        mini_jit::exec_t::seq,
+        mini_jit::exec_t::seq,
+        mini_jit::exec_t::prim,
+        mini_jit::exec_t::prim,
+        mini_jit::exec_t::prim};
+    runTensorOperationTest(first_touch_type,
+                           main_type,
+                           last_touch_type,
+                           exec_types,
+                           true);
+}
+
+TEST_CASE("Reference test for ZERO + BRGEMM tensor operation kernel with shared(R) and packed inputs", "[tensor_operation][parameterized][zero][brgemm][packing]")
+{
+    const mini_jit::ptype_t first_touch_type = mini_jit::ptype_t::zero;
+    const mini_jit::ptype_t main_type        = mini_jit::ptype_t::brgemm;
+    const mini_jit::ptype_t last_touch_type  = mini_jit::ptype_t::none;
+
+    std::vector<mini_jit::exec_t> exec_types = {
+        mini_jit::exec_t::shared,
+        mini_jit::exec_t::seq,
+        mini_jit::exec_t::prim,
+        mini_jit::exec_t::prim,
+        mini_jit::exec_t::prim,
+        mini_jit::exec_t::prim};
+    runTensorOperationTest(first_touch_type,
+                           main_type,
+                           last_touch_type,
+                           exec_types,
+                           true);
+}
+
+TEST_CASE("Reference test for ZERO + GEMM + RELU tensor operation kernel with peeled M and N loops", "[tensor_operation][zero][gemm][relu][remainder]")
+{
+    const int M = GENERATE(37, 61);
+    const int N = GENERATE(21, 13);
+    const int K = 24;
+
+    std::vector<mini_jit::dim_t>  dim_types      = {mini_jit::dim_t::m, mini_jit::dim_t::n, mini_jit::dim_t::k};
+    std::vector<mini_jit::exec_t> exec_types     = {mini_jit::exec_t::seq, mini_jit::exec_t::seq, mini_jit::exec_t::seq};
+    std::vector<int64_t>          dim_sizes      = {M, N, K};
+    std::vector<int64_t>          strides_in0    = {1, 0, M};
+    std::vector<int64_t>          strides_in1    = {0, K, 1};
+    std::vector<int64_t>          strides_out    = {1, M, 0};
+    std::vector<int64_t>          dim_remainders = {};
+
+    // the prime sizes cannot be split evenly into kernels of at most 16 elements
+    mini_jit::ir::Optimizer::optimize(dim_types,
+                                      exec_types,
+                                      dim_sizes,
+                                      strides_in0,
+                                      strides_in1,
+                                      strides_out,
+                                      dim_remainders,
+                                      4,
+                                      16,
+                                      1);
+
+    int prim_count = std::count(exec_types.begin(), exec_types.end(), mini_jit::exec_t::prim);
+
+    mini_jit::TensorOperation l_top;
+    REQUIRE(l_top.setup(mini_jit::dtype_t::fp32,
+                        mini_jit::ptype_t::zero,
+                        prim_count == 4 ? mini_jit::ptype_t::brgemm : mini_jit::ptype_t::gemm,
+                        mini_jit::ptype_t::relu,
+                        dim_types,
+                        exec_types,
+                        dim_sizes,
+                        strides_in0,
+                        strides_in1,
+                        strides_out,
+                        dim_remainders) == mini_jit::error_t::success);
+    REQUIRE(l_top.uses_remainders());
+
+    std::vector<float> A(M * K);
+    std::vector<float> B(K * N);
+    std::vector<float> C(M * N);
+    std::vector<float> C_expected(M * N, 0.0f);
+
+    std::random_device                    rd;
+    std::mt19937                          gen(rd());
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    std::generate(A.begin(), A.end(), [&]()
+                  { return dist(gen); });
+    std::generate(B.begin(), B.end(), [&]()
+                  { return dist(gen); });
+    // dont init with zero, to test if the kernels set every element to zero
+    std::generate(C.begin(), C.end(), [&]()
+                  { return dist(gen); });
+
+    for (int n = 0; n < N; ++n)
+    {
+        for (int m = 0; m < M; ++m)
+        {
+            for (int k = 0; k < K; ++k)
+            {
+                C_expected[n * M + m] += A[k * M + m] * B[n * K + k];
+            }
+            C_expected[n * M + m] = std::max(C_expected[n * M + m], 0.0f);
+        }
+    }
+
+    l_top.execute(A.data(), B.data(), C.data());
+
+    for (int i = 0; i < M * N; ++i)
+    {
+        REQUIRE(C[i] == Approx(C_expected[i]).margin(FLOAT_ERROR_MARGIN));
+    }
+}
+
 TEST_CASE("Reference test for IDENTITY layout transformation trus → turs", "[tensor_operation][layout_transform][identity]")
 {
     const mini_jit::ptype_t first_touch_type = mini_jit::ptype_t::none;
@@ -1151,4 +1273,140 @@ TEST_CASE("Reference test for MAX tensor operation kernel with variable M, N", "
 TEST_CASE("Reference test for MIN tensor operation kernel with variable M, N", "[tensor_operation][parameterized][min]")
 {
     binaryTensorOperationTest(mini_jit::ptype_t::min);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test TensorOperation packing setup", "[tensor_operation][packing][setup]")
+{
+    std::vector<mini_jit::dim_t>  dim_types   = {mini_jit::dim_t::m, mini_jit::dim_t::n, mini_jit::dim_t::k};
+    std::vector<mini_jit::exec_t> exec_types  = {mini_jit::exec_t::prim, mini_jit::exec_t::prim, mini_jit::exec_t::prim};
+    std::vector<int64_t>          dim_sizes   = {16, 4, 8};
+    std::vector<int64_t>          strides_out = {1, 16, 0};
+
+    // contiguous blocks are never packed
+    std::vector<int64_t> strides_in0 = {1, 0, 16};
+    std::vector<int64_t> strides_in1 = {0, 8, 1};
+
+    mini_jit::TensorOperation l_top;
+    l_top.set_packing(true);
+    REQUIRE(l_top.setup(mini_jit::dtype_t::fp32,
+                        mini_jit::ptype_t::zero,
+                        mini_jit::ptype_t::gemm,
+                        mini_jit::ptype_t::none,
+                        dim_types,
+                        exec_types,
+                        dim_sizes,
+                        strides_in0,
+                        strides_in1,
+                        strides_out) == mini_jit::error_t::success);
+    REQUIRE_FALSE(l_top.uses_packing());
+    std::size_t l_code_size = l_top.get_code_size();
+
+    // large leading dimensions of both inputs
+    strides_in0 = {1, 0, 1024};
+    strides_in1 = {0, 1024, 1};
+    REQUIRE(l_top.setup(mini_jit::dtype_t::fp32,
+                        mini_jit::ptype_t::zero,
+                        mini_jit::ptype_t::gemm,
+                        mini_jit::ptype_t::none,
+                        dim_types,
+                        exec_types,
+                        dim_sizes,
+                        strides_in0,
+                        strides_in1,
+                        strides_out) == mini_jit::error_t::success);
+    REQUIRE(l_top.uses_packing());
+    REQUIRE(l_top.get_code_size() > l_code_size);
+
+    l_top.set_packing(false);
+    REQUIRE(l_top.setup(mini_jit::dtype_t::fp32,
+                        mini_jit::ptype_t::zero,
+                        mini_jit::ptype_t::gemm,
+                        mini_jit::ptype_t::none,
+                        dim_types,
+                        exec_types,
+                        dim_sizes,
+                        strides_in0,
+                        strides_in1,
+                        strides_out) == mini_jit::error_t::success);
+    REQUIRE_FALSE(l_top.uses_packing());
+
+    // the pack kernels of the previous setup are not counted
+    mini_jit::TensorOperation l_top_no_packing;
+    REQUIRE(l_top_no_packing.setup(mini_jit::dtype_t::fp32,
+                                   mini_jit::ptype_t::zero,
+                                   mini_jit::ptype_t::gemm,
+                                   mini_jit::ptype_t::none,
+                                   dim_types,
+                                   exec_types,
+                                   dim_sizes,
+                                   strides_in0,
+                                   strides_in1,
+                                   strides_out) == mini_jit::error_t::success);
+    REQUIRE(l_top.get_code_size() == l_top_no_packing.get_code_size());
+}
+
+TEST_CASE("Test TensorOperation remainder setup", "[tensor_operation][remainder][setup]")
+{
+    // 37 x 21 GEMM with 16 x 8 blocks, the last M block has 5 and the last N block 5 elements
+    std::vector<mini_jit::dim_t>  dim_types   = {mini_jit::dim_t::n, mini_jit::dim_t::m, mini_jit::dim_t::m, mini_jit::dim_t::n, mini_jit::dim_t::k};
+    std::vector<mini_jit::exec_t> exec_types  = {mini_jit::exec_t::shared, mini_jit::exec_t::seq, mini_jit::exec_t::prim, mini_jit::exec_t::prim, mini_jit::exec_t::prim};
+    std::vector<int64_t>          dim_sizes   = {3, 3, 16, 8, 24};
+    std::vector<int64_t>          strides_in0 = {0, 16, 1, 0, 37};
+    std::vector<int64_t>          strides_in1 = {8 * 24, 0, 0, 24, 1};
+    std::vector<int64_t>          strides_out = {8 * 37, 16, 1, 37, 0};
+
+    mini_jit::TensorOperation l_top;
+    REQUIRE(l_top.setup(mini_jit::dtype_t::fp32,
+                        mini_jit::ptype_t::zero,
+                        mini_jit::ptype_t::gemm,
+                        mini_jit::ptype_t::none,
+                        dim_types,
+                        exec_types,
+                        dim_sizes,
+                        strides_in0,
+                        strides_in1,
+                        strides_out) == mini_jit::error_t::success);
+    REQUIRE_FALSE(l_top.uses_remainders());
+    std::size_t l_code_size = l_top.get_code_size();
+    REQUIRE(l_top.get_setup_timings().num_kernels == 2);
+
+    std::vector<int64_t> dim_remainders = {5, 5, 0, 0, 0};
+    REQUIRE(l_top.setup(mini_jit::dtype_t::fp32,
+                        mini_jit::ptype_t::zero,
+                        mini_jit::ptype_t::gemm,
+                        mini_jit::ptype_t::none,
+                        dim_types,
+                        exec_types,
+                        dim_sizes,
+                        strides_in0,
+                        strides_in1,
+                        strides_out,
+                        dim_remainders) == mini_jit::error_t::success);
+    REQUIRE(l_top.uses_remainders());
+    // the remainder blocks use additional kernels
+    REQUIRE(l_top.get_code_size() > l_code_size);
+    // zero and GEMM kernels of the M, N and MN remainder operations
+    mini_jit::TensorOperation::setup_timings_t const& l_timings = l_top.get_setup_timings();
+    REQUIRE(l_timings.num_kernels == 8);
+    REQUIRE(l_timings.remainders_ns > 0);
+    REQUIRE(l_timings.total_ns() >= l_timings.kernels_ns + l_timings.remainders_ns);
+
+    // remainders are only allowed on SEQ or SHARED M and N loops and have to be smaller than the block
+    for (std::vector<int64_t> const& invalid : {std::vector<int64_t>{0, 0, 5, 0, 0},
+                                                std::vector<int64_t>{0, 16, 0, 0, 0},
+                                                std::vector<int64_t>{0, 0, 0, 0, 3},
+                                                std::vector<int64_t>{5, 5}})
+    {
+        REQUIRE(l_top.setup(mini_jit::dtype_t::fp32,
+                            mini_jit::ptype_t::zero,
+                            mini_jit::ptype_t::gemm,
+                            mini_jit::ptype_t::none,
+                            dim_types,
+                            exec_types,
+                            dim_sizes,
+                            strides_in0,
+                            strides_in1,
+                            strides_out,
+                            invalid) == mini_jit::error_t::wrong_dimension);
+    }
+}
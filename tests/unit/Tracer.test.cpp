@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <mlc/Tracer.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+TEST_CASE("Test Tracer", "[trace]")
+{
+    mini_jit::Tracer& tracer = mini_jit::Tracer::instance();
+    tracer.clear();
+
+    // disabled scopes are not recorded
+    tracer.disable();
+    {
+        MLC_TRACE_SCOPE("test", "disabled");
+    }
+    REQUIRE(tracer.get_spans().empty());
+
+    tracer.enable();
+    REQUIRE(tracer.enabled());
+    {
+        MLC_TRACE_SCOPE("test", "outer");
+        {
+            // the name of a temporary string is copied before the string is destroyed
+            MLC_TRACE_SCOPE("einsum", std::string("abc,cd") + "->abd");
+        }
+    }
+
+    // a new thread records into its own buffer with the new capacity
+    tracer.enable(2);
+    std::thread l_thread([]()
+                         {
+                             for (int i = 0; i < 3; i++)
+                             {
+                                 MLC_TRACE_SCOPE("test", "worker");
+                             }
+                         });
+    l_thread.join();
+
+    // restores the default capacity
+    tracer.enable();
+    tracer.disable();
+
+    std::vector<std::pair<int64_t, mini_jit::Tracer::span_t>> l_spans = tracer.get_spans();
+    REQUIRE(l_spans.size() == 4);
+    REQUIRE(tracer.get_dropped() == 1);
+
+    // the inner span ends first and lies within the outer span
+    mini_jit::Tracer::span_t const& l_inner = l_spans[0].second;
+    mini_jit::Tracer::span_t const& l_outer = l_spans[1].second;
+    REQUIRE(std::string(l_inner.name) == "abc,cd->abd");
+    REQUIRE(std::string(l_inner.category) == "einsum");
+    REQUIRE(std::string(l_outer.name) == "outer");
+    REQUIRE(l_inner.start_ns >= l_outer.start_ns);
+    REQUIRE(l_inner.start_ns + l_inner.duration_ns <= l_outer.start_ns + l_outer.duration_ns);
+
+    REQUIRE(l_spans[2].first != l_spans[0].first);
+    REQUIRE(std::string(l_spans[2].second.name) == "worker");
+    REQUIRE(l_spans[3].first == l_spans[2].first);
+
+    std::filesystem::path l_path = std::filesystem::temp_directory_path() / "mlc_trace_test.json";
+    tracer.write_chrome_trace(l_path.string());
+
+    std::ifstream     l_file(l_path);
+    std::stringstream l_content;
+    l_content << l_file.rdbuf();
+    std::string l_json = l_content.str();
+    REQUIRE(l_json.rfind("{\"traceEvents\": [", 0) == 0);
+    REQUIRE(l_json.find("{\"name\": \"abc,cd->abd\", \"cat\": \"einsum\", \"ph\": \"X\", \"ts\": ") != std::string::npos);
+    REQUIRE(l_json.find("\"ph\": \"M\"") != std::string::npos);
+    REQUIRE(l_json.find("\"dropped_spans\": 1") != std::string::npos);
+
+    tracer.clear();
+    REQUIRE(tracer.get_spans().empty());
+    REQUIRE(tracer.get_dropped() == 0);
+    REQUIRE_THROWS_AS(tracer.enable(0), std::invalid_argument);
+
+    std::filesystem::remove(l_path);
+}
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <mlc/benchmarks/Benchmark.h>
+#include <sstream>
+#include <vector>
+
+TEST_CASE("Test Benchmark Statistics", "[benchmark]")
+{
+    REQUIRE(mini_jit::Benchmark::percentile({}, 50.0) == 0.0);
+    REQUIRE(mini_jit::Benchmark::percentile({1.0, 2.0, 3.0, 4.0, 5.0}, 50.0) == Approx(3.0));
+    REQUIRE(mini_jit::Benchmark::percentile({1.0, 2.0, 3.0, 4.0, 5.0}, 5.0) == Approx(1.2));
+    REQUIRE(mini_jit::Benchmark::percentile({1.0, 2.0, 3.0, 4.0, 5.0}, 100.0) == Approx(5.0));
+
+    // batches of 10 repetitions, the outlier only affects the mean and the upper percentiles
+    std::vector<double>                       samples = {0.020, 0.010, 0.030, 0.020, 0.020, 1.000};
+    mini_jit::Benchmark::benchmark_statistics stats   = mini_jit::Benchmark::compute_statistics(samples, 10, 7);
+    REQUIRE(stats.numSamples == 6);
+    REQUIRE(stats.repsPerSample == 10);
+    REQUIRE(stats.warmupReps == 7);
+    REQUIRE(stats.median == Approx(0.002));
+    REQUIRE(stats.min == Approx(0.001));
+    REQUIRE(stats.max == Approx(0.1));
+    REQUIRE(stats.mean == Approx(1.1 / 60.0));
+    REQUIRE(stats.p5 < stats.median);
+    REQUIRE(stats.p95 > stats.median);
+    REQUIRE(stats.stddev > 0.0);
+    REQUIRE(stats.numThreads >= 1);
+}
+
+TEST_CASE("Test Benchmark Measure", "[benchmark]")
+{
+    volatile long counter  = 0;
+    long          num_reps = 0;
+    double        elapsed  = 0.0;
+
+    mini_jit::Benchmark::benchmark_statistics stats = mini_jit::Benchmark::measure([&]()
+                                                                                   { counter = counter + 1; },
+                                                                                   0.01,
+                                                                                   num_reps,
+                                                                                   elapsed);
+
+    // cheap functions are batched to amortize the timer
+    REQUIRE(stats.numSamples >= mini_jit::Benchmark::MIN_SAMPLES);
+    REQUIRE(stats.repsPerSample > 1);
+    REQUIRE(num_reps == stats.numSamples * stats.repsPerSample);
+    REQUIRE(counter == num_reps + stats.warmupReps);
+    REQUIRE(elapsed >= 0.01);
+    REQUIRE(stats.p5 <= stats.median);
+    REQUIRE(stats.median <= stats.p95);
+}
+
+TEST_CASE("Test Benchmark Output", "[benchmark]")
+{
+    mini_jit::Benchmark::benchmark_result result;
+    result.numReps           = 100;
+    result.gflops            = 12.5;
+    result.statistics.median = 0.25;
+
+    std::string json = mini_jit::Benchmark::to_json("gemm 64x64x64", result);
+    REQUIRE(json.find("\"name\": \"gemm 64x64x64\"") != std::string::npos);
+    REQUIRE(json.find("\"gflops\": 12.5") != std::string::npos);
+    REQUIRE(json.find("\"median\": 0.25") != std::string::npos);
+    REQUIRE(json.find("\"incomplete\": false") != std::string::npos);
+
+    std::ostringstream csv;
+    mini_jit::Benchmark::write_csv_header(csv);
+    mini_jit::Benchmark::write_csv(csv, "gemm", result);
+
+    std::string        header;
+    std::string        row;
+    std::istringstream lines(csv.str());
+    std::getline(lines, header);
+    std::getline(lines, row);
+    REQUIRE(std::count(header.begin(), header.end(), ',') == std::count(row.begin(), row.end(), ','));
+    REQUIRE(row.rfind("gemm,100,", 0) == 0);
+}
+
+TEST_CASE("Test Benchmark Roofline", "[benchmark]")
+{
+    // one floating point operation per byte
+    mini_jit::Benchmark::benchmark_result result;
+    result.totalOperations    = 1l << 30;
+    result.totalDataProcessed = 1.0;
+    result.gflops             = 25.0;
+    result.gibps              = 50.0;
+
+    // the arithmetic intensity does not depend on the peaks
+    mini_jit::Benchmark::benchmark_roofline unknown = mini_jit::Benchmark::compute_roofline(result, 0.0, 100.0);
+    REQUIRE(unknown.arithmeticIntensity == Approx(1.0));
+    REQUIRE(unknown.attainableGflops == 0.0);
+    REQUIRE(unknown.fractionOfPeak == 0.0);
+
+    // 100 GiB/s limit the performance to 107.4 GFLOPS
+    mini_jit::Benchmark::benchmark_roofline memory = mini_jit::Benchmark::compute_roofline(result, 1000.0, 100.0);
+    REQUIRE(memory.memoryBound);
+    REQUIRE(memory.attainableGflops == Approx(100.0 * 1024 * 1024 * 1024 / 1e9));
+    REQUIRE(memory.fractionOfPeak == Approx(0.5));
+
+    mini_jit::Benchmark::benchmark_roofline compute = mini_jit::Benchmark::compute_roofline(result, 50.0, 100.0);
+    REQUIRE_FALSE(compute.memoryBound);
+    REQUIRE(compute.attainableGflops == Approx(50.0));
+    REQUIRE(compute.fractionOfPeak == Approx(0.5));
+
+    // without data every kernel is compute bound
+    result.totalDataProcessed = 0.0;
+    REQUIRE_FALSE(mini_jit::Benchmark::compute_roofline(result, 50.0, 100.0).memoryBound);
+}
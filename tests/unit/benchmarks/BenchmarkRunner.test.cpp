@@ -0,0 +1,254 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <mlc/benchmarks/BenchmarkRunner.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using mini_jit::benchmarks::BenchmarkRunner;
+
+/**
+ * Benchmark which reports its parameters as results without executing generated code.
+ */
+class DummyBench : public mini_jit::Benchmark
+{
+public:
+    DummyBench(int64_t m,
+               int64_t n)
+    {
+        m_benchmarkResult.numReps           = m;
+        m_benchmarkResult.gflops            = m * n;
+        m_benchmarkResult.statistics.median = 1e-3 * m;
+        m_benchmarkResult.statistics.p5     = 0.9e-3 * m;
+        m_benchmarkResult.statistics.p95    = 1.1e-3 * m;
+    }
+    void run() override
+    {
+        if (m_benchmarkResult.numReps < 0)
+        {
+            throw std::runtime_error("negative size");
+        }
+    }
+};
+
+/**
+ * Creates a runner with a dummy benchmark in two groups.
+ */
+BenchmarkRunner create_runner()
+{
+    BenchmarkRunner::factory_t l_factory = [](double, BenchmarkRunner::params_t const& params)
+    {
+        return std::make_unique<DummyBench>(params.at("m"), params.count("n") ? params.at("n") : 1);
+    };
+
+    BenchmarkRunner l_runner;
+    l_runner.add("matmul/gemm", "dummy gemm", {{{"m", 8}, {"n", 4}}}, l_factory);
+    l_runner.add("matmul/brgemm", "dummy brgemm", {{{"m", 8}, {"n", 4}, {"br_size", 2}}}, l_factory);
+    l_runner.add("unary/relu", "dummy relu", {{{"m", 1}}, {{"m", 2}}}, l_factory);
+    return l_runner;
+}
+
+TEST_CASE("Test BenchmarkRunner Values", "[benchmark]")
+{
+    REQUIRE(BenchmarkRunner::parse_values("64") == std::vector<int64_t>{64});
+    REQUIRE(BenchmarkRunner::parse_values("1, 16,32") == std::vector<int64_t>{1, 16, 32});
+    REQUIRE(BenchmarkRunner::parse_values("1:4") == std::vector<int64_t>{1, 2, 3, 4});
+    REQUIRE(BenchmarkRunner::parse_values("1:9:4") == std::vector<int64_t>{1, 5, 9});
+    REQUIRE(BenchmarkRunner::parse_values("16:100:*2,128") == std::vector<int64_t>{16, 32, 64, 128});
+
+    REQUIRE_THROWS_AS(BenchmarkRunner::parse_values(""), std::invalid_argument);
+    REQUIRE_THROWS_AS(BenchmarkRunner::parse_values("a"), std::invalid_argument);
+    REQUIRE_THROWS_AS(BenchmarkRunner::parse_values("4:1"), std::invalid_argument);
+    REQUIRE_THROWS_AS(BenchmarkRunner::parse_values("1:4:0"), std::invalid_argument);
+    REQUIRE_THROWS_AS(BenchmarkRunner::parse_values("1:4:*1"), std::invalid_argument);
+}
+
+TEST_CASE("Test BenchmarkRunner Selection and Sweep", "[benchmark]")
+{
+    BenchmarkRunner runner = create_runner();
+    REQUIRE_THROWS_AS(runner.add("unary/relu", "duplicate", {{{"m", 1}}}, nullptr), std::invalid_argument);
+    REQUIRE(runner.select().size() == 3);
+
+    char const* argv[] = {"benchmarks", "matmul", "--filter", "brgemm$", "--m=1:3", "--n", "2,4", "--run-time", "0.5"};
+    runner.parse_arguments(9, argv);
+    REQUIRE(runner.get_run_time() == 0.5);
+
+    auto selected = runner.select();
+    REQUIRE(selected.size() == 1);
+    REQUIRE(selected[0]->name == "matmul/brgemm");
+
+    // 3 values of m times 2 values of n, br_size keeps its default
+    auto points = runner.sweep(*selected[0]);
+    REQUIRE(points.size() == 6);
+    REQUIRE(points[0] == BenchmarkRunner::params_t{{"br_size", 2}, {"m", 1}, {"n", 2}});
+    REQUIRE(points[5] == BenchmarkRunner::params_t{{"br_size", 2}, {"m", 3}, {"n", 4}});
+    REQUIRE(BenchmarkRunner::to_string(points[0]) == "br_size=2 m=1 n=2");
+
+    // the overridden m collapses both default points of the relu benchmark, n is not one of its parameters
+    BenchmarkRunner unary = create_runner();
+    char const*     argv_unary[] = {"benchmarks", "--m", "5", "--n", "3", "unary"};
+    unary.parse_arguments(6, argv_unary);
+    REQUIRE(unary.select().size() == 1);
+    REQUIRE(unary.sweep(*unary.select()[0]) == std::vector<BenchmarkRunner::params_t>{{{"m", 5}}});
+
+    char const* argv_unknown_option[] = {"benchmarks", "--k", "5"};
+    char const* argv_unknown_name[]   = {"benchmarks", "matmul/gem"};
+    char const* argv_missing_value[]  = {"benchmarks", "--m"};
+    char const* argv_invalid_filter[] = {"benchmarks", "--filter", "("};
+    REQUIRE_THROWS_AS(create_runner().parse_arguments(3, argv_unknown_option), std::invalid_argument);
+    REQUIRE_THROWS_AS(create_runner().parse_arguments(2, argv_unknown_name), std::invalid_argument);
+    REQUIRE_THROWS_AS(create_runner().parse_arguments(2, argv_missing_value), std::invalid_argument);
+    REQUIRE_THROWS_AS(create_runner().parse_arguments(3, argv_invalid_filter), std::invalid_argument);
+}
+
+TEST_CASE("Test BenchmarkRunner Config and Results", "[benchmark]")
+{
+    std::filesystem::path l_dir = std::filesystem::temp_directory_path() / "mlc_benchmark_runner_test";
+    std::filesystem::remove_all(l_dir);
+    std::filesystem::create_directories(l_dir);
+
+    std::string l_config = (l_dir / "sweep.conf").string();
+    std::ofstream(l_config) << "# gemm sweep\n"
+                            << "filter     = ^matmul/gemm$\n"
+                            << "name       = sweep\n"
+                            << "output_dir = " << l_dir.string() << "\n"
+                            << "m          = 1:2   # two sizes\n"
+                            << "\n"
+                            << "n          = 3\n";
+
+    BenchmarkRunner runner = create_runner();
+    REQUIRE_THROWS_AS(runner.load_config((l_dir / "missing.conf").string()), std::runtime_error);
+    char const* argv[] = {"benchmarks", "--config", l_config.c_str()};
+    runner.parse_arguments(3, argv);
+
+    std::ostringstream l_log;
+    REQUIRE(runner.run(l_log) == 0);
+    REQUIRE(runner.get_run_name() == "sweep");
+    REQUIRE(runner.get_records().size() == 2);
+    REQUIRE(runner.get_records()[1].result.gflops == 6.0);
+
+    std::ifstream l_csv(l_dir / "sweep.csv");
+    std::string   l_header;
+    std::string   l_row;
+    std::getline(l_csv, l_header);
+    std::getline(l_csv, l_row);
+    REQUIRE(l_header.rfind("benchmark,m,n,name,num_reps,", 0) == 0);
+    REQUIRE(l_row.rfind("matmul/gemm,1,3,matmul/gemm m=1 n=3,1,", 0) == 0);
+
+    std::ifstream     l_json_file(l_dir / "sweep.json");
+    std::stringstream l_json;
+    l_json << l_json_file.rdbuf();
+    REQUIRE(l_json.str().find("\"params\": {\"m\": 2, \"n\": 3}") != std::string::npos);
+    REQUIRE(std::filesystem::exists(l_dir / "sweep.txt"));
+
+    // failing benchmarks are reported and skipped
+    BenchmarkRunner failing = create_runner();
+    std::string     l_out   = l_dir.string();
+    char const*     argv_failing[] = {"benchmarks", "matmul/gemm", "--m", "-1,1", "--output-dir", l_out.c_str(), "--name", "failing"};
+    failing.parse_arguments(8, argv_failing);
+    REQUIRE(failing.run(l_log) == 1);
+    REQUIRE(failing.get_records().size() == 1);
+
+    std::filesystem::remove_all(l_dir);
+}
+
+TEST_CASE("Test BenchmarkRunner Baseline", "[benchmark]")
+{
+    mini_jit::Benchmark::benchmark_statistics baseline;
+    baseline.median = 1.0;
+    baseline.p5     = 0.9;
+    baseline.p95    = 1.1;
+
+    // slowdowns within the tolerance or the noise of the baseline are no regressions
+    mini_jit::Benchmark::benchmark_statistics current = baseline;
+    REQUIRE_FALSE(BenchmarkRunner::is_regression(baseline, current, 0.05));
+    current.median = 1.2;
+    current.p5     = 1.0;
+    current.p95    = 1.4;
+    REQUIRE_FALSE(BenchmarkRunner::is_regression(baseline, current, 0.05));
+    current.p5 = 1.15;
+    REQUIRE(BenchmarkRunner::is_regression(baseline, current, 0.05));
+    REQUIRE_FALSE(BenchmarkRunner::is_regression(baseline, current, 0.25));
+
+    std::filesystem::path l_dir = std::filesystem::temp_directory_path() / "mlc_benchmark_runner_baseline_test";
+    std::filesystem::remove_all(l_dir);
+    std::string l_out      = l_dir.string();
+    std::string l_baseline = (l_dir / "baseline" / "gemm.csv").string();
+
+    // a missing baseline only skips the comparison
+    BenchmarkRunner missing = create_runner();
+    char const*     argv_missing[] = {"benchmarks", "matmul/gemm", "--output-dir", l_out.c_str(), "--baseline", l_baseline.c_str()};
+    missing.parse_arguments(6, argv_missing);
+    std::ostringstream l_log;
+    REQUIRE(missing.run(l_log) == 0);
+    REQUIRE(missing.get_comparisons().empty());
+    REQUIRE(l_log.str().find("Warning: Could not open baseline") != std::string::npos);
+
+    BenchmarkRunner update = create_runner();
+    char const*     argv_update[] = {"benchmarks", "matmul/gemm", "--m", "2,4", "--output-dir", l_out.c_str(), "--baseline", l_baseline.c_str(), "--update-baseline"};
+    update.parse_arguments(9, argv_update);
+    REQUIRE(update.run(l_log) == 0);
+    REQUIRE(std::filesystem::exists(l_baseline));
+    REQUIRE(update.get_comparisons().empty());
+
+    // m=2 is unchanged and m=8 has no baseline
+    BenchmarkRunner compare = create_runner();
+    char const*     argv_compare[] = {"benchmarks", "matmul/gemm", "--m", "2,8", "--output-dir", l_out.c_str(), "--baseline", l_baseline.c_str()};
+    compare.parse_arguments(8, argv_compare);
+    REQUIRE(compare.run(l_log) == 0);
+    REQUIRE(compare.get_comparisons().size() == 1);
+    REQUIRE(compare.get_comparisons()[0].speedup == Approx(1.0));
+
+    BenchmarkRunner regression = create_runner();
+    char const*     argv_regression[] = {"benchmarks", "matmul/gemm", "--m", "2,4", "--output-dir", l_out.c_str(), "--baseline", l_baseline.c_str(), "--tolerance", "0.1"};
+    regression.parse_arguments(10, argv_regression);
+
+    // baselines only need the name and the statistics, m=4 is twice as slow as its baseline
+    std::ofstream(l_baseline) << "name,median,p5,p95\n"
+                              << "matmul/gemm m=2 n=4,0.002,0.0018,0.0022\n"
+                              << "matmul/gemm m=4 n=4,0.002,0.0018,0.0022\n";
+    REQUIRE(regression.run(l_log) == 1);
+    REQUIRE(regression.get_comparisons().size() == 2);
+    REQUIRE_FALSE(regression.get_comparisons()[0].regression);
+    REQUIRE(regression.get_comparisons()[1].regression);
+    REQUIRE(regression.get_comparisons()[1].speedup == Approx(0.5));
+
+    std::filesystem::remove_all(l_dir);
+}
+
+TEST_CASE("Test BenchmarkRunner Roofline", "[benchmark]")
+{
+    std::filesystem::path l_dir = std::filesystem::temp_directory_path() / "mlc_benchmark_runner_roofline_test";
+    std::filesystem::remove_all(l_dir);
+    std::string l_out = l_dir.string();
+
+    // given peaks are not measured again
+    int64_t         l_num_probes = 0;
+    BenchmarkRunner runner       = create_runner();
+    runner.set_probes([&](double)
+                      {
+                          l_num_probes++;
+                          return 100.0;
+                      },
+                      [&](double)
+                      {
+                          l_num_probes++;
+                          return 20.0;
+                      });
+
+    char const* argv[] = {"benchmarks", "matmul/gemm", "--output-dir", l_out.c_str(), "--roofline", "--peak-gflops", "50"};
+    runner.parse_arguments(7, argv);
+    char const* argv_negative[] = {"benchmarks", "--peak-gibps", "-1"};
+    REQUIRE_THROWS_AS(create_runner().parse_arguments(3, argv_negative), std::invalid_argument);
+
+    std::ostringstream l_log;
+    REQUIRE(runner.run(l_log) == 0);
+    REQUIRE(l_num_probes == 1);
+    REQUIRE(runner.get_peak_gflops() == 50.0);
+    REQUIRE(runner.get_peak_gibps() == 20.0);
+    REQUIRE(runner.get_records()[0].result.roofline.peakGflops == 50.0);
+    REQUIRE(runner.get_records()[0].result.roofline.peakGibps == 20.0);
+
+    std::filesystem::remove_all(l_dir);
+}
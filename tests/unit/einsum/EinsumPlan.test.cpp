@@ -0,0 +1,287 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <map>
+#include <mlc/constants.h>
+#include <mlc/einsum/EinsumPlan.h>
+#include <thread>
+#include <vector>
+
+TEST_CASE("EinsumPlan GEMM Test")
+{
+    std::string          input = "[2,0],[1,2]->[1,0]";
+    std::vector<int64_t> dimension_sizes{GENERATE(3, 7, 19),
+                                         GENERATE(3, 7, 19),
+                                         GENERATE(3, 7, 19)};
+
+    mini_jit::einsum::EinsumPlan plan(input,
+                                      dimension_sizes,
+                                      mini_jit::dtype_t::fp32,
+                                      256,
+                                      512,
+                                      16);
+
+    REQUIRE(plan.to_string() == input);
+    REQUIRE(plan.get_input_expressions() == std::vector<std::string>{"2,0", "1,2"});
+    REQUIRE(plan.get_scratch_size() == 0);
+
+    const int64_t M = dimension_sizes[0];
+    const int64_t N = dimension_sizes[1];
+    const int64_t K = dimension_sizes[2];
+
+    std::vector<float> tensor_A(M * K);
+    std::vector<float> tensor_B(K * N);
+    std::vector<float> tensor_out(M * N, 1.0f);
+    std::vector<float> tensor_out_expected(M * N, 0.0f);
+
+    for (size_t i = 0; i < tensor_A.size(); ++i)
+    {
+        tensor_A[i] = i * 3.1f;
+    }
+    for (size_t i = 0; i < tensor_B.size(); ++i)
+    {
+        tensor_B[i] = i * 0.5f;
+    }
+
+    for (int col = 0; col < N; ++col)
+    {
+        for (int row = 0; row < M; ++row)
+        {
+            float sum = 0.0f;
+            for (int k = 0; k < K; ++k)
+            {
+                sum += tensor_A[row + k * M] * tensor_B[k + col * K];
+            }
+            tensor_out_expected[row + col * M] = sum;
+        }
+    }
+
+    // execute twice to make sure no state is carried over between calls
+    for (int rep = 0; rep < 2; ++rep)
+    {
+        plan.execute({tensor_A.data(), tensor_B.data()},
+                     tensor_out.data());
+
+        for (int64_t i = 0; i < M * N; ++i)
+        {
+            REQUIRE(tensor_out[i] == Approx(tensor_out_expected[i]).margin(FLOAT_ERROR_MARGIN));
+        }
+    }
+}
+
+TEST_CASE("EinsumPlan Concurrent Execution Test")
+{
+    // [0,1],[1,2]->[0,2] is computed into the scratch buffer
+    std::string          input = "[[0,1],[1,2]->[0,2]],[2,3]->[0,3]";
+    std::vector<int64_t> dimension_sizes{8, 5, 6, 7};
+    const int64_t        num_threads = 4;
+
+    mini_jit::einsum::EinsumPlan plan(input,
+                                      dimension_sizes,
+                                      mini_jit::dtype_t::fp32,
+                                      1,
+                                      512,
+                                      16);
+
+    REQUIRE(plan.get_number_of_operations() == 2);
+    REQUIRE(plan.get_scratch_size() == 8 * 6 * 4);
+
+    const int64_t S0 = dimension_sizes[0];
+    const int64_t S1 = dimension_sizes[1];
+    const int64_t S2 = dimension_sizes[2];
+    const int64_t S3 = dimension_sizes[3];
+
+    // every thread uses its own inputs, output and scratch buffer
+    std::vector<std::vector<float>> tensors_A(num_threads, std::vector<float>(S0 * S1));
+    std::vector<std::vector<float>> tensors_B(num_threads, std::vector<float>(S1 * S2));
+    std::vector<std::vector<float>> tensors_C(num_threads, std::vector<float>(S2 * S3));
+    std::vector<std::vector<float>> tensors_out(num_threads, std::vector<float>(S0 * S3));
+
+    for (int64_t t = 0; t < num_threads; ++t)
+    {
+        for (size_t i = 0; i < tensors_A[t].size(); ++i)
+        {
+            tensors_A[t][i] = (i % 7) * 0.25f + t;
+        }
+        for (size_t i = 0; i < tensors_B[t].size(); ++i)
+        {
+            tensors_B[t][i] = (i % 5) * 0.5f - t;
+        }
+        for (size_t i = 0; i < tensors_C[t].size(); ++i)
+        {
+            tensors_C[t][i] = (i % 3) * 0.75f;
+        }
+    }
+
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]()
+                             {
+                                 mini_jit::einsum::EinsumPlan::scratch_t scratch(plan.get_scratch_size());
+                                 std::map<std::string, void const*>      tensor_inputs;
+                                 tensor_inputs["0,1"] = tensors_A[t].data();
+                                 tensor_inputs["1,2"] = tensors_B[t].data();
+                                 tensor_inputs["2,3"] = tensors_C[t].data();
+                                 plan.execute(tensor_inputs,
+                                              tensors_out[t].data(),
+                                              scratch.data()); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // row-major reference: out[i0][i3] = sum_{i1, i2} A[i0][i1] * B[i1][i2] * C[i2][i3]
+    for (int64_t t = 0; t < num_threads; ++t)
+    {
+        for (int64_t i0 = 0; i0 < S0; ++i0)
+        {
+            for (int64_t i3 = 0; i3 < S3; ++i3)
+            {
+                float expected = 0.0f;
+                for (int64_t i2 = 0; i2 < S2; ++i2)
+                {
+                    float tmp = 0.0f;
+                    for (int64_t i1 = 0; i1 < S1; ++i1)
+                    {
+                        tmp += tensors_A[t][i0 * S1 + i1] * tensors_B[t][i1 * S2 + i2];
+                    }
+                    expected += tmp * tensors_C[t][i2 * S3 + i3];
+                }
+                REQUIRE(tensors_out[t][i0 * S3 + i3] == Approx(expected).margin(FLOAT_ERROR_MARGIN));
+            }
+        }
+    }
+}
+
+TEST_CASE("EinsumPlan Memory Plan Test", "[einsum][plan]")
+{
+    // intermediate tensors of a chain are only alive for two operations,
+    // so the first and the third intermediate share the same memory
+    std::string          input = "[[[[0,1],[1,2]->[0,2]],[2,3]->[0,3]],[3,4]->[0,4]],[4,5]->[0,5]";
+    std::vector<int64_t> dimension_sizes{8, 8, 8, 8, 8, 8};
+
+    mini_jit::einsum::EinsumPlan plan(input,
+                                      dimension_sizes,
+                                      mini_jit::dtype_t::fp32,
+                                      1,
+                                      512,
+                                      16);
+
+    REQUIRE(plan.get_input_expressions() == std::vector<std::string>{"0,1", "1,2", "2,3", "3,4", "4,5"});
+    REQUIRE(plan.get_number_of_operations() == 4);
+    REQUIRE(plan.get_output_size() == 8 * 8 * 4);
+    REQUIRE(plan.get_scratch_size() == 2 * 8 * 8 * 4);
+    REQUIRE(plan.get_computational_operations() == Approx(4 * 2.0 * 8 * 8 * 8));
+
+    mini_jit::einsum::EinsumPlan::scratch_t scratch(plan.get_scratch_size());
+    REQUIRE(reinterpret_cast<uintptr_t>(scratch.data()) % mini_jit::einsum::EinsumPlan::SCRATCH_ALIGNMENT == 0);
+
+    std::vector<float> tensor(8 * 8);
+    REQUIRE_THROWS_AS(plan.execute({tensor.data()}, tensor.data()), std::invalid_argument);
+}
+
+TEST_CASE("EinsumPlan Batched Execution Test")
+{
+    std::string          input = "[2,0],[1,2]->[1,0]";
+    std::vector<int64_t> dimension_sizes{16, 12, 8};
+    const int64_t        batch_size = GENERATE(1, 64);
+
+    mini_jit::einsum::EinsumPlan plan(input,
+                                      dimension_sizes,
+                                      mini_jit::dtype_t::fp32,
+                                      4,
+                                      512,
+                                      16);
+
+    const int64_t M = dimension_sizes[0];
+    const int64_t N = dimension_sizes[1];
+    const int64_t K = dimension_sizes[2];
+
+    // A differs per sample, B is shared by all samples
+    std::vector<float> tensor_A(batch_size * M * K);
+    std::vector<float> tensor_B(K * N);
+    std::vector<float> tensor_out(batch_size * M * N, -1.0f);
+
+    for (size_t i = 0; i < tensor_A.size(); ++i)
+    {
+        tensor_A[i] = (i % 13) * 0.5f;
+    }
+    for (size_t i = 0; i < tensor_B.size(); ++i)
+    {
+        tensor_B[i] = (i % 7) * 0.25f;
+    }
+
+    plan.execute_batched(batch_size,
+                         {tensor_A.data(), tensor_B.data()},
+                         {M * K, 0},
+                         tensor_out.data(),
+                         M * N);
+
+    for (int64_t b = 0; b < batch_size; ++b)
+    {
+        for (int64_t col = 0; col < N; ++col)
+        {
+            for (int64_t row = 0; row < M; ++row)
+            {
+                float expected = 0.0f;
+                for (int64_t k = 0; k < K; ++k)
+                {
+                    expected += tensor_A[b * M * K + row + k * M] * tensor_B[k + col * K];
+                }
+                REQUIRE(tensor_out[b * M * N + row + col * M] == Approx(expected).margin(FLOAT_ERROR_MARGIN));
+            }
+        }
+    }
+}
+
+TEST_CASE("EinsumPlan Batched Argument Test", "[einsum][plan]")
+{
+    mini_jit::einsum::EinsumPlan plan("[2,0],[1,2]->[1,0]",
+                                      {4, 4, 4},
+                                      mini_jit::dtype_t::fp32,
+                                      1,
+                                      512,
+                                      16);
+
+    std::vector<float> tensor(16);
+    REQUIRE_THROWS_AS(plan.execute_batched(2, {tensor.data(), tensor.data()}, {0}, tensor.data(), 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(plan.execute_batched(2, {tensor.data()}, {0}, tensor.data(), 0), std::invalid_argument);
+}
+
+TEST_CASE("EinsumPlan Setup Error Test", "[einsum][plan]")
+{
+    // the tensor operations only support fp32
+    REQUIRE_THROWS_AS(mini_jit::einsum::EinsumPlan("[2,0],[1,2]->[1,0]",
+                                                   {4, 4, 4},
+                                                   mini_jit::dtype_t::fp64,
+                                                   1,
+                                                   512,
+                                                   16),
+                      std::invalid_argument);
+}
+
+TEST_CASE("EinsumPlan Report Test", "[einsum][plan]")
+{
+    std::string          input = "[[0,1],[1,2]->[0,2]],[2,3]->[0,3]";
+    std::vector<int64_t> dimension_sizes{64, 32, 48, 16};
+
+    mini_jit::einsum::EinsumPlan plan(input,
+                                      dimension_sizes,
+                                      mini_jit::dtype_t::fp32,
+                                      1,
+                                      512,
+                                      16);
+
+    // one report per operation, input tensors have none
+    std::string json = plan.to_json();
+    REQUIRE(json.rfind("{\"expression\": \"0,3\"", 0) == 0);
+    REQUIRE(json.find("\"expression\": \"0,1\", \"report\": null") != std::string::npos);
+
+    int64_t num_reports = 0;
+    for (size_t pos = json.find("\"decisions\""); pos != std::string::npos; pos = json.find("\"decisions\"", pos + 1))
+    {
+        num_reports++;
+    }
+    REQUIRE(num_reports == plan.get_number_of_operations());
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch.hpp>
+#include <mlc/einsum/EinsumPlanCache.h>
+#include <vector>
+
+TEST_CASE("EinsumPlanCache Reuse Test", "[einsum][plan][cache]")
+{
+    mini_jit::einsum::EinsumPlanCache cache(64 * 1024 * 1024);
+
+    std::string          input = "[2,0],[1,2]->[1,0]";
+    std::vector<int64_t> dimension_sizes{32, 16, 8};
+
+    auto plan_0 = cache.get(input, dimension_sizes, mini_jit::dtype_t::fp32, 4, 512, 16);
+    auto plan_1 = cache.get(input, dimension_sizes, mini_jit::dtype_t::fp32, 4, 512, 16);
+
+    // the second request is served from the cache
+    REQUIRE(plan_0 == plan_1);
+    REQUIRE(cache.get_number_of_plans() == 1);
+    REQUIRE(cache.get_number_of_hits() == 1);
+    REQUIRE(cache.get_number_of_misses() == 1);
+    REQUIRE(cache.get_size() == plan_0->get_code_size() + plan_0->get_scratch_size());
+    REQUIRE(plan_0->get_code_size() > 0);
+
+    // any differing parameter results in a new plan
+    auto plan_2 = cache.get(input, {32, 16, 4}, mini_jit::dtype_t::fp32, 4, 512, 16);
+    auto plan_3 = cache.get(input, dimension_sizes, mini_jit::dtype_t::fp32, 8, 512, 16);
+    REQUIRE(plan_2 != plan_0);
+    REQUIRE(plan_3 != plan_0);
+    REQUIRE(cache.get_number_of_plans() == 3);
+    REQUIRE(cache.get_number_of_misses() == 3);
+
+    cache.clear();
+    REQUIRE(cache.get_number_of_plans() == 0);
+    REQUIRE(cache.get_size() == 0);
+}
+
+TEST_CASE("EinsumPlanCache Eviction Test", "[einsum][plan][cache]")
+{
+    std::string                  input = "[2,0],[1,2]->[1,0]";
+    mini_jit::einsum::EinsumPlan reference(input, {32, 16, 8}, mini_jit::dtype_t::fp32, 4, 512, 16);
+
+    // the limit only fits a single plan of this size
+    mini_jit::einsum::EinsumPlanCache cache(reference.get_code_size() + reference.get_code_size() / 2);
+
+    auto plan_0 = cache.get(input, {32, 16, 8}, mini_jit::dtype_t::fp32, 4, 512, 16);
+    auto plan_1 = cache.get(input, {32, 16, 8}, mini_jit::dtype_t::fp32, 2, 512, 16);
+
+    REQUIRE(cache.get_number_of_plans() == 1);
+    REQUIRE(cache.get_number_of_evictions() == 1);
+    REQUIRE(cache.get_size() <= reference.get_code_size() + reference.get_code_size() / 2);
+
+    // the evicted plan is still usable and is recompiled on the next request
+    REQUIRE(plan_0->get_code_size() == reference.get_code_size());
+    auto plan_2 = cache.get(input, {32, 16, 8}, mini_jit::dtype_t::fp32, 4, 512, 16);
+    REQUIRE(plan_2 != plan_0);
+    REQUIRE(cache.get_number_of_misses() == 3);
+
+    // the most recently used plan is kept
+    REQUIRE(cache.get(input, {32, 16, 8}, mini_jit::dtype_t::fp32, 4, 512, 16) == plan_2);
+}
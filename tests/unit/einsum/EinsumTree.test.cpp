@@ -535,4 +535,117 @@ TEST_CASE("EinsumTree Complex Permutation + GEMM Test")
 //     delete[] tensor_B;
 //     delete[] tensor_C;
 //     delete[] tensor_D;
-// }
\ No newline at end of file
+// }
+TEST_CASE("EinsumTree Zero Output Lowering Test", "[einsum][lowering]")
+{
+    // permutation of the left input followed by a contraction
+    std::string          input = "[[0,2]->[2,0]],[1,2]->[1,0]";
+    std::vector<int64_t> dimension_sizes{8, 8, 8};
+
+    mini_jit::einsum::EinsumNode* node = mini_jit::einsum::EinsumTree::parse_einsum_expression(input,
+                                                                                               dimension_sizes);
+    mini_jit::einsum::EinsumTree::optimize_einsum_nodes(node,
+                                                        1,
+                                                        512,
+                                                        16);
+    mini_jit::einsum::EinsumTree::lower_einsum_nodes_to_tensor_operations(node,
+                                                                          dimension_sizes,
+                                                                          mini_jit::dtype_t::fp32);
+
+    // the contraction zeroes its output tiles with a first touch kernel
+    REQUIRE(node->get_number_of_children() == 2);
+    REQUIRE(node->m_zero_output == false);
+
+    // the permutation overwrites its output
+    mini_jit::einsum::EinsumNode* permute_node = node->m_left_child->get_number_of_children() == 1 ? node->m_left_child : node->m_right_child;
+    REQUIRE(permute_node->get_number_of_children() == 1);
+    REQUIRE(permute_node->m_zero_output == false);
+
+    delete node;
+}
+
+TEST_CASE("EinsumTree Permutation Folding Test", "[einsum][permutation]")
+{
+    std::vector<int64_t> dimension_sizes{4, 5, 6, 7};
+
+    // the explicit permutation of the contraction is folded into its output layout
+    std::string                   input_0 = "[[1,0],[2,1]->[0,2]]->[2,0]";
+    mini_jit::einsum::EinsumNode* node_0  = mini_jit::einsum::EinsumTree::parse_einsum_expression(input_0,
+                                                                                                dimension_sizes);
+    REQUIRE(mini_jit::einsum::EinsumTree::to_string(node_0) == "[1,0],[2,1]->[2,0]");
+    delete node_0;
+
+    // the intermediate result is computed with M as unit stride dimension,
+    // so neither the intermediate result nor the inputs are permuted
+    std::string                   input_1 = "[[1,0],[2,1]->[0,2]],[3,2]->[3,0]";
+    mini_jit::einsum::EinsumNode* node_1  = mini_jit::einsum::EinsumTree::parse_einsum_expression(input_1,
+                                                                                                dimension_sizes);
+    REQUIRE(mini_jit::einsum::EinsumTree::to_string(node_1) == "[[1,0],[2,1]->[2,0]],[3,2]->[3,0]");
+    delete node_1;
+
+    // folding would require a permutation of the input [0,1], so the permutation is kept
+    std::string                   input_2 = "[[0,1],[2,1]->[0,2]]->[2,0]";
+    mini_jit::einsum::EinsumNode* node_2  = mini_jit::einsum::EinsumTree::parse_einsum_expression(input_2,
+                                                                                                dimension_sizes);
+    REQUIRE(node_2->get_number_of_children() == 1);
+    delete node_2;
+}
+
+TEST_CASE("EinsumTree Layout Propagation Test", "[einsum][layout]")
+{
+    std::vector<int64_t> dimension_sizes{4, 5, 6, 7, 8};
+
+    // the intermediate result is written in the order of both its inputs and its consumer,
+    // so that the dimensions 0 and 1 are contiguous in both contractions
+    std::string                   input_0 = "[[0,1,2],[2,3]->[1,0,3]],[3,4]->[0,1,4]";
+    mini_jit::einsum::EinsumNode* node_0  = mini_jit::einsum::EinsumTree::parse_einsum_expression(input_0,
+                                                                                                dimension_sizes);
+    REQUIRE(mini_jit::einsum::EinsumTree::to_string(node_0) == "[3,4],[[2,3],[0,1,2]->[0,1,3]]->[0,1,4]");
+    delete node_0;
+
+    // the explicit permutation of the input is not needed by the consumer and removed
+    std::string                   input_1 = "[[0,1,2]->[1,0,2]],[2,3]->[0,1,3]";
+    mini_jit::einsum::EinsumNode* node_1  = mini_jit::einsum::EinsumTree::parse_einsum_expression(input_1,
+                                                                                                dimension_sizes);
+    REQUIRE(mini_jit::einsum::EinsumTree::to_string(node_1) == "[2,3],[0,1,2]->[0,1,3]");
+    delete node_1;
+
+    // the order of the intermediate only matters to one of the operations, so the given layout is kept
+    std::string                   input_2 = "[[1,0,2],[2,3]->[1,0,3]],[3,4]->[0,1,4]";
+    mini_jit::einsum::EinsumNode* node_2  = mini_jit::einsum::EinsumTree::parse_einsum_expression(input_2,
+                                                                                                dimension_sizes);
+    REQUIRE(mini_jit::einsum::EinsumTree::to_string(node_2) == "[3,4],[[2,3],[1,0,2]->[1,0,3]]->[0,1,4]");
+    delete node_2;
+}
+
+TEST_CASE("EinsumTree Cost Model Test", "[einsum][cost_model]")
+{
+    std::string          input = "[2,0],[1,2]->[1,0]";
+    std::vector<int64_t> dimension_sizes{64, 64, 64};
+
+    // a measured throughput table reaches the optimizer of every node
+    mini_jit::ir::CostModel slow_kernels;
+    slow_kernels.setThroughput(16, 4, 1, 1, 1.0);
+
+    mini_jit::einsum::EinsumNode* node_default = mini_jit::einsum::EinsumTree::parse_einsum_expression(input,
+                                                                                                      dimension_sizes);
+    mini_jit::einsum::EinsumNode* node_slow    = mini_jit::einsum::EinsumTree::parse_einsum_expression(input,
+                                                                                                      dimension_sizes);
+    mini_jit::einsum::EinsumTree::optimize_einsum_nodes(node_default,
+                                                        1,
+                                                        64,
+                                                        4);
+    mini_jit::einsum::EinsumTree::optimize_einsum_nodes(node_slow,
+                                                        1,
+                                                        64,
+                                                        4,
+                                                        slow_kernels);
+
+    double time_default = node_default->m_operation.get_report().get_estimated_time();
+    double time_slow    = node_slow->m_operation.get_report().get_estimated_time();
+    REQUIRE(time_default > 0.0);
+    REQUIRE(time_slow > time_default);
+
+    delete node_default;
+    delete node_slow;
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <limits>
+#include <mlc/ir/Autotuner.h>
+#include <mlc/ir/Dimension.h>
+#include <mlc/types.h>
+
+using mini_jit::dim_t;
+using mini_jit::exec_t;
+using mini_jit::ir::Dimension;
+
+namespace
+{
+    std::vector<Dimension> gemm_dimensions(int64_t size)
+    {
+        return {Dimension(dim_t::m, exec_t::undefined, size, 1, 0, 1),
+                Dimension(dim_t::n, exec_t::undefined, size, 0, size, size),
+                Dimension(dim_t::k, exec_t::undefined, size, size, 1, 0)};
+    }
+} // namespace
+
+TEST_CASE("Test Autotuner Candidates", "[ir][autotuner]")
+{
+    mini_jit::ir::Autotuner::parameters_t parameters;
+    parameters.thread_targets   = {1, 4};
+    parameters.max_kernel_sizes = {64, 128};
+    parameters.min_kernel_sizes = {1};
+    parameters.max_loop_orders  = 2;
+
+    auto candidates = mini_jit::ir::Autotuner::generateCandidates(gemm_dimensions(256),
+                                                                  parameters);
+
+    // every optimizer result plus one permutation of its sequential loops
+    REQUIRE(candidates.size() >= 4);
+    REQUIRE(candidates.size() <= 8);
+    for (auto const& candidate : candidates)
+    {
+        int64_t prim_count = 0;
+        for (auto const& dim : candidate.dimensions)
+        {
+            REQUIRE(dim.exec_type != exec_t::undefined);
+            if (dim.exec_type == exec_t::prim)
+            {
+                REQUIRE(dim.size <= candidate.max_kernel_size);
+                prim_count++;
+            }
+        }
+        REQUIRE(prim_count >= 3);
+    }
+}
+
+TEST_CASE("Test Autotuner Save and Load", "[ir][autotuner]")
+{
+    mini_jit::ir::Autotuner::config_t config;
+    config.thread_target   = 8;
+    config.max_kernel_size = 64;
+    config.min_kernel_size = 16;
+    config.time            = 0.25;
+    config.dimensions      = {Dimension(dim_t::m, exec_t::shared, 4, 64, 0, 64),
+                              Dimension(dim_t::k, exec_t::seq, 2, 4096, 64, 0),
+                              Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                              Dimension(dim_t::n, exec_t::prim, 32, 0, 128, 256),
+                              Dimension(dim_t::k, exec_t::prim, 64, 256, 1, 0)};
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "mlc_autotuner_test.txt";
+    mini_jit::ir::Autotuner::save(config, path.string());
+    auto loaded = mini_jit::ir::Autotuner::load(path.string());
+    std::filesystem::remove(path);
+
+    REQUIRE(loaded.thread_target == config.thread_target);
+    REQUIRE(loaded.max_kernel_size == config.max_kernel_size);
+    REQUIRE(loaded.min_kernel_size == config.min_kernel_size);
+    REQUIRE(loaded.time == Approx(config.time));
+    REQUIRE(loaded.dimensions.size() == config.dimensions.size());
+    for (size_t i = 0; i < config.dimensions.size(); i++)
+    {
+        REQUIRE(loaded.dimensions[i].type == config.dimensions[i].type);
+        REQUIRE(loaded.dimensions[i].exec_type == config.dimensions[i].exec_type);
+        REQUIRE(loaded.dimensions[i].size == config.dimensions[i].size);
+        REQUIRE(loaded.dimensions[i].stride_in0 == config.dimensions[i].stride_in0);
+        REQUIRE(loaded.dimensions[i].stride_in1 == config.dimensions[i].stride_in1);
+        REQUIRE(loaded.dimensions[i].stride_out == config.dimensions[i].stride_out);
+    }
+
+    REQUIRE_THROWS_AS(mini_jit::ir::Autotuner::load(path.string()), std::runtime_error);
+}
+
+TEST_CASE("Test Autotuner GEMM")
+{
+    mini_jit::ir::Autotuner::parameters_t parameters;
+    parameters.thread_targets   = {1, 4};
+    parameters.max_kernel_sizes = {32, 64};
+    parameters.min_kernel_sizes = {1};
+    parameters.min_time         = 0.001;
+
+    auto config = mini_jit::ir::Autotuner::tune(mini_jit::dtype_t::fp32,
+                                                mini_jit::ptype_t::zero,
+                                                mini_jit::ptype_t::gemm,
+                                                mini_jit::ptype_t::none,
+                                                gemm_dimensions(128),
+                                                parameters);
+
+    REQUIRE(config.time > 0.0);
+    REQUIRE(config.time < std::numeric_limits<double>::infinity());
+    REQUIRE(config.max_kernel_size <= 64);
+    REQUIRE(mini_jit::ir::Autotuner::measure(mini_jit::dtype_t::fp32,
+                                             mini_jit::ptype_t::zero,
+                                             mini_jit::ptype_t::gemm,
+                                             mini_jit::ptype_t::none,
+                                             config.dimensions,
+                                             0.001) > 0.0);
+}
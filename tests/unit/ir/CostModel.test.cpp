@@ -0,0 +1,164 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <mlc/ir/CostModel.h>
+#include <mlc/ir/Dimension.h>
+#include <mlc/ir/IRConverter.h>
+#include <mlc/ir/Optimizer.h>
+#include <mlc/types.h>
+
+using mini_jit::dim_t;
+using mini_jit::exec_t;
+using mini_jit::ir::Dimension;
+
+TEST_CASE("Test CostModel Kernel Throughput", "[ir][cost_model]")
+{
+    mini_jit::ir::CostModel cost_model;
+
+    // fully used register blocks are faster than partially filled ones
+    REQUIRE(cost_model.getKernelThroughput(64, 64, 64, 1) > cost_model.getKernelThroughput(63, 64, 64, 1));
+    REQUIRE(cost_model.getKernelThroughput(64, 64, 64, 1) > cost_model.getKernelThroughput(64, 62, 64, 1));
+    REQUIRE(cost_model.getKernelThroughput(64, 64, 64, 1) > cost_model.getKernelThroughput(64, 64, 1, 1));
+    REQUIRE(cost_model.getKernelThroughput(64, 64, 64, 1) <= cost_model.getHardware().peak_gflops);
+
+    // measured values take precedence, missing entries use the closest measurement
+    cost_model.setThroughput(16, 4, 1, 1, 10.0);
+    cost_model.setThroughput(64, 64, 64, 1, 100.0);
+    REQUIRE(cost_model.getThroughputTableSize() == 2);
+    REQUIRE(cost_model.getKernelThroughput(16, 4, 1, 1) == Approx(10.0));
+    REQUIRE(cost_model.getKernelThroughput(60, 60, 64, 1) == Approx(100.0));
+    REQUIRE(cost_model.getKernelThroughput(12, 4, 2, 1) == Approx(10.0));
+}
+
+TEST_CASE("Test CostModel Throughput Table", "[ir][cost_model]")
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "mlc_cost_model_test.csv";
+    {
+        std::ofstream file(path);
+        file << "m,n,k,br_size,trans_a,trans_b,trans_c,ld_a,ld_b,ld_c,br_stride_a,br_stride_b,num_reps,time,gflops\n";
+        file << "16,4,16,1,0,0,0,0,0,0,0,0,1000,1.5,42.5\n";
+        file << "64,64,16,1,0,0,0,0,0,0,0,0,1000,1.5,102.5\n";
+    }
+
+    mini_jit::ir::CostModel cost_model;
+    REQUIRE(cost_model.loadThroughputTable(path.string()) == 2);
+    REQUIRE(cost_model.getKernelThroughput(16, 4, 16, 1) == Approx(42.5));
+    REQUIRE(cost_model.getKernelThroughput(64, 64, 16, 1) == Approx(102.5));
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(cost_model.loadThroughputTable(path.string()), std::runtime_error);
+}
+
+TEST_CASE("Test CostModel Estimate", "[ir][cost_model]")
+{
+    // 512x512x512 GEMM with a 64x64x64 kernel
+    std::vector<Dimension> dimensions = {Dimension(dim_t::m, exec_t::seq, 8, 64, 0, 64),
+                                         Dimension(dim_t::n, exec_t::seq, 8, 0, 64 * 512, 64 * 512),
+                                         Dimension(dim_t::k, exec_t::seq, 8, 64 * 512, 64, 0),
+                                         Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                                         Dimension(dim_t::n, exec_t::prim, 64, 0, 512, 512),
+                                         Dimension(dim_t::k, exec_t::prim, 64, 512, 1, 0)};
+
+    mini_jit::ir::CostModel cost_model;
+    double                  time_sequential = cost_model.estimate(dimensions, 1);
+    REQUIRE(time_sequential >= 2.0 * 512 * 512 * 512 / (cost_model.getHardware().peak_gflops * 1e9));
+
+    // sharing the M loop divides the work among the threads
+    dimensions[0].exec_type = exec_t::shared;
+    REQUIRE(cost_model.estimate(dimensions, 8) < time_sequential);
+    REQUIRE(cost_model.estimate(dimensions, 8) == Approx(cost_model.estimate(dimensions, 4) / 2.0));
+
+    // a slow memory system makes the operation bandwidth bound
+    mini_jit::ir::CostModel::hardware_t hardware;
+    hardware.memory_bandwidth = 1e6;
+    mini_jit::ir::CostModel slow_memory(hardware);
+    REQUIRE(slow_memory.estimate(dimensions, 8) > cost_model.estimate(dimensions, 8));
+
+    dimensions[3].exec_type = exec_t::seq;
+    dimensions[4].exec_type = exec_t::seq;
+    dimensions[5].exec_type = exec_t::seq;
+    REQUIRE_THROWS_AS(cost_model.estimate(dimensions, 1), std::invalid_argument);
+}
+
+TEST_CASE("Test CostModel Traffic", "[ir][cost_model]")
+{
+    // 2048x2048x2048 GEMM with a 64x64x64 kernel and all tensors much larger than the cache
+    std::vector<Dimension> dimensions = {Dimension(dim_t::n, exec_t::seq, 32, 0, 2048 * 64, 2048 * 64),
+                                         Dimension(dim_t::m, exec_t::seq, 32, 64, 0, 64),
+                                         Dimension(dim_t::k, exec_t::seq, 32, 2048 * 64, 64, 0),
+                                         Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                                         Dimension(dim_t::n, exec_t::prim, 64, 0, 2048, 2048),
+                                         Dimension(dim_t::k, exec_t::prim, 64, 2048, 1, 0)};
+
+    mini_jit::ir::CostModel::hardware_t hardware;
+    hardware.l2_size = 1024 * 1024;
+    mini_jit::ir::CostModel cost_model(hardware);
+
+    const double tensor_bytes = 2048.0 * 2048.0 * 4.0;
+
+    // the panels of A and B touched by the K loop do not fit into the cache together,
+    // so both are streamed once per block row or column of C, while C is loaded once
+    double traffic = cost_model.estimateTraffic(dimensions);
+    REQUIRE(traffic == Approx(tensor_bytes * 32 + tensor_bytes * 32 + tensor_bytes));
+
+    // a cache large enough for all tensors results in compulsory traffic only
+    hardware.l2_size = 64 * 1024 * 1024;
+    REQUIRE(mini_jit::ir::CostModel(hardware).estimateTraffic(dimensions) == Approx(3 * tensor_bytes));
+}
+
+TEST_CASE("Test Optimizer with CostModel", "[ir][cost_model][optimizer]")
+{
+    std::vector<Dimension> dimensions;
+
+    std::vector<dim_t>   dim_types   = {dim_t::m, dim_t::n, dim_t::k};
+    std::vector<exec_t>  exec_types  = {exec_t::seq, exec_t::seq, exec_t::seq};
+    std::vector<int64_t> dim_sizes   = {1600, 1600, 512};
+    std::vector<int64_t> strides_in0 = {1, 0, 1600};
+    std::vector<int64_t> strides_in1 = {0, 512, 1};
+    std::vector<int64_t> strides_out = {1, 1600, 0};
+
+    const int64_t thread_target   = 16;
+    const int64_t max_kernel_size = 128;
+    const int64_t min_kernel_size = 1;
+
+    mini_jit::ir::IRConverter::convertConfigToDimensions(dim_types,
+                                                         exec_types,
+                                                         dim_sizes,
+                                                         strides_in0,
+                                                         strides_in1,
+                                                         strides_out,
+                                                         dimensions);
+
+    // reference: the fixed divisor heuristic
+    std::vector<Dimension> heuristic = dimensions;
+    mini_jit::ir::Optimizer::splitDimensions(heuristic,
+                                             max_kernel_size,
+                                             min_kernel_size);
+    mini_jit::ir::Optimizer::identifyPrimitives(heuristic);
+    mini_jit::ir::Optimizer::createSharedLoops(heuristic,
+                                               thread_target);
+
+    mini_jit::ir::CostModel cost_model;
+    double                  score = mini_jit::ir::Optimizer::optimize(dimensions,
+                                                                      thread_target,
+                                                                      max_kernel_size,
+                                                                      min_kernel_size,
+                                                                      cost_model);
+
+    // the returned score belongs to the chosen configuration, which is at least as good as the heuristic
+    REQUIRE(score > 0.0);
+    REQUIRE(score == Approx(cost_model.estimate(dimensions, thread_target)));
+    REQUIRE(score <= cost_model.estimate(heuristic, thread_target));
+
+    int prim_count = 0;
+    for (const auto& dim : dimensions)
+    {
+        if (dim.exec_type == exec_t::prim)
+        {
+            prim_count++;
+            REQUIRE(dim.size <= max_kernel_size);
+        }
+    }
+    // splitting K allows a BRGEMM kernel
+    REQUIRE((prim_count == 3 || prim_count == 4));
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+#include <mlc/ir/CostModel.h>
+#include <mlc/ir/Dimension.h>
+#include <mlc/ir/OptimizationReport.h>
+#include <mlc/ir/Optimizer.h>
+#include <mlc/types.h>
+
+using mini_jit::dim_t;
+using mini_jit::exec_t;
+using mini_jit::ir::Dimension;
+
+TEST_CASE("Test OptimizationReport for GEMM", "[ir][report]")
+{
+    // 1600x1600x512 GEMM
+    std::vector<Dimension> dimensions = {Dimension(dim_t::m, exec_t::seq, 1600, 1, 0, 1),
+                                         Dimension(dim_t::n, exec_t::seq, 1600, 0, 512, 1600),
+                                         Dimension(dim_t::k, exec_t::seq, 512, 1600, 1, 0)};
+
+    mini_jit::ir::CostModel          cost_model;
+    mini_jit::ir::OptimizationReport report;
+    REQUIRE(report.is_empty());
+
+    double score = mini_jit::ir::Optimizer::optimize(dimensions,
+                                                     16,
+                                                     128,
+                                                     1,
+                                                     cost_model,
+                                                     &report);
+
+    REQUIRE_FALSE(report.is_empty());
+    REQUIRE(report.get_input().size() == 3);
+    REQUIRE(report.get_output().size() == dimensions.size());
+    REQUIRE(report.get_estimated_time() == Approx(score));
+    REQUIRE(report.get_flops() == Approx(2.0 * 1600 * 1600 * 512));
+    REQUIRE(report.get_bytes() >= 4.0 * (1600 * 512 + 512 * 1600 + 1600 * 1600));
+    REQUIRE(report.get_arithmetic_intensity() == Approx(report.get_flops() / report.get_bytes()));
+
+    int64_t num_tasks = 1;
+    for (Dimension const& dim : dimensions)
+    {
+        if (dim.exec_type == exec_t::shared)
+        {
+            num_tasks *= dim.size;
+        }
+    }
+    REQUIRE(report.get_num_tasks() == num_tasks);
+    REQUIRE(report.get_parallel_efficiency() == Approx(mini_jit::ir::Optimizer::getParallelEfficiency(num_tasks, 16)));
+
+    // every type is described by the split stage and the shared loops are always reported
+    int64_t num_split  = 0;
+    int64_t num_shared = 0;
+    for (auto const& decision : report.get_decisions())
+    {
+        num_split += decision.stage == "split";
+        num_shared += decision.stage == "shared";
+    }
+    REQUIRE(num_split == 4);
+    REQUIRE(num_shared == 1);
+
+    std::string json = report.to_json();
+    REQUIRE(json.front() == '{');
+    REQUIRE(json.back() == '}');
+    for (std::string key : {"\"input\"", "\"output\"", "\"decisions\"", "\"primitive\"", "\"flops\"", "\"bytes\"",
+                            "\"arithmetic_intensity\"", "\"num_tasks\"", "\"parallel_efficiency\""})
+    {
+        REQUIRE(json.find(key) != std::string::npos);
+    }
+
+    report.clear();
+    REQUIRE(report.is_empty());
+    REQUIRE(report.get_decisions().empty());
+}
+
+TEST_CASE("Test OptimizationReport for Fusion and Peeling", "[ir][report]")
+{
+    // two contiguous M dimensions of size 8 and 200 fused to a single dimension of size 1600
+    std::vector<Dimension> dimensions = {Dimension(dim_t::m, exec_t::seq, 200, 8, 0, 8),
+                                         Dimension(dim_t::m, exec_t::seq, 8, 1, 0, 1),
+                                         Dimension(dim_t::n, exec_t::seq, 1601, 0, 64, 1600),
+                                         Dimension(dim_t::k, exec_t::seq, 64, 1600, 1, 0)};
+
+    mini_jit::ir::OptimizationReport report;
+    mini_jit::ir::Optimizer::optimize(dimensions,
+                                      4,
+                                      512,
+                                      16,
+                                      mini_jit::ir::CostModel(),
+                                      &report);
+
+    bool has_fuse = false;
+    bool has_peel = false;
+    for (auto const& decision : report.get_decisions())
+    {
+        has_fuse |= decision.stage == "fuse";
+        has_peel |= decision.stage == "peel";
+    }
+    REQUIRE(has_fuse);
+    REQUIRE(has_peel);
+
+    // the remainder iterations do not add operations
+    REQUIRE(report.get_flops() == Approx(2.0 * 1600 * 1601 * 64));
+}
@@ -4,6 +4,7 @@
 #include <mlc/ir/IRConverter.h>
 #include <mlc/ir/Optimizer.h>
 #include <mlc/types.h>
+#include <omp.h>
 
 using mini_jit::dim_t;
 using mini_jit::exec_t;
@@ -232,4 +233,280 @@ TEST_CASE("Test Optimizer for Dimension Fusion and Splitting", "[ir][optimizer][
         REQUIRE(dim.size <= max_kernel_size);
         REQUIRE(dim.size >= min_kernel_size);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Test Optimizer for Loop Reordering", "[ir][optimizer][reorder]")
+{
+    // 128x128x1024 GEMM with a 64x64x64 kernel, the K loop is the outermost loop
+    std::vector<mini_jit::ir::Dimension> dimensions = {Dimension(dim_t::k, exec_t::seq, 16, 128 * 64, 64, 0),
+                                                       Dimension(dim_t::n, exec_t::seq, 2, 0, 1024 * 64, 128 * 64),
+                                                       Dimension(dim_t::m, exec_t::seq, 2, 64, 0, 64),
+                                                       Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                                                       Dimension(dim_t::n, exec_t::prim, 64, 0, 1024, 128),
+                                                       Dimension(dim_t::k, exec_t::prim, 64, 128, 1, 0)};
+
+    // the cache only holds the data of a single kernel call
+    mini_jit::ir::CostModel::hardware_t hardware;
+    hardware.l2_size = 64 * 1024;
+    mini_jit::ir::CostModel cost_model(hardware);
+
+    double traffic_before = cost_model.estimateTraffic(dimensions);
+    mini_jit::ir::Optimizer::reorderDimensions(dimensions,
+                                               cost_model);
+    double traffic_after = cost_model.estimateTraffic(dimensions);
+
+    // the output tile stays in cache if the K loop is the innermost loop
+    REQUIRE(traffic_after < traffic_before);
+    REQUIRE(dimensions[2].type == dim_t::k);
+    REQUIRE(dimensions[2].exec_type == exec_t::seq);
+    REQUIRE(dimensions[2].size == 16);
+    for (size_t i = 3; i < dimensions.size(); i++)
+    {
+        REQUIRE(dimensions[i].exec_type == exec_t::prim);
+    }
+
+    // an order which is already optimal is kept
+    std::vector<mini_jit::ir::Dimension> reordered = dimensions;
+    mini_jit::ir::Optimizer::reorderDimensions(reordered,
+                                               cost_model);
+    for (size_t i = 0; i < dimensions.size(); i++)
+    {
+        REQUIRE(reordered[i].type == dimensions[i].type);
+        REQUIRE(reordered[i].size == dimensions[i].size);
+    }
+}
+
+TEST_CASE("Test Optimizer for Cache Tiling", "[ir][optimizer][tiling]")
+{
+    // 2048x2048x2048 GEMM with a 64x64x64 kernel
+    std::vector<mini_jit::ir::Dimension> dimensions = {Dimension(dim_t::n, exec_t::seq, 32, 0, 2048 * 64, 2048 * 64),
+                                                       Dimension(dim_t::m, exec_t::seq, 32, 64, 0, 64),
+                                                       Dimension(dim_t::k, exec_t::seq, 32, 2048 * 64, 64, 0),
+                                                       Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                                                       Dimension(dim_t::n, exec_t::prim, 64, 0, 2048, 2048),
+                                                       Dimension(dim_t::k, exec_t::prim, 64, 2048, 1, 0)};
+
+    mini_jit::ir::CostModel::hardware_t hardware;
+    hardware.l1_size = 128 * 1024;
+    hardware.l2_size = 1024 * 1024;
+    mini_jit::ir::CostModel cost_model(hardware);
+
+    double traffic_before = cost_model.estimateTraffic(dimensions);
+    mini_jit::ir::Optimizer::tileDimensions(dimensions,
+                                            cost_model);
+
+    // A panel: 64 x (64 * 4) floats = 64 KiB, half of L1
+    // B panel: (64 * 4) x (64 * 8) floats = 512 KiB, half of L2
+    std::vector<dim_t>   expected_types = {dim_t::n, dim_t::k, dim_t::m, dim_t::n, dim_t::k};
+    std::vector<int64_t> expected_sizes = {4, 8, 32, 8, 4};
+    REQUIRE(dimensions.size() == 8);
+    for (size_t i = 0; i < expected_types.size(); i++)
+    {
+        REQUIRE(dimensions[i].exec_type == exec_t::seq);
+        REQUIRE(dimensions[i].type == expected_types[i]);
+        REQUIRE(dimensions[i].size == expected_sizes[i]);
+    }
+    REQUIRE(dimensions[0].stride_out == 8 * 2048 * 64);
+    REQUIRE(dimensions[3].stride_out == 2048 * 64);
+    REQUIRE(dimensions[1].stride_in0 == 4 * 2048 * 64);
+    REQUIRE(dimensions[4].stride_in0 == 2048 * 64);
+    REQUIRE(cost_model.estimateTraffic(dimensions) < traffic_before);
+
+    // without a sequential K loop there is nothing to tile
+    std::vector<mini_jit::ir::Dimension> gemm = {Dimension(dim_t::n, exec_t::seq, 4, 0, 64 * 64, 64 * 64),
+                                                 Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                                                 Dimension(dim_t::n, exec_t::prim, 64, 0, 64, 64),
+                                                 Dimension(dim_t::k, exec_t::prim, 64, 64, 1, 0)};
+    mini_jit::ir::Optimizer::tileDimensions(gemm,
+                                            cost_model);
+    REQUIRE(gemm.size() == 4);
+    REQUIRE(gemm[0].size == 4);
+}
+
+TEST_CASE("Test Optimizer for Shared Loop Selection", "[ir][optimizer][shared]")
+{
+    REQUIRE(mini_jit::ir::Optimizer::getParallelEfficiency(64, 64) == Approx(1.0));
+    REQUIRE(mini_jit::ir::Optimizer::getParallelEfficiency(65, 64) == Approx(65.0 / 128.0));
+    REQUIRE(mini_jit::ir::Optimizer::getParallelEfficiency(3, 64) == Approx(3.0 / 64.0));
+
+    // the small outer loop would only yield 3 tasks, the second loop alone keeps all threads busy
+    std::vector<mini_jit::ir::Dimension> dimensions = {Dimension(dim_t::m, exec_t::seq, 3, 64 * 64, 0, 64 * 64),
+                                                       Dimension(dim_t::n, exec_t::seq, 64, 0, 64 * 64, 3 * 64 * 64),
+                                                       Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                                                       Dimension(dim_t::n, exec_t::prim, 64, 0, 64, 3 * 64),
+                                                       Dimension(dim_t::k, exec_t::prim, 64, 64, 1, 0)};
+    mini_jit::ir::Optimizer::createSharedLoops(dimensions,
+                                               64);
+    REQUIRE(dimensions[0].exec_type == exec_t::shared);
+    REQUIRE(dimensions[0].size == 64);
+    REQUIRE(dimensions[1].exec_type == exec_t::seq);
+    REQUIRE(dimensions[1].size == 3);
+
+    // a loop of size 65 is parallelized together with the loop of size 3 instead of being skipped
+    dimensions = {Dimension(dim_t::m, exec_t::seq, 65, 64, 0, 64),
+                  Dimension(dim_t::n, exec_t::seq, 3, 0, 64 * 64, 65 * 64 * 64),
+                  Dimension(dim_t::k, exec_t::seq, 2, 65 * 64 * 64, 64, 0),
+                  Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                  Dimension(dim_t::n, exec_t::prim, 64, 0, 128, 65 * 64),
+                  Dimension(dim_t::k, exec_t::prim, 64, 65 * 64, 1, 0)};
+    mini_jit::ir::Optimizer::createSharedLoops(dimensions,
+                                               64);
+    int64_t num_tasks = 1;
+    for (auto const& dim : dimensions)
+    {
+        if (dim.exec_type == exec_t::shared)
+        {
+            REQUIRE(dim.type != dim_t::k);
+            num_tasks *= dim.size;
+        }
+    }
+    REQUIRE(num_tasks == 65 * 3);
+    REQUIRE(dimensions[2].type == dim_t::k);
+    REQUIRE(dimensions[2].exec_type == exec_t::seq);
+
+    // a single large loop is split, its outer part provides exactly one task per thread
+    dimensions = {Dimension(dim_t::m, exec_t::seq, 128, 64, 0, 64),
+                  Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                  Dimension(dim_t::n, exec_t::prim, 64, 0, 64, 128 * 64),
+                  Dimension(dim_t::k, exec_t::prim, 64, 128 * 64, 1, 0)};
+    mini_jit::ir::Optimizer::createSharedLoops(dimensions,
+                                               16);
+    REQUIRE(dimensions.size() == 5);
+    REQUIRE(dimensions[0].exec_type == exec_t::shared);
+    REQUIRE(dimensions[0].size == 16);
+    REQUIRE(dimensions[0].stride_in0 == 8 * 64);
+    REQUIRE(dimensions[0].stride_out == 8 * 64);
+    REQUIRE(dimensions[1].exec_type == exec_t::seq);
+    REQUIRE(dimensions[1].size == 8);
+    REQUIRE(dimensions[1].stride_in0 == 64);
+
+    // without a thread target the number of OpenMP threads is used
+    dimensions = {Dimension(dim_t::m, exec_t::seq, 128, 64, 0, 64),
+                  Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                  Dimension(dim_t::n, exec_t::prim, 64, 0, 64, 128 * 64),
+                  Dimension(dim_t::k, exec_t::prim, 64, 128 * 64, 1, 0)};
+    mini_jit::ir::Optimizer::createSharedLoops(dimensions,
+                                               0);
+    num_tasks = 1;
+    for (auto const& dim : dimensions)
+    {
+        if (dim.exec_type == exec_t::shared)
+        {
+            num_tasks *= dim.size;
+        }
+    }
+    REQUIRE(mini_jit::ir::Optimizer::getParallelEfficiency(num_tasks, omp_get_max_threads()) == Approx(1.0));
+}
+
+TEST_CASE("Test Optimizer for Peeling", "[ir][optimizer][peel]")
+{
+    // 1601 is prime, so M and N cannot be split into kernels of at most 512 elements
+    std::vector<dim_t>   dim_types      = {dim_t::m, dim_t::n, dim_t::k};
+    std::vector<exec_t>  exec_types     = {exec_t::seq, exec_t::seq, exec_t::seq};
+    std::vector<int64_t> dim_sizes      = {1601, 1601, 64};
+    std::vector<int64_t> strides_in0    = {1, 0, 1601};
+    std::vector<int64_t> strides_in1    = {0, 64, 1};
+    std::vector<int64_t> strides_out    = {1, 1601, 0};
+    std::vector<int64_t> dim_remainders = {};
+
+    mini_jit::ir::Optimizer::optimize(dim_types,
+                                      exec_types,
+                                      dim_sizes,
+                                      strides_in0,
+                                      strides_in1,
+                                      strides_out,
+                                      dim_remainders,
+                                      4,
+                                      512,
+                                      1);
+
+    REQUIRE(dim_remainders.size() == dim_types.size());
+    for (dim_t type : {dim_t::m, dim_t::n})
+    {
+        int64_t block_size = 0;
+        int64_t num_blocks = 0;
+        int64_t remainder  = 0;
+        for (size_t i = 0; i < dim_types.size(); i++)
+        {
+            if (dim_types[i] != type)
+            {
+                continue;
+            }
+            if (exec_types[i] == exec_t::prim)
+            {
+                block_size = dim_sizes[i];
+            }
+            else
+            {
+                num_blocks = dim_sizes[i];
+                remainder  = dim_remainders[i];
+            }
+        }
+        // four blocks, rounded up to the register blocking
+        REQUIRE(block_size == (type == dim_t::m ? 416 : 404));
+        REQUIRE(num_blocks == 4);
+        REQUIRE(remainder == 1601 - 3 * block_size);
+    }
+
+    // the conversion without remainders does not peel and keeps the huge kernel
+    dim_types   = {dim_t::m, dim_t::n, dim_t::k};
+    exec_types  = {exec_t::seq, exec_t::seq, exec_t::seq};
+    dim_sizes   = {1601, 1601, 64};
+    strides_in0 = {1, 0, 1601};
+    strides_in1 = {0, 64, 1};
+    strides_out = {1, 1601, 0};
+    mini_jit::ir::Optimizer::optimize(dim_types,
+                                      exec_types,
+                                      dim_sizes,
+                                      strides_in0,
+                                      strides_in1,
+                                      strides_out,
+                                      4,
+                                      512,
+                                      1);
+    REQUIRE(std::find(dim_sizes.begin(), dim_sizes.end(), 1601) != dim_sizes.end());
+
+    // dimensions which already fit into a kernel are not peeled
+    std::vector<Dimension> dimensions = {Dimension(dim_t::m, exec_t::prim, 64, 1, 0, 1),
+                                         Dimension(dim_t::n, exec_t::prim, 64, 0, 64, 64),
+                                         Dimension(dim_t::k, exec_t::prim, 64, 64, 1, 0)};
+    mini_jit::ir::Optimizer::peelDimensions(dimensions,
+                                            64);
+    REQUIRE(dimensions.size() == 3);
+}
+
+TEST_CASE("Test Optimizer for General Dimension Fusion", "[ir][optimizer][fusion]")
+{
+    // the outer dimension comes first, fusing it must not corrupt the following dimensions
+    std::vector<Dimension> dimensions = {Dimension(dim_t::m, exec_t::seq, 8, 4, 0, 4),
+                                         Dimension(dim_t::m, exec_t::seq, 4, 1, 0, 1),
+                                         Dimension(dim_t::n, exec_t::seq, 32, 0, 32, 32)};
+    mini_jit::ir::Optimizer::fuseDimensions(dimensions,
+                                            8);
+    REQUIRE(dimensions.size() == 2);
+    REQUIRE(dimensions[0].type == dim_t::m);
+    REQUIRE(dimensions[0].size == 32);
+    REQUIRE(dimensions[0].stride_in0 == 1);
+    REQUIRE(dimensions[1].type == dim_t::n);
+    REQUIRE(dimensions[1].size == 32);
+    REQUIRE(dimensions[1].stride_in1 == 32);
+
+    // chains are fused completely, a SEQ loop is absorbed by the PRIM dimension
+    dimensions = {Dimension(dim_t::c, exec_t::seq, 2, 16, 0, 16),
+                  Dimension(dim_t::c, exec_t::undefined, 4, 4, 0, 4),
+                  Dimension(dim_t::c, exec_t::prim, 4, 1, 0, 1)};
+    mini_jit::ir::Optimizer::fuseDimensions(dimensions,
+                                            8);
+    REQUIRE(dimensions.size() == 1);
+    REQUIRE(dimensions[0].exec_type == exec_t::prim);
+    REQUIRE(dimensions[0].size == 32);
+
+    // different types, PRIM and SHARED, and non-contiguous strides are not fused
+    dimensions = {Dimension(dim_t::m, exec_t::shared, 2, 4, 0, 4),
+                  Dimension(dim_t::m, exec_t::prim, 4, 1, 0, 1),
+                  Dimension(dim_t::n, exec_t::seq, 2, 0, 8, 8),
+                  Dimension(dim_t::k, exec_t::seq, 2, 16, 1, 0),
+                  Dimension(dim_t::k, exec_t::seq, 2, 4, 2, 0)};
+    mini_jit::ir::Optimizer::fuseDimensions(dimensions,
+                                            8);
+    REQUIRE(dimensions.size() == 5);
+}
@@ -0,0 +1,12 @@
+#include <catch2/catch.hpp>
+#include <mlc/json.h>
+#include <string>
+
+TEST_CASE("Test JSON Escaping", "[json]")
+{
+    REQUIRE(mini_jit::escape_json("abc,cd->abd") == "abc,cd->abd");
+    REQUIRE(mini_jit::escape_json("\"a\\b\"") == "\\\"a\\\\b\\\"");
+    REQUIRE(mini_jit::escape_json("a\nb\tc\r") == "a\\nb\\tc\\r");
+    REQUIRE(mini_jit::escape_json(std::string("a\0b", 3)) == "a\\u0000b");
+    REQUIRE(mini_jit::escape_json("\x1f") == "\\u001f");
+}